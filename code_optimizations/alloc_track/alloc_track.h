@@ -0,0 +1,412 @@
+#ifndef ALLOC_TRACK_H
+#define ALLOC_TRACK_H
+
+// ============================================================================
+// Allocation Tracking — who calls new, how much, and for how long
+// ============================================================================
+// Including this header REPLACES the global operator new/delete, so include
+// it from exactly one translation unit per program (a sketch is one).
+// Sketches include it only when built with ALLOC_TRACK=1 (the Makefile
+// then defines ALLOC_TRACK and adds --library code_optimizations/
+// alloc_track); host benches include "alloc_track/alloc_track.h".
+//
+// Every block gets a small header in front of it, which is how delete knows
+// what it is freeing:
+//
+//   host     16 bytes: size, call site, birth. Tracks totals, per-site
+//            counts/bytes/live/peak, and a lifetime histogram.
+//   Arduino  size, call site — 3 bytes on AVR. Totals and per-site
+//            counters only — a counter shim cheap enough to leave in a 2KB
+//            sketch. ESP32 and ARM boards take this path too: the host one
+//            needs exceptions, thread_local and __builtin_return_address.
+//
+// A call site is the innermost open AllocScope label. On the host, with no
+// scope open, it is the code address that called new — the report prints
+// it as module+offset, ready for `addr2line -f -C -e <binary> <offset>`.
+//
+// Proving an operation allocation-free:
+//
+//   AllocStats before = allocStats();
+//   append(queue, pool, 42);
+//   if (allocsSince(before) != 0) { ... }   // it allocated after all
+//
+// Attributing allocations and printing them:
+//
+//   { AllocScope scope("config"); set(config, "threshold", 75); }
+//   heapReport(Serial);   // heapReport(stdout) on the host
+// ============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#define ALLOC_TRACK_SHIM 1
+#else
+#include <stdio.h>
+#endif
+
+#if defined(ALLOC_TRACK_SHIM)
+typedef unsigned long AllocCounter;
+const uint8_t ALLOC_TRACK_SITES = 8;  // site 0 = "(no scope)"
+#else
+#include <atomic>
+#include <new>
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define ALLOC_TRACK_HAVE_DLADDR 1
+#endif
+typedef unsigned long long AllocCounter;
+const uint16_t ALLOC_TRACK_SITES = 256;  // site 0 = "(other)" once the table is full
+const int ALLOC_TRACK_LIFETIME_BUCKETS = 33;  // 0, 1, 2-3, 4-7, ... 2^31+
+#endif
+
+struct AllocStats {
+  AllocCounter allocs;
+  AllocCounter frees;
+  AllocCounter failures;  // new returned nullptr / threw
+  AllocCounter totalBytes;
+  size_t liveBytes;
+  size_t peakBytes;
+};
+
+struct AllocSite {
+  const void* key;  // label (const char*) or code address
+  bool isLabel;
+  AllocCounter allocs;
+  AllocCounter bytes;
+  size_t liveBytes;
+  size_t peakBytes;
+};
+
+struct AllocTrackState {
+  AllocStats stats;
+  AllocSite sites[ALLOC_TRACK_SITES];
+#if !defined(ALLOC_TRACK_SHIM)
+  AllocCounter lifetimes[ALLOC_TRACK_LIFETIME_BUCKETS];
+  const void* lastKey;  // loops allocate from one site over and over
+  size_t lastSite;
+#endif
+};
+
+// All-zero POD: constant-initialized, so it is ready before any static
+// constructor calls new
+inline AllocTrackState& allocTrackState() {
+  static AllocTrackState state;
+  return state;
+}
+
+// Innermost AllocScope label, nullptr when none is open
+inline const char*& allocTrackScope() {
+#if defined(ALLOC_TRACK_SHIM)
+  static const char* label = nullptr;
+#else
+  static thread_local const char* label = nullptr;
+#endif
+  return label;
+}
+
+// ---- Locking -----------------------------------------------------------
+// The sketch main loop is single-threaded (and new is never called from an
+// ISR). On the host a spinlock keeps multi-threaded programs consistent.
+
+#if defined(ALLOC_TRACK_SHIM)
+inline void allocTrackLock() {}
+inline void allocTrackUnlock() {}
+#else
+inline std::atomic_flag& allocTrackFlag() {
+  static std::atomic_flag flag = ATOMIC_FLAG_INIT;
+  return flag;
+}
+inline void allocTrackLock() {
+  while (allocTrackFlag().test_and_set(std::memory_order_acquire)) {}
+}
+inline void allocTrackUnlock() { allocTrackFlag().clear(std::memory_order_release); }
+#endif
+
+// ---- Block header ------------------------------------------------------
+
+#if defined(ALLOC_TRACK_SHIM)
+// alignof(max_align_t) is 1 on AVR, so the header stays 3 bytes there
+struct alignas(alignof(max_align_t)) AllocHeader {
+  size_t size;
+  uint8_t site;
+};
+#else
+// Padded to malloc's alignment, so the block after it stays aligned
+struct alignas(alignof(max_align_t)) AllocHeader {
+  size_t size;
+  uint32_t site;
+  uint32_t birth;  // stats.allocs when allocated (wraps; fine for a histogram)
+};
+#endif
+
+// Site index for this allocation. Caller holds the lock.
+inline size_t allocTrackSite(const void* caller) {
+  AllocSite* sites = allocTrackState().sites;
+  const char* label = allocTrackScope();
+  const void* key = label ? static_cast<const void*>(label) : caller;
+  if (!key) return 0;
+#if defined(ALLOC_TRACK_SHIM)
+  // Linear scan of a handful of labels
+  for (uint8_t i = 1; i < ALLOC_TRACK_SITES; i++) {
+    if (sites[i].key == key) return i;
+    if (!sites[i].key) {
+      sites[i].key = key;
+      sites[i].isLabel = true;
+      return i;
+    }
+  }
+  return 0;
+#else
+  AllocTrackState& s = allocTrackState();
+  if (key == s.lastKey) return s.lastSite;
+  // Open addressing on the pointer value; slot 0 is reserved for overflow
+  s.lastKey = key;
+  uintptr_t h = reinterpret_cast<uintptr_t>(key);
+  h ^= h >> 17;
+  h *= 0x9E3779B97F4A7C15ull;
+  for (uint16_t probe = 0; probe < ALLOC_TRACK_SITES - 1; probe++) {
+    size_t i = 1 + (h + probe) % (ALLOC_TRACK_SITES - 1);
+    if (!sites[i].key) {
+      sites[i].key = key;
+      sites[i].isLabel = label != nullptr;
+    }
+    if (sites[i].key == key) return s.lastSite = i;
+  }
+  return s.lastSite = 0;
+#endif
+}
+
+inline void* allocTrackAlloc(size_t size, const void* caller) {
+  AllocHeader* h = static_cast<AllocHeader*>(malloc(sizeof(AllocHeader) + size));
+  AllocTrackState& s = allocTrackState();
+  allocTrackLock();
+  if (!h) {
+    s.stats.failures++;
+    allocTrackUnlock();
+    return nullptr;
+  }
+  size_t site = allocTrackSite(caller);
+  h->size = size;
+  h->site = static_cast<decltype(h->site)>(site);
+  s.stats.allocs++;
+  s.stats.totalBytes += size;
+  s.stats.liveBytes += size;
+  if (s.stats.liveBytes > s.stats.peakBytes) s.stats.peakBytes = s.stats.liveBytes;
+  AllocSite& at = s.sites[site];
+  at.allocs++;
+  at.bytes += size;
+  at.liveBytes += size;
+  if (at.liveBytes > at.peakBytes) at.peakBytes = at.liveBytes;
+#if !defined(ALLOC_TRACK_SHIM)
+  h->birth = static_cast<uint32_t>(s.stats.allocs);
+#endif
+  allocTrackUnlock();
+  return h + 1;
+}
+
+inline void allocTrackFree(void* p) {
+  if (!p) return;
+  AllocHeader* h = static_cast<AllocHeader*>(p) - 1;
+  AllocTrackState& s = allocTrackState();
+  allocTrackLock();
+  s.stats.frees++;
+  s.stats.liveBytes -= h->size;
+  s.sites[h->site].liveBytes -= h->size;
+#if !defined(ALLOC_TRACK_SHIM)
+  // Lifetime = allocations made while this block was live, log2 bucket
+  uint32_t lifetime = static_cast<uint32_t>(s.stats.allocs) - h->birth;
+  s.lifetimes[lifetime ? 32 - __builtin_clz(lifetime) : 0]++;
+#endif
+  allocTrackUnlock();
+  free(h);
+}
+
+// ---- Public API --------------------------------------------------------
+
+// Snapshot of the totals
+inline AllocStats allocStats() {
+  allocTrackLock();
+  AllocStats copy = allocTrackState().stats;
+  allocTrackUnlock();
+  return copy;
+}
+
+// Allocations made since a snapshot — 0 means the code in between never
+// called new
+inline AllocCounter allocsSince(const AllocStats& before) {
+  return allocStats().allocs - before.allocs;
+}
+
+// Restart peak tracking from the current live bytes (globally and per site)
+inline void allocResetPeak() {
+  AllocTrackState& s = allocTrackState();
+  allocTrackLock();
+  s.stats.peakBytes = s.stats.liveBytes;
+  for (size_t i = 0; i < ALLOC_TRACK_SITES; i++) s.sites[i].peakBytes = s.sites[i].liveBytes;
+  allocTrackUnlock();
+}
+
+// Attribute every allocation made while this object lives to `label`.
+// The label must be a string that outlives the program (a literal).
+class AllocScope {
+public:
+  explicit AllocScope(const char* label) : saved_(allocTrackScope()) { allocTrackScope() = label; }
+  ~AllocScope() { allocTrackScope() = saved_; }
+  AllocScope(const AllocScope&) = delete;
+  AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+  const char* saved_;
+};
+
+// ---- Report ------------------------------------------------------------
+
+#if defined(ARDUINO)
+
+inline void heapReport(Print& out) {
+  AllocTrackState& s = allocTrackState();
+  out.print(F("heap: "));
+  out.print(s.stats.allocs);
+  out.print(F(" allocs, "));
+  out.print(s.stats.frees);
+  out.print(F(" frees, "));
+  out.print(s.stats.failures);
+  out.print(F(" failed | live "));
+  out.print(s.stats.liveBytes);
+  out.print(F(" B, peak "));
+  out.print(s.stats.peakBytes);
+  out.println(F(" B"));
+  for (size_t i = 0; i < ALLOC_TRACK_SITES; i++) {
+    const AllocSite& site = s.sites[i];
+    if (!site.allocs) continue;
+    out.print(F("  "));
+    out.print(site.isLabel ? static_cast<const char*>(site.key) : (i ? "(code)" : "(no scope)"));
+    out.print(F(": "));
+    out.print(site.allocs);
+    out.print(F(" allocs, "));
+    out.print(site.bytes);
+    out.print(F(" B, live "));
+    out.print(site.liveBytes);
+    out.print(F(" B, peak "));
+    out.print(site.peakBytes);
+    out.println(F(" B"));
+  }
+}
+
+#else
+
+inline void allocTrackPrintSite(FILE* out, size_t index, const AllocSite& site) {
+  if (site.isLabel) {
+    fprintf(out, "%s", static_cast<const char*>(site.key));
+    return;
+  }
+  if (index == 0) {
+    fprintf(out, "(other sites)");
+    return;
+  }
+#if defined(ALLOC_TRACK_HAVE_DLADDR)
+  Dl_info info;
+  if (dladdr(site.key, &info) && info.dli_fname) {
+    const char* module = info.dli_fname;
+    for (const char* c = module; *c; c++)
+      if (*c == '/') module = c + 1;
+    uintptr_t offset = reinterpret_cast<uintptr_t>(site.key) -
+                       reinterpret_cast<uintptr_t>(info.dli_fbase);
+    fprintf(out, "%s+0x%lx", module, static_cast<unsigned long>(offset));
+    if (info.dli_sname) fprintf(out, " (%s)", info.dli_sname);
+    return;
+  }
+#endif
+  fprintf(out, "%p", site.key);
+}
+
+// Totals, the busiest call sites by bytes, and the lifetime histogram
+inline void heapReport(FILE* out = stdout, size_t maxSites = 20) {
+  AllocTrackState& s = allocTrackState();
+  allocTrackLock();
+  AllocTrackState snap = s;  // print from a copy: fprintf may allocate
+  allocTrackUnlock();
+
+  fprintf(out, "heap: %llu allocs, %llu frees, %llu failed | live %zu B, peak %zu B, total %llu B\n",
+          snap.stats.allocs, snap.stats.frees, snap.stats.failures, snap.stats.liveBytes,
+          snap.stats.peakBytes, snap.stats.totalBytes);
+
+  fprintf(out, "  %10s %12s %10s %10s  site\n", "allocs", "bytes", "live B", "peak B");
+  bool printed[ALLOC_TRACK_SITES] = {};
+  for (size_t shown = 0; shown < maxSites; shown++) {
+    size_t best = ALLOC_TRACK_SITES;
+    for (size_t i = 0; i < ALLOC_TRACK_SITES; i++) {
+      if (printed[i] || !snap.sites[i].allocs) continue;
+      if (best == ALLOC_TRACK_SITES || snap.sites[i].bytes > snap.sites[best].bytes) best = i;
+    }
+    if (best == ALLOC_TRACK_SITES) break;
+    printed[best] = true;
+    const AllocSite& site = snap.sites[best];
+    fprintf(out, "  %10llu %12llu %10zu %10zu  ", site.allocs, site.bytes, site.liveBytes,
+            site.peakBytes);
+    allocTrackPrintSite(out, best, site);
+    fprintf(out, "\n");
+  }
+
+  fprintf(out, "  lifetime (allocations until freed):");
+  for (int b = 0; b < ALLOC_TRACK_LIFETIME_BUCKETS; b++) {
+    if (!snap.lifetimes[b]) continue;
+    if (b <= 1) fprintf(out, "  %d: %llu", b, snap.lifetimes[b]);
+    else        fprintf(out, "  %llu-%llu: %llu", 1ull << (b - 1), (1ull << b) - 1, snap.lifetimes[b]);
+  }
+  fprintf(out, "\n");
+}
+
+#endif
+
+// ---- The hooks ---------------------------------------------------------
+// noinline: __builtin_return_address(0) must be the code that wrote `new`,
+// not whatever the hook was inlined into. Keeping delete out of line too
+// stops GCC from pairing an inlined new with the free() behind it.
+
+#if defined(ALLOC_TRACK_SHIM)
+
+void* operator new(size_t size) { return allocTrackAlloc(size, nullptr); }
+void* operator new[](size_t size) { return allocTrackAlloc(size, nullptr); }
+void operator delete(void* p) { allocTrackFree(p); }
+void operator delete[](void* p) { allocTrackFree(p); }
+#if __cplusplus >= 201402L
+void operator delete(void* p, size_t) { allocTrackFree(p); }
+void operator delete[](void* p, size_t) { allocTrackFree(p); }
+#endif
+
+#else
+
+#define ALLOC_TRACK_HOOK __attribute__((noinline))
+
+ALLOC_TRACK_HOOK void* operator new(size_t size) {
+  void* p = allocTrackAlloc(size ? size : 1, __builtin_return_address(0));
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+ALLOC_TRACK_HOOK void* operator new[](size_t size) {
+  void* p = allocTrackAlloc(size ? size : 1, __builtin_return_address(0));
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+ALLOC_TRACK_HOOK void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocTrackAlloc(size ? size : 1, __builtin_return_address(0));
+}
+ALLOC_TRACK_HOOK void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocTrackAlloc(size ? size : 1, __builtin_return_address(0));
+}
+ALLOC_TRACK_HOOK void operator delete(void* p) noexcept { allocTrackFree(p); }
+ALLOC_TRACK_HOOK void operator delete[](void* p) noexcept { allocTrackFree(p); }
+ALLOC_TRACK_HOOK void operator delete(void* p, size_t) noexcept { allocTrackFree(p); }
+ALLOC_TRACK_HOOK void operator delete[](void* p, size_t) noexcept { allocTrackFree(p); }
+ALLOC_TRACK_HOOK void operator delete(void* p, const std::nothrow_t&) noexcept { allocTrackFree(p); }
+ALLOC_TRACK_HOOK void operator delete[](void* p, const std::nothrow_t&) noexcept { allocTrackFree(p); }
+
+#undef ALLOC_TRACK_HOOK
+
+#endif
+
+#endif // ALLOC_TRACK_H
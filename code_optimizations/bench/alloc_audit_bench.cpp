@@ -0,0 +1,182 @@
+// ============================================================================
+// Allocation audit: heap calls per operation, for every sketch structure
+// ============================================================================
+// Usage: alloc_audit_bench [ops]   (default 100000)
+//
+// Runs each operation `ops` times under its own AllocScope and reports
+// allocations/op and bytes/op from alloc_track.h. Operations documented as
+// allocation-free (pools, intrusive lists, lookups, the ring buffer...) are
+// checked: the bench exits non-zero if any of them calls new even once.
+// Ends with the tracker's own cost per new+delete and a heapReport().
+// ============================================================================
+
+#include "alloc_track/alloc_track.h"
+#include "bench.h"
+#include "binary_tree/binary_tree.h"
+#include "hash_table/hash_table.h"
+#include "linked_list/intrusive_dlist.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/node_pool.h"
+#include "linked_list/skip_list.h"
+#include "ring_buffer/ring_buffer.h"
+
+#include <string>
+#include <vector>
+
+static bool g_failed = false;
+
+// Run op(i) for i in [0, ops) attributed to `label`; print allocs/op and
+// bytes/op. mustBeZero marks operations that promise not to allocate.
+template <typename Op>
+static void audit(const char* label, size_t ops, bool mustBeZero, Op op) {
+  AllocStats before = allocStats();
+  {
+    AllocScope scope(label);
+    for (size_t i = 0; i < ops; i++) op(i);
+  }
+  AllocStats after = allocStats();
+  double allocs = static_cast<double>(after.allocs - before.allocs) / ops;
+  double bytes = static_cast<double>(after.totalBytes - before.totalBytes) / ops;
+  bool bad = mustBeZero && after.allocs != before.allocs;
+  std::printf("%-34s %10.2f %10.1f  %s\n", label, allocs, bytes,
+              mustBeZero ? (bad ? "FAIL: allocated" : "alloc-free") : "");
+  if (bad) g_failed = true;
+}
+
+struct Timer {
+  int id;
+  DListHook<Timer> hook;
+};
+
+struct Job {
+  int id;
+  ListHook<Job> hook;
+};
+
+int main(int argc, char** argv) {
+  const size_t ops = bench::maxSizeArg(argc, argv, 100000);
+  long long sink = 0;
+
+  std::printf("%-34s %10s %10s\n", "operation", "allocs/op", "bytes/op");
+
+  // ---- Linked lists ----
+  LinkedList list;
+  audit("LinkedList append (heap)", ops, false, [&](size_t i) { append(list, static_cast<int>(i)); });
+  audit("LinkedList search", 1000, true, [&](size_t i) { sink += search(list, static_cast<int>(i)); });
+  audit("LinkedList dequeue (heap)", ops, true, [&](size_t) { sink += dequeue(list); });
+
+  static NodePool<ListNode, 1024> pool;
+  LinkedList pooled;
+  audit("LinkedList append+dequeue (pool)", ops, true, [&](size_t i) {
+    append(pooled, pool, static_cast<int>(i));
+    sink += dequeue(pooled, pool);
+  });
+
+  std::vector<Job> jobs(1024);
+  IntrusiveList<Job, &Job::hook> ready;
+  audit("IntrusiveList pushBack+popFront", ops, true, [&](size_t i) {
+    ready.pushBack(&jobs[i % jobs.size()]);
+    sink += ready.popFront()->id;
+  });
+
+  std::vector<Timer> timers(1024);
+  IntrusiveDList<Timer, &Timer::hook> armed;
+  for (Timer& t : timers) armed.pushBack(&t);
+  audit("IntrusiveDList remove+pushBack", ops, true, [&](size_t i) {
+    Timer* t = &timers[(i * 7919) % timers.size()];
+    armed.remove(t);
+    armed.pushBack(t);
+  });
+
+  // ---- Trees ----
+  std::vector<int> keys(ops);
+  for (size_t i = 0; i < ops; i++) keys[i] = static_cast<int>(i);
+  bench::Rng rng(ops);
+  bench::shuffle(keys.data(), ops, rng);
+
+  TreeNode* root = nullptr;
+  audit("BST insert", ops, false, [&](size_t i) { root = insert(root, keys[i]); });
+  audit("BST search", ops, true, [&](size_t i) { sink += search(root, keys[i]); });
+  audit("BST range scan (32 keys)", 1000, true, [&](size_t i) {
+    RangeIterator it;
+    rangeBegin(it, root, static_cast<int>(i % ops), static_cast<int>(i % ops) + 32);
+    int v;
+    while (rangeNext(it, v)) sink += v;
+  });
+  audit("BST remove", ops, true, [&](size_t i) { root = remove(root, keys[i]); });
+
+  std::vector<int> sorted(ops);
+  for (size_t i = 0; i < ops; i++) sorted[i] = static_cast<int>(i);
+  std::vector<TreeNode> storage(ops);
+  audit("buildBalanced into storage", 1, true, [&](size_t) {
+    sink += buildBalanced(sorted.data(), ops, storage.data())->value;
+  });
+
+  SkipList<int> skip;
+  audit("SkipList insert", ops, false, [&](size_t i) { skip.insert(keys[i]); });
+  audit("SkipList contains", ops, true, [&](size_t i) { sink += skip.contains(keys[i]); });
+  audit("SkipList range scan (32 keys)", 1000, true, [&](size_t i) {
+    SkipList<int>::Range r = skip.range(static_cast<int>(i % ops), static_cast<int>(i % ops) + 32);
+    int v;
+    while (r.next(v)) sink += v;
+  });
+  audit("SkipList remove", ops, true, [&](size_t i) { sink += skip.remove(keys[i]); });
+
+  // ---- Hash table ----
+  std::vector<std::string> names(1000);
+  for (size_t i = 0; i < names.size(); i++) names[i] = "sensor_" + std::to_string(i);
+  HashTable table;
+  audit("HashTable set (new key)", names.size(), false,
+        [&](size_t i) { set(table, names[i].c_str(), static_cast<int>(i)); });
+  audit("HashTable set (existing key)", ops, true,
+        [&](size_t i) { set(table, names[i % names.size()].c_str(), static_cast<int>(i)); });
+  audit("HashTable get", ops, true, [&](size_t i) { sink += *get(table, names[i % names.size()].c_str()); });
+  audit("HashTable removeKey", names.size(), true,
+        [&](size_t i) { sink += removeKey(table, names[i].c_str()); });
+
+  // ---- Ring buffer ----
+  RingBuffer rb;
+  audit("RingBuffer push+pop", ops, true, [&](size_t i) {
+    char c;
+    push(rb, static_cast<char>(i));
+    if (pop(rb, c)) sink += c;
+  });
+
+  bench::doNotOptimize(sink);
+
+  // ---- Tracker overhead ----
+  const size_t pairs = 1000000;
+  std::vector<void*> blocks(64);
+  uint64_t t0 = bench::nowNs();
+  for (size_t i = 0; i < pairs; i++) {
+    void*& slot = blocks[i & 63];
+    std::free(slot);
+    slot = std::malloc(24);
+  }
+  uint64_t rawNs = bench::nowNs() - t0;
+  for (void*& slot : blocks) {
+    std::free(slot);
+    slot = nullptr;
+  }
+  std::vector<ListNode*> nodes(64, nullptr);
+  uint64_t trackedNs;
+  {
+    AllocScope scope("tracker overhead");
+    t0 = bench::nowNs();
+    for (size_t i = 0; i < pairs; i++) {
+      ListNode*& slot = nodes[i & 63];
+      delete slot;
+      slot = new ListNode;
+    }
+    trackedNs = bench::nowNs() - t0;
+    for (ListNode* node : nodes) delete node;
+  }
+
+  std::printf("\nmalloc+free %.1f ns, tracked new+delete %.1f ns (+%zu B header per block)\n\n",
+              bench::nsPer(rawNs, pairs), bench::nsPer(trackedNs, pairs), sizeof(AllocHeader));
+
+  freeList(list);
+  freeTree(root);
+  heapReport(stdout);
+  return g_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
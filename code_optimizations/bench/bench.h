@@ -0,0 +1,61 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// ============================================================================
+// Tiny host benchmark helpers shared by bench/*_bench.cpp
+// ============================================================================
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bench {
+
+inline uint64_t nowNs() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Keep the optimizer from deleting a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// xorshift64 — deterministic, fast, good enough for shuffling keys
+struct Rng {
+  uint64_t state;
+  explicit Rng(uint64_t seed = 0x9E3779B97F4A7C15ull) : state(seed ? seed : 1) {}
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+  uint32_t below(uint32_t n) { return static_cast<uint32_t>(next() % n); }
+};
+
+// Fisher-Yates shuffle of an int array
+inline void shuffle(int* data, size_t n, Rng& rng) {
+  for (size_t i = n; i > 1; i--) {
+    size_t j = rng.next() % i;
+    int tmp = data[i - 1];
+    data[i - 1] = data[j];
+    data[j] = tmp;
+  }
+}
+
+// Optional first CLI argument overrides the largest input size
+inline size_t maxSizeArg(int argc, char** argv, size_t fallback) {
+  if (argc > 1) return static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+  return fallback;
+}
+
+inline double nsPer(uint64_t elapsedNs, size_t ops) {
+  return ops ? static_cast<double>(elapsedNs) / static_cast<double>(ops) : 0.0;
+}
+
+}  // namespace bench
+
+#endif // BENCH_H
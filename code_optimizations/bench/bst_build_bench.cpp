@@ -0,0 +1,80 @@
+// ============================================================================
+// BST startup cost: repeated insert() vs buildBalanced() vs mergeSorted()
+// ============================================================================
+// Usage: bst_build_bench [max_keys]   (default 1000000, try 10000000)
+//
+// Simulates loading a sorted config table at boot. Columns:
+//   insert sorted   — the naive loop; degenerates into a list, O(n²)
+//                     (only run up to 10K keys, beyond that it takes minutes
+//                     and the recursive insert() overflows the stack)
+//   insert shuffled — best case for insert(), O(n log n)
+//   build heap      — buildBalanced(sorted, n), one new per node
+//   build block     — buildBalanced(sorted, n, storage), one allocation
+//   merge 10%       — mergeSorted() of n/10 new keys into the built tree
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/binary_tree.h"
+
+#include <vector>
+
+static double ms(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+int main(int argc, char** argv) {
+  const size_t maxKeys = bench::maxSizeArg(argc, argv, 1000000);
+
+  std::printf("%10s %14s %14s %12s %12s %12s %7s\n", "keys", "ins sorted ms", "ins shuf ms",
+              "build ms", "block ms", "merge ms", "height");
+
+  for (size_t n = 10000; n <= maxKeys; n *= 10) {
+    // Even keys for the table, odd keys for the merge batch
+    std::vector<int> sorted(n);
+    for (size_t i = 0; i < n; i++) sorted[i] = static_cast<int>(2 * i);
+    std::vector<int> batch(n / 10);
+    for (size_t i = 0; i < batch.size(); i++) batch[i] = static_cast<int>(20 * i + 1);
+
+    char sortedCol[32] = "-";
+    if (n <= 10000) {
+      uint64_t t0 = bench::nowNs();
+      TreeNode* root = nullptr;
+      for (int v : sorted) root = insert(root, v);
+      std::snprintf(sortedCol, sizeof(sortedCol), "%.2f", ms(bench::nowNs() - t0));
+      freeTree(root);
+    }
+
+    std::vector<int> shuffled(sorted);
+    bench::Rng rng(n);
+    bench::shuffle(shuffled.data(), n, rng);
+    uint64_t t0 = bench::nowNs();
+    TreeNode* root = nullptr;
+    for (int v : shuffled) root = insert(root, v);
+    uint64_t shuffledNs = bench::nowNs() - t0;
+    freeTree(root);
+
+    t0 = bench::nowNs();
+    root = buildBalanced(sorted.data(), n);
+    uint64_t buildNs = bench::nowNs() - t0;
+
+    t0 = bench::nowNs();
+    TreeNode* storage = new TreeNode[n];
+    TreeNode* table = buildBalanced(sorted.data(), n, storage);
+    uint64_t blockNs = bench::nowNs() - t0;
+    bench::doNotOptimize(table);
+    delete[] storage;
+
+    t0 = bench::nowNs();
+    root = mergeSorted(root, batch.data(), batch.size());
+    uint64_t mergeNs = bench::nowNs() - t0;
+
+    size_t expected = n + batch.size();
+    if (countNodes(root) != expected) {
+      std::fprintf(stderr, "merge lost keys at n=%zu\n", n);
+      return EXIT_FAILURE;
+    }
+
+    std::printf("%10zu %14s %14.2f %12.2f %12.2f %12.2f %7d\n", n, sortedCol, ms(shuffledNs),
+                ms(buildNs), ms(blockNs), ms(mergeNs), height(root));
+    freeTree(root);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+// ============================================================================
+// BST<K, V> ordered map vs std::map for 8-, 32- and 128-byte values
+// ============================================================================
+// Usage: bst_map_bench [keys]   (default 1000000)
+//
+// Keys are random 32-bit sensor IDs. Values are move-only calibration
+// records of N bytes. Each run does:
+//   insert  — insertOrAssign of every key (fresh tree)
+//   assign  — insertOrAssign again on existing keys (overwrite path)
+//   find    — lookup of every key, shuffled order
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/bst_map.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+template <size_t N>
+struct Calibration {
+  unsigned char bytes[N];
+
+  explicit Calibration(uint32_t seed) {
+    for (size_t i = 0; i < N; i++) bytes[i] = static_cast<unsigned char>(seed + i);
+  }
+  // Move-only, like a record that owns a resource
+  Calibration(Calibration&&) = default;
+  Calibration& operator=(Calibration&&) = default;
+  Calibration(const Calibration&) = delete;
+  Calibration& operator=(const Calibration&) = delete;
+};
+
+template <size_t N>
+static void runSize(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& probe) {
+  typedef Calibration<N> Value;
+  const size_t n = keys.size();
+
+  BST<uint32_t, Value> tree;
+  uint64_t t0 = bench::nowNs();
+  for (uint32_t k : keys) tree.insertOrAssign(k, Value(k));
+  uint64_t insertNs = bench::nowNs() - t0;
+
+  t0 = bench::nowNs();
+  for (uint32_t k : probe) tree.insertOrAssign(k, Value(k + 1));
+  uint64_t assignNs = bench::nowNs() - t0;
+
+  unsigned sum = 0;
+  t0 = bench::nowNs();
+  for (uint32_t k : probe) sum += tree.find(k)->bytes[N - 1];
+  uint64_t findNs = bench::nowNs() - t0;
+  bench::doNotOptimize(sum);
+
+  std::map<uint32_t, Value> ref;
+  t0 = bench::nowNs();
+  for (uint32_t k : keys) ref.insert_or_assign(k, Value(k));
+  uint64_t refInsertNs = bench::nowNs() - t0;
+
+  t0 = bench::nowNs();
+  for (uint32_t k : probe) ref.insert_or_assign(k, Value(k + 1));
+  uint64_t refAssignNs = bench::nowNs() - t0;
+
+  unsigned refSum = 0;
+  t0 = bench::nowNs();
+  for (uint32_t k : probe) refSum += ref.find(k)->second.bytes[N - 1];
+  uint64_t refFindNs = bench::nowNs() - t0;
+
+  if (sum != refSum || tree.size() != ref.size()) {
+    std::fprintf(stderr, "mismatch for %zu-byte values\n", N);
+    std::exit(EXIT_FAILURE);
+  }
+
+  std::printf("%6zu B | %8.1f %8.1f %8.1f | %8.1f %8.1f %8.1f\n", N, bench::nsPer(insertNs, n),
+              bench::nsPer(assignNs, n), bench::nsPer(findNs, n), bench::nsPer(refInsertNs, n),
+              bench::nsPer(refAssignNs, n), bench::nsPer(refFindNs, n));
+}
+
+int main(int argc, char** argv) {
+  const size_t n = bench::maxSizeArg(argc, argv, 1000000);
+
+  bench::Rng rng(30);
+  std::vector<uint32_t> keys(n);
+  for (size_t i = 0; i < n; i++) keys[i] = static_cast<uint32_t>(rng.next());
+  std::vector<uint32_t> probe(keys);
+  for (size_t i = n; i > 1; i--) std::swap(probe[i - 1], probe[rng.next() % i]);
+
+  std::printf("%zu keys, ns/op\n", n);
+  std::printf("%8s | %8s %8s %8s | %8s %8s %8s\n", "value", "insert", "assign", "find",
+              "map ins", "map asg", "map find");
+  runSize<8>(keys, probe);
+  runSize<32>(keys, probe);
+  runSize<128>(keys, probe);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+// ============================================================================
+// BST range scan: RangeIterator vs full in-order walk
+// ============================================================================
+// Usage: bst_range_bench [max_keys]   (default 1000000)
+//
+// Keys are the even numbers 0, 2, ..., 2(n-1), inserted in shuffled order so
+// the tree stays reasonably balanced. Each query sums the keys in a narrow
+// [lo, lo + 64) window (32 keys). The baseline walks the whole tree the way
+// inOrder() does and filters; the iterator only enters overlapping subtrees.
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/binary_tree.h"
+
+#include <vector>
+
+// What inOrder() costs when all you want is a slice of it
+static void walkRange(TreeNode* root, int lo, int hi, long long& sum) {
+  if (!root) return;
+  walkRange(root->left, lo, hi, sum);
+  if (root->value >= lo && root->value < hi) sum += root->value;
+  walkRange(root->right, lo, hi, sum);
+}
+
+static long long scanRange(TreeNode* root, int lo, int hi) {
+  RangeIterator it;
+  rangeBegin(it, root, lo, hi);
+  long long sum = 0;
+  int v;
+  while (rangeNext(it, v)) sum += v;
+  return sum;
+}
+
+int main(int argc, char** argv) {
+  const size_t maxKeys = bench::maxSizeArg(argc, argv, 1000000);
+  const int WINDOW = 64;
+
+  std::printf("%10s %8s %14s %14s %10s\n", "keys", "height", "walk ns/q", "iter ns/q",
+              "speedup");
+
+  for (size_t n = 1000; n <= maxKeys; n *= 10) {
+    bench::Rng rng(n);
+    std::vector<int> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = static_cast<int>(2 * i);
+    bench::shuffle(keys.data(), n, rng);
+
+    TreeNode* root = nullptr;
+    for (int k : keys) root = insert(root, k);
+
+    // Keep the full walk to ~20M node visits so large trees finish quickly
+    const size_t iterQueries = 100000;
+    size_t walkQueries = 20000000 / n;
+    if (walkQueries == 0) walkQueries = 1;
+
+    std::vector<int> los(iterQueries);
+    for (size_t q = 0; q < iterQueries; q++) los[q] = static_cast<int>(rng.below(2 * n));
+
+    long long walkSum = 0;
+    uint64_t t0 = bench::nowNs();
+    for (size_t q = 0; q < walkQueries; q++) walkRange(root, los[q], los[q] + WINDOW, walkSum);
+    uint64_t walkNs = bench::nowNs() - t0;
+
+    long long iterSum = 0;
+    for (size_t q = 0; q < walkQueries; q++) iterSum += scanRange(root, los[q], los[q] + WINDOW);
+    if (iterSum != walkSum) {
+      std::fprintf(stderr, "mismatch at n=%zu: walk=%lld iter=%lld\n", n, walkSum, iterSum);
+      return EXIT_FAILURE;
+    }
+
+    iterSum = 0;
+    t0 = bench::nowNs();
+    for (size_t q = 0; q < iterQueries; q++) iterSum += scanRange(root, los[q], los[q] + WINDOW);
+    uint64_t iterNs = bench::nowNs() - t0;
+    bench::doNotOptimize(iterSum);
+
+    double walkPer = bench::nsPer(walkNs, walkQueries);
+    double iterPer = bench::nsPer(iterNs, iterQueries);
+    std::printf("%10zu %8d %14.0f %14.1f %9.0fx\n", n, height(root), walkPer, iterPer,
+                walkPer / iterPer);
+
+    freeTree(root);
+  }
+  return EXIT_SUCCESS;
+}
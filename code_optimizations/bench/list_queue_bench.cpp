@@ -0,0 +1,72 @@
+// ============================================================================
+// Queue throughput: append()/dequeue() on ListNode* vs LinkedList vs
+// IntrusiveList
+// ============================================================================
+// Usage: list_queue_bench [max_items]   (default 1000000)
+//
+// Each run enqueues n items then dequeues them all (FIFO). ns/item covers
+// one enqueue plus one dequeue.
+//   head only  — the original append(ListNode*&): walks the list every time,
+//                O(n²) total, so it is skipped above 32K items
+//   head+tail  — LinkedList: O(1) append, still one new/delete per item
+//   intrusive  — IntrusiveList over preallocated objects: O(1), no heap
+// ============================================================================
+
+#include "bench.h"
+#include "linked_list/linked_list.h"
+
+#include <vector>
+
+struct Job {
+  int value;
+  ListHook<Job> hook;
+};
+
+int main(int argc, char** argv) {
+  const size_t maxItems = bench::maxSizeArg(argc, argv, 1000000);
+  const size_t HEAD_ONLY_LIMIT = 32768;
+
+  std::printf("%10s %14s %14s %14s\n", "items", "head only", "head+tail", "intrusive");
+  std::printf("%10s %14s %14s %14s\n", "", "ns/item", "ns/item", "ns/item");
+
+  for (size_t n = 1000; n <= maxItems; n *= 10) {
+    const int count = static_cast<int>(n);
+    long long expect = static_cast<long long>(n) * (n - 1) / 2;
+
+    char headCol[32] = "-";
+    if (n <= HEAD_ONLY_LIMIT) {
+      ListNode* head = nullptr;
+      long long sum = 0;
+      uint64_t t0 = bench::nowNs();
+      for (int i = 0; i < count; i++) append(head, i);
+      while (head) sum += dequeue(head);
+      uint64_t ns = bench::nowNs() - t0;
+      if (sum != expect) return EXIT_FAILURE;
+      std::snprintf(headCol, sizeof(headCol), "%.1f", bench::nsPer(ns, n));
+    }
+
+    LinkedList list;
+    long long sum = 0;
+    uint64_t t0 = bench::nowNs();
+    for (int i = 0; i < count; i++) append(list, i);
+    while (!isEmpty(list)) sum += dequeue(list);
+    uint64_t listNs = bench::nowNs() - t0;
+    if (sum != expect) return EXIT_FAILURE;
+
+    std::vector<Job> jobs(n);
+    IntrusiveList<Job, &Job::hook> queue;
+    sum = 0;
+    t0 = bench::nowNs();
+    for (int i = 0; i < count; i++) {
+      jobs[i].value = i;
+      queue.pushBack(&jobs[i]);
+    }
+    while (Job* job = queue.popFront()) sum += job->value;
+    uint64_t intrusiveNs = bench::nowNs() - t0;
+    if (sum != expect) return EXIT_FAILURE;
+
+    std::printf("%10zu %14s %14.1f %14.1f\n", n, headCol, bench::nsPer(listNs, n),
+                bench::nsPer(intrusiveNs, n));
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+// ============================================================================
+// Contention: lock-free stack/queue vs mutex-guarded linked list functions
+// ============================================================================
+// Usage: lockfree_list_bench [max_threads]   (default 32)
+//
+// Every thread runs the same loop: push one value, pop one value, repeated.
+// The total work (2M push+pop pairs) is split across 1..max_threads threads.
+//   stack: LockFreeStack   vs  prepend()/dequeue() on ListNode* + mutex
+//   queue: LockFreeQueue   vs  append()/dequeue() on LinkedList + mutex
+// Values are checksummed: everything pushed must come out exactly once.
+// ============================================================================
+
+#include "bench.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/lockfree_list.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const size_t TOTAL_PAIRS = 2000000;
+static const size_t POOL_NODES = 1 << 16;
+
+static std::atomic<long long> g_pushed{ 0 };
+static std::atomic<long long> g_popped{ 0 };
+
+// Run body(threadIndex, pairs) on n threads, return total pairs per second
+template <typename Body>
+static double runThreads(int n, Body body) {
+  std::vector<std::thread> threads;
+  size_t perThread = TOTAL_PAIRS / n;
+  std::atomic<int> ready{ 0 };
+  for (int t = 0; t < n; t++) {
+    threads.emplace_back([&, t]() {
+      ready.fetch_add(1);
+      while (ready.load() < n) std::this_thread::yield();
+      body(t, perThread);
+    });
+  }
+  uint64_t t0 = bench::nowNs();
+  for (std::thread& th : threads) th.join();
+  uint64_t ns = bench::nowNs() - t0;
+  return (perThread * n) / (ns / 1e9);
+}
+
+// Everything pushed must have been popped exactly once
+static void checkBalanced(const char* what, int threads) {
+  if (g_pushed.load() != g_popped.load()) {
+    std::fprintf(stderr, "FAIL: %s lost or duplicated values (%d threads)\n", what, threads);
+    std::exit(EXIT_FAILURE);
+  }
+  g_pushed = 0;
+  g_popped = 0;
+}
+
+int main(int argc, char** argv) {
+  const int maxThreads = static_cast<int>(bench::maxSizeArg(argc, argv, 32));
+
+  std::printf("push+pop pairs per second (millions)\n");
+  std::printf("%8s | %10s %10s | %10s %10s\n", "threads", "LF stack", "mutex", "MS queue",
+              "mutex");
+
+  for (int n = 1; n <= maxThreads; n *= 2) {
+    int leftover;
+
+    // --- Treiber stack ---
+    std::unique_ptr<LockFreeStack<POOL_NODES> > stack(new LockFreeStack<POOL_NODES>);
+    double lfStack = runThreads(n, [&](int t, size_t pairs) {
+      long long in = 0, out = 0;
+      for (size_t i = 0; i < pairs; i++) {
+        int v = static_cast<int>(t * pairs + i);
+        while (!stack->push(v)) std::this_thread::yield();
+        in += v;
+        int got;
+        if (stack->pop(got)) out += got;
+      }
+      g_pushed += in;
+      g_popped += out;
+    });
+    while (stack->pop(leftover)) g_popped += leftover;
+    checkBalanced("LockFreeStack", n);
+
+    // --- Mutex + prepend()/dequeue() ---
+    ListNode* head = nullptr;
+    std::mutex stackLock;
+    double mxStack = runThreads(n, [&](int t, size_t pairs) {
+      long long in = 0, out = 0;
+      for (size_t i = 0; i < pairs; i++) {
+        int v = static_cast<int>(t * pairs + i);
+        {
+          std::lock_guard<std::mutex> guard(stackLock);
+          prepend(head, v);
+        }
+        in += v;
+        std::lock_guard<std::mutex> guard(stackLock);
+        if (head) out += dequeue(head);
+      }
+      g_pushed += in;
+      g_popped += out;
+    });
+    while (head) g_popped += dequeue(head);
+    checkBalanced("mutex stack", n);
+
+    // --- Michael-Scott queue ---
+    std::unique_ptr<LockFreeQueue<POOL_NODES> > queue(new LockFreeQueue<POOL_NODES>);
+    double lfQueue = runThreads(n, [&](int t, size_t pairs) {
+      long long in = 0, out = 0;
+      for (size_t i = 0; i < pairs; i++) {
+        int v = static_cast<int>(t * pairs + i);
+        while (!queue->enqueue(v)) std::this_thread::yield();
+        in += v;
+        int got;
+        if (queue->dequeue(got)) out += got;
+      }
+      g_pushed += in;
+      g_popped += out;
+    });
+    while (queue->dequeue(leftover)) g_popped += leftover;
+    checkBalanced("LockFreeQueue", n);
+
+    // --- Mutex + append()/dequeue() ---
+    LinkedList list;
+    std::mutex queueLock;
+    double mxQueue = runThreads(n, [&](int t, size_t pairs) {
+      long long in = 0, out = 0;
+      for (size_t i = 0; i < pairs; i++) {
+        int v = static_cast<int>(t * pairs + i);
+        {
+          std::lock_guard<std::mutex> guard(queueLock);
+          append(list, v);
+        }
+        in += v;
+        std::lock_guard<std::mutex> guard(queueLock);
+        if (!isEmpty(list)) out += dequeue(list);
+      }
+      g_pushed += in;
+      g_popped += out;
+    });
+    while (!isEmpty(list)) g_popped += dequeue(list);
+    checkBalanced("mutex queue", n);
+
+    std::printf("%8d | %10.2f %10.2f | %10.2f %10.2f\n", n, lfStack / 1e6, mxStack / 1e6,
+                lfQueue / 1e6, mxQueue / 1e6);
+  }
+  return EXIT_SUCCESS;
+}
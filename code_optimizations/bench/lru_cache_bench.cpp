@@ -0,0 +1,249 @@
+// ============================================================================
+// LRU cache with TTL: replay sensor polling traces
+// ============================================================================
+// Usage: lru_cache_bench [polls]   (default 1000000 per trace)
+//
+// Each trace is a list of (millis, command) polls, like READ:TEMP arriving
+// over UART. Every poll does what cachedRead() in ring_buffer.ino does:
+// get(), and on a miss "analogRead" + put(). Per trace it reports
+//   hit %        polls answered from the cache
+//   ADC saved    analogRead calls avoided × ~112 µs each on an Uno
+//   ns/poll      LruCache vs the same policy on std::list + unordered_map
+// The std:: version is also the reference: hits, misses, expirations and
+// evictions must match exactly or the bench exits with an error.
+// ============================================================================
+
+#include "bench.h"
+#include "ring_buffer/lru_cache.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Poll {
+  uint32_t ms;
+  uint8_t sensor;
+};
+
+struct Sensor {
+  char name[LRU_KEY_LEN];
+  uint32_t ttl;
+};
+
+struct Trace {
+  const char* name;
+  std::vector<Sensor> sensors;
+  std::vector<Poll> polls;
+};
+
+// ---- Traces ----
+
+static std::vector<Sensor> makeSensors(size_t n, uint32_t ttl) {
+  std::vector<Sensor> sensors(n);
+  for (size_t i = 0; i < n; i++) {
+    std::snprintf(sensors[i].name, LRU_KEY_LEN, "READ:S%zu", i);
+    sensors[i].ttl = ttl;
+  }
+  return sensors;
+}
+
+// One sensor, polled at 10 Hz with ±20 ms jitter; readings valid for 1 s
+static Trace steadyPoll(size_t polls, bench::Rng& rng) {
+  Trace t{ "1 sensor @10Hz, ttl 1s", makeSensors(1, 1000), {} };
+  std::snprintf(t.sensors[0].name, LRU_KEY_LEN, "READ:TEMP");
+  uint32_t ms = 0;
+  for (size_t i = 0; i < polls; i++) {
+    ms += 80 + rng.below(41);
+    t.polls.push_back(Poll{ ms, 0 });
+  }
+  return t;
+}
+
+// Dashboard: 4 sensors on their own periods, each TTL ~ its drift rate
+static Trace dashboard(size_t polls, bench::Rng& rng) {
+  Trace t{ "4 sensors, mixed rates", makeSensors(4, 0), {} };
+  const uint32_t period[4] = { 50, 100, 250, 500 };
+  const uint32_t ttl[4] = { 1000, 100, 2000, 200 };
+  uint32_t next[4] = { 0, 0, 0, 0 };
+  for (int s = 0; s < 4; s++) t.sensors[s].ttl = ttl[s];
+  while (t.polls.size() < polls) {
+    int s = 0;
+    for (int i = 1; i < 4; i++) if (next[i] < next[s]) s = i;
+    t.polls.push_back(Poll{ next[s], static_cast<uint8_t>(s) });
+    next[s] += period[s] - 5 + rng.below(11);
+  }
+  return t;
+}
+
+// 90% of polls go to 3 hot sensors, the rest to 12 cold ones
+static Trace hotCold(size_t polls, bench::Rng& rng) {
+  Trace t{ "3 hot + 12 cold sensors", makeSensors(15, 500), {} };
+  uint32_t ms = 0;
+  for (size_t i = 0; i < polls; i++) {
+    ms += 5 + rng.below(10);
+    uint8_t s = rng.below(10) < 9 ? rng.below(3) : 3 + rng.below(12);
+    t.polls.push_back(Poll{ ms, s });
+  }
+  return t;
+}
+
+// LRU's worst case: cycling through more keys than fit evicts every entry
+// just before it is needed again
+static Trace roundRobin(size_t polls, bench::Rng&) {
+  Trace t{ "6 sensors round-robin", makeSensors(6, 5000), {} };
+  for (size_t i = 0; i < polls; i++) {
+    t.polls.push_back(Poll{ static_cast<uint32_t>(i * 10), static_cast<uint8_t>(i % 6) });
+  }
+  return t;
+}
+
+// ---- Reference: same policy on std:: containers ----
+
+class StdLru {
+public:
+  explicit StdLru(size_t capacity) : capacity_(capacity) {}
+
+  bool get(const std::string& key, uint32_t now, int& out) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      stats.misses++;
+      return false;
+    }
+    Item& item = *it->second;
+    if (now - item.stored >= item.ttl) {
+      stats.misses++;
+      stats.expirations++;
+      order_.erase(it->second);
+      index_.erase(it);
+      return false;
+    }
+    order_.splice(order_.begin(), order_, it->second);
+    out = item.value;
+    stats.hits++;
+    return true;
+  }
+
+  void put(const std::string& key, int value, uint32_t now, uint32_t ttl) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      order_.splice(order_.begin(), order_, it->second);
+    } else {
+      if (order_.size() == capacity_) {
+        index_.erase(order_.back().key);
+        order_.pop_back();
+        stats.evictions++;
+      }
+      order_.push_front(Item{ key, 0, 0, 0 });
+      index_[key] = order_.begin();
+    }
+    Item& item = order_.front();
+    item.value = value;
+    item.stored = now;
+    item.ttl = ttl;
+  }
+
+  LruStats stats = LruStats();
+
+private:
+  struct Item {
+    std::string key;
+    int value;
+    uint32_t stored;
+    uint32_t ttl;
+  };
+  size_t capacity_;
+  std::list<Item> order_;
+  std::unordered_map<std::string, std::list<Item>::iterator> index_;
+};
+
+// ---- Replay ----
+
+// Fake ADC: the value only has to be deterministic
+static int adcRead(uint8_t sensor, uint32_t ms) { return (sensor * 131 + ms / 7) & 1023; }
+
+template <size_t Capacity>
+static LruStats replayCache(const Trace& t, uint64_t& ns, long long& sink) {
+  LruCache<int, Capacity> cache;
+  uint64_t t0 = bench::nowNs();
+  for (const Poll& p : t.polls) {
+    const Sensor& s = t.sensors[p.sensor];
+    int raw;
+    if (!cache.get(s.name, p.ms, raw)) {
+      raw = adcRead(p.sensor, p.ms);
+      cache.put(s.name, raw, p.ms, s.ttl);
+    }
+    sink += raw;
+  }
+  ns = bench::nowNs() - t0;
+  return cache.stats();
+}
+
+static LruStats replayStd(const Trace& t, size_t capacity, uint64_t& ns, long long& sink) {
+  StdLru cache(capacity);
+  std::vector<std::string> names;
+  for (const Sensor& s : t.sensors) names.push_back(s.name);
+  uint64_t t0 = bench::nowNs();
+  for (const Poll& p : t.polls) {
+    const Sensor& s = t.sensors[p.sensor];
+    int raw;
+    if (!cache.get(names[p.sensor], p.ms, raw)) {
+      raw = adcRead(p.sensor, p.ms);
+      cache.put(names[p.sensor], raw, p.ms, s.ttl);
+    }
+    sink += raw;
+  }
+  ns = bench::nowNs() - t0;
+  return cache.stats;
+}
+
+static bool sameStats(const LruStats& a, const LruStats& b) {
+  return a.hits == b.hits && a.misses == b.misses && a.expirations == b.expirations &&
+         a.evictions == b.evictions;
+}
+
+template <size_t Capacity>
+static bool runTrace(const Trace& t) {
+  long long sinkCache = 0, sinkStd = 0;
+  uint64_t cacheNs, stdNs;
+  LruStats st = replayCache<Capacity>(t, cacheNs, sinkCache);
+  LruStats ref = replayStd(t, Capacity, stdNs, sinkStd);
+  bench::doNotOptimize(sinkCache);
+
+  size_t polls = t.polls.size();
+  double hitPct = 100.0 * st.hits / polls;
+  double adcSavedS = st.hits * 112e-6;  // analogRead ≈ 112 µs at 16 MHz
+  std::printf("%-26s %4zu %7.1f%% %9u %9u %11.1fs %9.1f %9.1f\n", t.name, Capacity, hitPct,
+              st.expirations, st.evictions, adcSavedS, bench::nsPer(cacheNs, polls),
+              bench::nsPer(stdNs, polls));
+
+  if (!sameStats(st, ref) || sinkCache != sinkStd) {
+    std::fprintf(stderr, "MISMATCH on '%s': LruCache %u/%u/%u/%u vs std %u/%u/%u/%u (hits/misses/exp/evict)\n",
+                 t.name, st.hits, st.misses, st.expirations, st.evictions, ref.hits, ref.misses,
+                 ref.expirations, ref.evictions);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const size_t polls = bench::maxSizeArg(argc, argv, 1000000);
+  bench::Rng rng(polls);
+
+  std::vector<Trace> traces;
+  traces.push_back(steadyPoll(polls, rng));
+  traces.push_back(dashboard(polls, rng));
+  traces.push_back(hotCold(polls, rng));
+  traces.push_back(roundRobin(polls, rng));
+
+  std::printf("%zu polls per trace\n\n", polls);
+  std::printf("%-26s %4s %8s %9s %9s %12s %9s %9s\n", "trace", "cap", "hit", "expired", "evicted",
+              "ADC saved", "ns/poll", "std ns");
+
+  bool ok = true;
+  for (const Trace& t : traces) {
+    ok = runTrace<4>(t) && ok;
+    ok = runTrace<8>(t) && ok;
+  }
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+// ============================================================================
+// NodePool: zero heap calls in steady state, and ops/sec vs new/delete
+// ============================================================================
+// Usage: node_pool_bench [ops]   (default 10000000)
+//
+// Models a task queue: prefill to a working depth, then churn — every
+// iteration appends one item and dequeues one. The same LinkedList code
+// runs once on HeapNodes (new/delete) and once on a static NodePool.
+//
+// Global operator new/delete are replaced in this binary to count calls.
+// The pooled run must make ZERO heap calls after the pool exists; the bench
+// exits non-zero if it makes any, or if the pool reports a failure.
+// ============================================================================
+
+#include "bench.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/node_pool.h"
+
+#include <new>
+
+static uint64_t g_heapCalls = 0;
+
+void* operator new(size_t size) {
+  g_heapCalls++;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept {
+  if (p) g_heapCalls++;
+  std::free(p);
+}
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+static const size_t POOL_NODES = 4096;
+static const size_t DEPTH = 1024;  // items queued at any time
+
+template <typename Nodes>
+static uint64_t churn(Nodes& nodes, size_t ops, long long& sum, uint64_t& heapCalls) {
+  LinkedList queue;
+  for (size_t i = 0; i < DEPTH; i++) append(queue, nodes, static_cast<int>(i));
+
+  uint64_t callsBefore = g_heapCalls;
+  uint64_t t0 = bench::nowNs();
+  for (size_t i = 0; i < ops; i++) {
+    append(queue, nodes, static_cast<int>(i));
+    sum += dequeue(queue, nodes);
+  }
+  uint64_t ns = bench::nowNs() - t0;
+  heapCalls = g_heapCalls - callsBefore;
+
+  freeList(queue, nodes);
+  return ns;
+}
+
+static NodePool<ListNode, POOL_NODES> g_pool;  // static storage, built before main()
+
+int main(int argc, char** argv) {
+  const size_t ops = bench::maxSizeArg(argc, argv, 10000000);
+
+  HeapNodes heap;
+  long long heapSum = 0, poolSum = 0;
+  uint64_t heapCalls = 0, poolCalls = 0;
+  uint64_t heapNs = churn(heap, ops, heapSum, heapCalls);
+  uint64_t poolNs = churn(g_pool, ops, poolSum, poolCalls);
+
+  std::printf("%zu enqueue+dequeue pairs at depth %zu\n", ops, DEPTH);
+  std::printf("%10s %14s %14s %12s\n", "nodes", "Mops/s", "ns/pair", "heap calls");
+  std::printf("%10s %14.1f %14.1f %12llu\n", "new/delete", ops / (heapNs / 1e3),
+              bench::nsPer(heapNs, ops), static_cast<unsigned long long>(heapCalls));
+  std::printf("%10s %14.1f %14.1f %12llu\n", "NodePool", ops / (poolNs / 1e3),
+              bench::nsPer(poolNs, ops), static_cast<unsigned long long>(poolCalls));
+  std::printf("pool: capacity %zu, peak %zu, in use %zu, failures %zu\n", g_pool.capacity(),
+              g_pool.peak(), g_pool.used(), g_pool.failures());
+
+  if (heapSum != poolSum) {
+    std::fprintf(stderr, "FAIL: pooled queue returned different values\n");
+    return EXIT_FAILURE;
+  }
+  if (poolCalls != 0 || g_pool.failures() != 0 || g_pool.used() != 0) {
+    std::fprintf(stderr, "FAIL: pooled churn touched the heap or leaked nodes\n");
+    return EXIT_FAILURE;
+  }
+  std::printf("OK: zero heap calls during pooled churn\n");
+  return EXIT_SUCCESS;
+}
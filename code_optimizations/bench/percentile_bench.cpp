@@ -0,0 +1,83 @@
+// ============================================================================
+// Streaming percentiles: order-statistics SlidingWindow vs sort-per-query
+// ============================================================================
+// Usage: percentile_bench [window]   (default 1000000)
+//
+// Feeds 2 × window samples of a drifting, noisy sensor (random walk plus
+// jitter, so there are many duplicates and long sorted runs) into a
+// SlidingWindow, then measures p50/p95/p99 queries per second. The baseline
+// copies the window and runs std::nth_element three times per query, which
+// is the cheapest way to answer the same question without the tree.
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/order_stat_tree.h"
+
+#include <algorithm>
+#include <vector>
+
+int main(int argc, char** argv) {
+  const size_t window = bench::maxSizeArg(argc, argv, 1000000);
+  const unsigned PCTS[] = { 50, 95, 99 };
+
+  std::vector<int> samples(window);
+  SlidingWindow w;
+  windowInit(w, samples.data(), window);
+
+  // Random-walk sensor: drifts slowly, jitters a little
+  bench::Rng rng(42);
+  int level = 50000;
+  auto nextSample = [&]() {
+    level += static_cast<int>(rng.below(21)) - 10;
+    return level + static_cast<int>(rng.below(200));
+  };
+
+  const size_t pushes = 2 * window;
+  uint64_t t0 = bench::nowNs();
+  for (size_t i = 0; i < pushes; i++) windowPush(w, nextSample());
+  uint64_t pushNs = bench::nowNs() - t0;
+
+  const size_t queries = 1000000;
+  long long acc = 0;
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < queries; q++) {
+    for (unsigned p : PCTS) acc += windowPercentile(w, p);
+    // Keep the window moving so queries don't hit a frozen tree
+    if ((q & 1023) == 0) windowPush(w, nextSample());
+  }
+  uint64_t treeNs = bench::nowNs() - t0;
+  bench::doNotOptimize(acc);
+
+  // Baseline: copy + nth_element for each percentile
+  const size_t sortQueries = 20;
+  std::vector<int> scratch(window);
+  int expect[3] = { 0, 0, 0 };
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < sortQueries; q++) {
+    std::copy(samples.begin(), samples.end(), scratch.begin());
+    for (int i = 0; i < 3; i++) {
+      size_t k = (PCTS[i] * window + 99) / 100;
+      std::nth_element(scratch.begin(), scratch.begin() + (k - 1), scratch.end());
+      expect[i] = scratch[k - 1];
+    }
+  }
+  uint64_t sortNs = bench::nowNs() - t0;
+
+  for (int i = 0; i < 3; i++) {
+    if (windowPercentile(w, PCTS[i]) != expect[i]) {
+      std::fprintf(stderr, "p%u mismatch: tree=%d sort=%d\n", PCTS[i],
+                   windowPercentile(w, PCTS[i]), expect[i]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::printf("window %zu samples, %zu distinct values (tree nodes)\n", window,
+              statNodes(w.root));
+  std::printf("  push (insert + evict): %10.1f ns/sample\n", bench::nsPer(pushNs, pushes));
+  std::printf("  p50/p95/p99 tree:      %10.0f queries/s\n", queries / (treeNs / 1e9));
+  std::printf("  p50/p95/p99 sort:      %10.1f queries/s\n", sortQueries / (sortNs / 1e9));
+  std::printf("  p50=%d p95=%d p99=%d\n", expect[0], expect[1], expect[2]);
+
+  windowFree(w);
+  return EXIT_SUCCESS;
+}
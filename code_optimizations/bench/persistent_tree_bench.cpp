@@ -0,0 +1,120 @@
+// ============================================================================
+// Concurrent readers + one writer: PersistentTree vs shared_mutex BST
+// ============================================================================
+// Usage: persistent_tree_bench [max_readers]   (default 32)
+//
+// A 100K-key index is read by 1..max_readers threads while one writer
+// thread keeps inserting and removing random keys. Reported per run:
+//   reads/s   — total lookups completed by all readers
+//   writes/s  — updates the writer completed in the same window
+//   retired   — nodes still waiting on epoch reclamation at the end
+//
+// The baseline is binary_tree.h guarded by a std::shared_mutex: readers take
+// a shared lock, the writer an exclusive one for every insert()/remove().
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/binary_tree.h"
+#include "binary_tree/persistent_tree.h"
+
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+static const int KEYS = 100000;
+static const int KEY_SPACE = 2 * KEYS;
+static const int RUN_MS = 200;
+
+struct Result {
+  double readsPerSec;
+  double writesPerSec;
+  size_t retired;
+};
+
+template <typename ReadFn, typename WriteFn>
+static Result run(int readers, ReadFn readOnce, WriteFn writeOnce) {
+  std::atomic<bool> stop{ false };
+  std::vector<uint64_t> reads(readers, 0);
+  uint64_t writes = 0;
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&, r]() {
+      bench::Rng rng(r + 1);
+      uint64_t n = 0, hits = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        hits += readOnce(r, static_cast<int>(rng.below(KEY_SPACE)));
+        n++;
+      }
+      bench::doNotOptimize(hits);
+      reads[r] = n;
+    });
+  }
+  std::thread writer([&]() {
+    bench::Rng rng(999);
+    while (!stop.load(std::memory_order_relaxed)) {
+      writeOnce(static_cast<int>(rng.below(KEY_SPACE)), (rng.next() & 1) != 0);
+      writes++;
+    }
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(RUN_MS));
+  stop.store(true);
+  for (std::thread& t : threads) t.join();
+  writer.join();
+
+  uint64_t totalReads = 0;
+  for (uint64_t n : reads) totalReads += n;
+  double secs = RUN_MS / 1000.0;
+  return Result{ totalReads / secs, writes / secs, 0 };
+}
+
+int main(int argc, char** argv) {
+  const int maxReaders = static_cast<int>(bench::maxSizeArg(argc, argv, 32));
+
+  std::vector<int> keys(KEYS);
+  for (int i = 0; i < KEYS; i++) keys[i] = 2 * i;
+  bench::Rng rng(7);
+  bench::shuffle(keys.data(), KEYS, rng);
+
+  std::printf("%8s | %14s %12s %8s | %14s %12s\n", "readers", "cow reads/s", "writes/s",
+              "retired", "rwlock reads/s", "writes/s");
+
+  for (int readers = 1; readers <= maxReaders; readers *= 2) {
+    // --- Persistent tree: lock-free snapshot reads ---
+    PersistentTree cow;
+    for (int k : keys) cow.insert(k);
+    std::vector<int> slots(readers);
+    for (int r = 0; r < readers; r++) slots[r] = cow.registerReader();
+
+    Result a = run(
+        readers,
+        [&](int r, int key) {
+          PersistentTree::ReadGuard guard(cow, slots[r]);
+          return search(guard.root(), key) ? 1 : 0;
+        },
+        [&](int key, bool add) { add ? cow.insert(key) : cow.remove(key); });
+    a.retired = cow.retiredCount();
+
+    // --- Mutable BST behind a reader/writer lock ---
+    TreeNode* root = nullptr;
+    for (int k : keys) root = insert(root, k);
+    std::shared_mutex lock;
+
+    Result b = run(
+        readers,
+        [&](int, int key) {
+          std::shared_lock<std::shared_mutex> guard(lock);
+          return search(root, key) ? 1 : 0;
+        },
+        [&](int key, bool add) {
+          std::unique_lock<std::shared_mutex> guard(lock);
+          root = add ? insert(root, key) : remove(root, key);
+        });
+    freeTree(root);
+
+    std::printf("%8d | %14.0f %12.0f %8zu | %14.0f %12.0f\n", readers, a.readsPerSec,
+                a.writesPerSec, a.retired, b.readsPerSec, b.writesPerSec);
+  }
+  return EXIT_SUCCESS;
+}
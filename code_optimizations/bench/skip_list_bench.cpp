@@ -0,0 +1,208 @@
+// ============================================================================
+// Sorted collections: linked list vs BST vs SkipList vs std::set
+// ============================================================================
+// Usage: skip_list_bench [max_keys]   (default 1000000)
+//
+// Keys are the even numbers 0, 2, ..., 2(n-1), inserted either shuffled or
+// already sorted (the BST's worst case). Per structure:
+//   insert  ns/key   — build from empty
+//   search  ns/query — random keys, half of them absent (odd)
+//   range   ns/query — sum of a [lo, lo + 64) window (32 keys)
+//
+// list = ListNode + prepend(); it is unsorted, so search() and range scans
+// walk the whole list. Slow rows run fewer queries. The BST is skipped
+// ("-") on sorted input past 20K keys: it is a list by then and its
+// recursive insert() would dive 20K frames deep.
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/binary_tree.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/skip_list.h"
+
+#include <set>
+#include <vector>
+
+static const int WINDOW = 64;
+static const size_t QUERIES = 200000;
+static const size_t MAX_DEGENERATE_BST = 20000;
+
+enum { LIST, BST, SKIP, SET, KINDS };
+static const char* const NAMES[KINDS] = { "list", "BST", "skip", "set" };
+
+struct Result {
+  double insertNs[KINDS];
+  double searchNs[KINDS];
+  double rangeNs[KINDS];
+};
+
+// O(n) queries get fewer repetitions: ~20M node visits per measurement
+static size_t linearQueries(size_t n) {
+  size_t q = 20000000 / n;
+  if (q > QUERIES) q = QUERIES;
+  return q ? q : 1;
+}
+
+static void fail(const char* what, size_t n) {
+  std::fprintf(stderr, "FAIL: %s disagrees with std::set at n=%zu\n", what, n);
+  std::exit(EXIT_FAILURE);
+}
+
+static Result run(size_t n, bool sorted) {
+  Result r;
+  bench::Rng rng(n * 2 + sorted);
+  std::vector<int> keys(n);
+  for (size_t i = 0; i < n; i++) keys[i] = static_cast<int>(2 * i);
+  if (!sorted) bench::shuffle(keys.data(), n, rng);
+
+  std::vector<int> probes(QUERIES);
+  for (int& p : probes) p = static_cast<int>(rng.below(static_cast<uint32_t>(2 * n)));
+
+  const bool bstOk = !sorted || n <= MAX_DEGENERATE_BST;
+  const size_t listQ = linearQueries(n);
+  const size_t bstQ = sorted ? listQ : QUERIES;  // a sorted BST is O(n) too
+  uint64_t t0;
+
+  // ---- insert ----
+  ListNode* list = nullptr;
+  t0 = bench::nowNs();
+  for (int k : keys) prepend(list, k);
+  r.insertNs[LIST] = bench::nsPer(bench::nowNs() - t0, n);
+
+  TreeNode* root = nullptr;
+  r.insertNs[BST] = -1;
+  if (bstOk) {
+    t0 = bench::nowNs();
+    for (int k : keys) root = insert(root, k);
+    r.insertNs[BST] = bench::nsPer(bench::nowNs() - t0, n);
+  }
+
+  SkipList<int> skip;
+  t0 = bench::nowNs();
+  for (int k : keys) skip.insert(k);
+  r.insertNs[SKIP] = bench::nsPer(bench::nowNs() - t0, n);
+
+  std::set<int> set;
+  t0 = bench::nowNs();
+  for (int k : keys) set.insert(k);
+  r.insertNs[SET] = bench::nsPer(bench::nowNs() - t0, n);
+
+  // ---- search ----
+  size_t hits[KINDS] = { 0, 0, 0, 0 };
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < listQ; q++) hits[LIST] += search(list, probes[q]);
+  r.searchNs[LIST] = bench::nsPer(bench::nowNs() - t0, listQ);
+
+  r.searchNs[BST] = -1;
+  if (bstOk) {
+    t0 = bench::nowNs();
+    for (size_t q = 0; q < bstQ; q++) hits[BST] += search(root, probes[q]);
+    r.searchNs[BST] = bench::nsPer(bench::nowNs() - t0, bstQ);
+  }
+
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < QUERIES; q++) hits[SKIP] += skip.contains(probes[q]);
+  r.searchNs[SKIP] = bench::nsPer(bench::nowNs() - t0, QUERIES);
+
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < QUERIES; q++) hits[SET] += set.count(probes[q]);
+  r.searchNs[SET] = bench::nsPer(bench::nowNs() - t0, QUERIES);
+
+  size_t expectListHits = 0, expectBstHits = 0;
+  for (size_t q = 0; q < listQ; q++) expectListHits += set.count(probes[q]);
+  for (size_t q = 0; q < bstQ; q++) expectBstHits += set.count(probes[q]);
+  if (hits[LIST] != expectListHits) fail("list search", n);
+  if (bstOk && hits[BST] != expectBstHits) fail("BST search", n);
+  if (hits[SKIP] != hits[SET]) fail("SkipList search", n);
+
+  // ---- range ----
+  long long sums[KINDS] = { 0, 0, 0, 0 };
+  int v;
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < listQ; q++) {
+    int lo = probes[q], hi = lo + WINDOW;
+    for (ListNode* node = list; node; node = node->next)
+      if (node->value >= lo && node->value < hi) sums[LIST] += node->value;
+  }
+  r.rangeNs[LIST] = bench::nsPer(bench::nowNs() - t0, listQ);
+
+  r.rangeNs[BST] = -1;
+  if (bstOk) {
+    t0 = bench::nowNs();
+    for (size_t q = 0; q < bstQ; q++) {
+      RangeIterator it;
+      rangeBegin(it, root, probes[q], probes[q] + WINDOW);
+      while (rangeNext(it, v)) sums[BST] += v;
+    }
+    r.rangeNs[BST] = bench::nsPer(bench::nowNs() - t0, bstQ);
+  }
+
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < QUERIES; q++) {
+    SkipList<int>::Range range = skip.range(probes[q], probes[q] + WINDOW);
+    while (range.next(v)) sums[SKIP] += v;
+  }
+  r.rangeNs[SKIP] = bench::nsPer(bench::nowNs() - t0, QUERIES);
+
+  t0 = bench::nowNs();
+  for (size_t q = 0; q < QUERIES; q++) {
+    std::set<int>::const_iterator end = set.lower_bound(probes[q] + WINDOW);
+    for (std::set<int>::const_iterator it = set.lower_bound(probes[q]); it != end; ++it)
+      sums[SET] += *it;
+  }
+  r.rangeNs[SET] = bench::nsPer(bench::nowNs() - t0, QUERIES);
+
+  long long expectListSum = 0, expectBstSum = 0;
+  for (size_t q = 0; q < bstQ || q < listQ; q++) {
+    std::set<int>::const_iterator end = set.lower_bound(probes[q] + WINDOW);
+    for (std::set<int>::const_iterator it = set.lower_bound(probes[q]); it != end; ++it) {
+      if (q < listQ) expectListSum += *it;
+      if (q < bstQ) expectBstSum += *it;
+    }
+  }
+  if (sums[LIST] != expectListSum) fail("list range", n);
+  if (bstOk && sums[BST] != expectBstSum) fail("BST range", n);
+  if (sums[SKIP] != sums[SET]) fail("SkipList range", n);
+
+  freeList(list);
+  freeTree(root);
+  return r;
+}
+
+static void printCell(double ns) {
+  if (ns < 0) std::printf(" %10s", "-");
+  else        std::printf(" %10.1f", ns);
+}
+
+static void printTable(const char* title, const std::vector<size_t>& sizes,
+                       const std::vector<Result>& shuffled, const std::vector<Result>& sorted,
+                       double (Result::*column)[KINDS]) {
+  std::printf("\n%s\n%10s %9s", title, "keys", "order");
+  for (int k = 0; k < KINDS; k++) std::printf(" %10s", NAMES[k]);
+  std::printf("\n");
+  for (size_t i = 0; i < sizes.size(); i++) {
+    for (int s = 0; s < 2; s++) {
+      const Result& r = s ? sorted[i] : shuffled[i];
+      std::printf("%10zu %9s", sizes[i], s ? "sorted" : "shuffled");
+      for (int k = 0; k < KINDS; k++) printCell((r.*column)[k]);
+      std::printf("\n");
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t maxKeys = bench::maxSizeArg(argc, argv, 1000000);
+
+  std::vector<size_t> sizes;
+  std::vector<Result> shuffled, sorted;
+  for (size_t n = 1000; n <= maxKeys; n *= 10) {
+    sizes.push_back(n);
+    shuffled.push_back(run(n, false));
+    sorted.push_back(run(n, true));
+  }
+
+  printTable("insert ns/key", sizes, shuffled, sorted, &Result::insertNs);
+  printTable("search ns/query", sizes, shuffled, sorted, &Result::searchNs);
+  printTable("range ns/query (32 keys)", sizes, shuffled, sorted, &Result::rangeNs);
+  return EXIT_SUCCESS;
+}
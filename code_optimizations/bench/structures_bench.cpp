@@ -0,0 +1,380 @@
+// ============================================================================
+// All four sketches, same workloads: measured numbers for the overview table
+// ============================================================================
+// Usage: structures_bench [max_n] [csv_path]
+//        (defaults: 100000, structures.csv)
+//
+// Runs the linked list (LinkedList), BST, skip list, hash table and ring
+// buffer from the sketch headers through the same workloads at n = 100, 1K, 10K, ...:
+//
+//   seq_insert    insert the even keys 0, 2, .., 2(n-1) in order
+//                 (the BST's worst case)
+//   rand_insert   insert the same keys shuffled
+//   lookup_hit    n lookups of present (even) keys
+//   lookup_miss   n lookups of absent (odd) keys
+//   delete        remove every key, in a different random order
+//   iterate       walk every stored value, at least 16 times (ns per element)
+//   mixed         n ops: 50% lookup, 25% insert, 25% delete, keys in [0, 2n)
+//
+// Every cell reports ns/op, heap allocations/op (global operator new is
+// counted in this binary) and peak RSS growth in KB during the cell. RSS is
+// Linux-only: the peak is reset through /proc/self/clear_refs before each
+// cell, and -1 is written where that is unavailable.
+//
+// A cell stops after CELL_BUDGET_NS; the CSV "ops" column then shows how
+// far it got and the summary marks it with '*'. That keeps O(n) and O(n^2)
+// cells (list lookups, sorted BST inserts, the 16-bucket hash table at
+// large n) from running for minutes.
+//
+// The ring buffer is a 64-byte FIFO, not a set. insert = push (dropping the
+// oldest byte when full), delete = pop, lookup = linear scan for a byte
+// value. It never holds more than 64 bytes, so delete and iterate only see
+// those.
+// ============================================================================
+
+#include "bench.h"
+#include "binary_tree/binary_tree.h"
+#include "hash_table/hash_table.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/skip_list.h"
+#include "ring_buffer/ring_buffer.h"
+
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+static const uint64_t CELL_BUDGET_NS = 250000000;  // 250 ms
+
+// ---- Heap counting -----------------------------------------------------
+
+static uint64_t g_allocs = 0;
+
+void* operator new(size_t size) {
+  g_allocs++;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// ---- Peak RSS (Linux) --------------------------------------------------
+
+// Reads a "Name:   1234 kB" line from /proc/self/status, -1 if unavailable
+static long procStatusKb(const char* field) {
+  FILE* f = std::fopen("/proc/self/status", "r");
+  if (!f) return -1;
+  char line[256];
+  long kb = -1;
+  size_t len = std::strlen(field);
+  while (std::fgets(line, sizeof(line), f)) {
+    if (std::strncmp(line, field, len) == 0 && line[len] == ':') {
+      kb = std::strtol(line + len + 1, nullptr, 10);
+      break;
+    }
+  }
+  std::fclose(f);
+  return kb;
+}
+
+// Returns the current RSS and restarts peak tracking from it, -1 if unsupported
+static long resetPeakRss() {
+#if defined(__GLIBC__)
+  malloc_trim(0);  // hand freed memory back so earlier cells don't hide growth
+#endif
+  FILE* f = std::fopen("/proc/self/clear_refs", "w");
+  if (!f) return -1;
+  bool ok = std::fputs("5", f) >= 0;
+  ok = std::fclose(f) == 0 && ok;
+  return ok ? procStatusKb("VmRSS") : -1;
+}
+
+static long peakRssGrowthKb(long baseKb) {
+  if (baseKb < 0) return -1;
+  long peak = procStatusKb("VmHWM");
+  return peak < 0 ? -1 : peak - baseKb;
+}
+
+// ---- Subjects ----------------------------------------------------------
+// Same calls on every structure. Keys are ints in [0, 2n].
+
+struct ListSubject {
+  static const char* name() { return "linked_list"; }
+  LinkedList list;
+
+  explicit ListSubject(size_t) {}
+  ~ListSubject() { clear(); }
+  void insert(int k) { append(list, k); }
+  bool find(int k) const { return search(list, k); }
+  bool erase(int k) { return removeValue(list, k); }
+  size_t size() const { return list.count; }
+  long long iterate() const {
+    long long sum = 0;
+    for (ListNode* n = list.head; n; n = n->next) sum += n->value;
+    return sum;
+  }
+  void clear() { freeList(list); }
+};
+
+struct BstSubject {
+  static const char* name() { return "binary_tree"; }
+  TreeNode* root = nullptr;
+  size_t count = 0;
+
+  explicit BstSubject(size_t) {}
+  ~BstSubject() { clear(); }
+  void insert(int k) {
+    root = ::insert(root, k);
+    count = 0;  // recounted lazily by size()
+  }
+  bool find(int k) const { return search(root, k); }
+  bool erase(int k) {
+    root = ::remove(root, k);
+    count = 0;
+    return true;
+  }
+  size_t size() { return count ? count : (count = countNodes(root)); }
+  static long long walk(const TreeNode* node) {
+    return node ? walk(node->left) + node->value + walk(node->right) : 0;
+  }
+  long long iterate() const { return walk(root); }
+  void clear() {
+    freeTree(root);
+    root = nullptr;
+    count = 0;
+  }
+};
+
+struct SkipSubject {
+  static const char* name() { return "skip_list"; }
+  SkipList<int> list;
+
+  explicit SkipSubject(size_t) {}
+  void insert(int k) { list.insert(k); }
+  bool find(int k) const { return list.contains(k); }
+  bool erase(int k) { return list.remove(k); }
+  size_t size() const { return list.size(); }
+  long long iterate() const {
+    long long sum = 0;
+    list.forEach([&](int v) { sum += v; });
+    return sum;
+  }
+  void clear() { list.clear(); }
+};
+
+// Key k is the string "k<k>", built once up front: the table stores the
+// pointers, never copies
+struct HashSubject {
+  static const char* name() { return "hash_table"; }
+  HashTable table;
+  std::vector<std::string> keys;
+
+  explicit HashSubject(size_t n) : keys(2 * n + 1) {
+    for (size_t i = 0; i < keys.size(); i++) keys[i] = "k" + std::to_string(i);
+  }
+  ~HashSubject() { clear(); }
+  const char* key(int k) const { return keys[k].c_str(); }
+  void insert(int k) { set(table, key(k), k); }
+  bool find(int k) { return get(table, key(k)) != nullptr; }
+  bool erase(int k) { return removeKey(table, key(k)); }
+  size_t size() const {
+    size_t count = 0;
+    for (int i = 0; i < TABLE_SIZE; i++)
+      for (Entry* e = table.buckets[i]; e; e = e->next) count++;
+    return count;
+  }
+  long long iterate() const {
+    long long sum = 0;
+    for (int i = 0; i < TABLE_SIZE; i++)
+      for (Entry* e = table.buckets[i]; e; e = e->next) sum += e->value;
+    return sum;
+  }
+  void clear() { freeTable(table); }
+};
+
+// Even key k pushes byte (k / 2) & 0x7F; odd keys (misses) look for 0xFF,
+// which is never pushed
+struct RingSubject {
+  static const char* name() { return "ring_buffer"; }
+  RingBuffer rb;
+
+  explicit RingSubject(size_t) {}
+  static char byteFor(int k) {
+    return (k & 1) ? static_cast<char>(0xFF) : static_cast<char>((k >> 1) & 0x7F);
+  }
+  void insert(int k) {
+    char dropped;
+    if (rb.count == BUF_SIZE) pop(rb, dropped);
+    push(rb, byteFor(k));
+  }
+  bool find(int k) const {
+    char c = byteFor(k);
+    for (int i = 0, at = rb.tail; i < rb.count; i++, at = (at + 1) % BUF_SIZE)
+      if (rb.data[at] == c) return true;
+    return false;
+  }
+  bool erase(int) {
+    char c;
+    return pop(rb, c);
+  }
+  size_t size() const { return rb.count; }
+  long long iterate() const {
+    long long sum = 0;
+    for (int i = 0, at = rb.tail; i < rb.count; i++, at = (at + 1) % BUF_SIZE) sum += rb.data[at];
+    return sum;
+  }
+  void clear() { rb.head = rb.tail = rb.count = 0; }
+};
+
+// ---- Workloads ---------------------------------------------------------
+
+enum Workload { SEQ_INSERT, RAND_INSERT, LOOKUP_HIT, LOOKUP_MISS, DELETE, ITERATE, MIXED, WORKLOADS };
+static const char* const WORKLOAD_NAMES[WORKLOADS] = {
+  "seq_insert", "rand_insert", "lookup_hit", "lookup_miss", "delete", "iterate", "mixed",
+};
+
+struct Cell {
+  size_t ops;        // ops actually run
+  size_t target;     // ops the workload asked for
+  double nsPerOp;
+  double allocsPerOp;
+  long peakRssKb;
+};
+
+// Times body(i) for i in [0, count) until done or out of budget
+template <typename Body>
+static Cell measure(size_t count, Body body) {
+  Cell cell;
+  cell.target = count;
+  long baseKb = resetPeakRss();
+  uint64_t allocsBefore = g_allocs;
+  uint64_t t0 = bench::nowNs();
+  size_t i = 0;
+  for (; i < count; i++) {
+    if ((i & 63) == 0 && i && bench::nowNs() - t0 > CELL_BUDGET_NS) break;
+    body(i);
+  }
+  uint64_t ns = bench::nowNs() - t0;
+  cell.ops = i;
+  cell.nsPerOp = bench::nsPer(ns, i);
+  cell.allocsPerOp = i ? static_cast<double>(g_allocs - allocsBefore) / i : 0.0;
+  cell.peakRssKb = peakRssGrowthKb(baseKb);
+  return cell;
+}
+
+template <typename Subject>
+static void runAll(size_t n, Cell cells[WORKLOADS]) {
+  bench::Rng rng(n);
+  std::vector<int> order(n);
+  for (size_t i = 0; i < n; i++) order[i] = static_cast<int>(2 * i);
+  std::vector<int> shuffled(order), deletes(order);
+  bench::shuffle(shuffled.data(), n, rng);
+  bench::shuffle(deletes.data(), n, rng);
+  std::vector<int> probes(n);  // even = hit, +1 = miss
+  for (int& p : probes) p = static_cast<int>(2 * rng.below(static_cast<uint32_t>(n)));
+  std::vector<uint32_t> mixed(n);
+  for (uint32_t& m : mixed) m = static_cast<uint32_t>(rng.next());
+
+  Subject s(n);
+  long long sink = 0;
+
+  cells[SEQ_INSERT] = measure(n, [&](size_t i) { s.insert(order[i]); });
+  s.clear();
+  cells[RAND_INSERT] = measure(n, [&](size_t i) { s.insert(shuffled[i]); });
+  s.clear();
+
+  // Read-only workloads share one complete build (untimed)
+  for (int k : shuffled) s.insert(k);
+  cells[LOOKUP_HIT] = measure(n, [&](size_t i) { sink += s.find(probes[i]); });
+  cells[LOOKUP_MISS] = measure(n, [&](size_t i) { sink += s.find(probes[i] + 1); });
+
+  // Walk the whole structure repeatedly, report ns per element
+  size_t held = s.size();
+  size_t walks = held ? (n + held - 1) / held : 0;
+  if (held && walks < 16) walks = 16;
+  cells[ITERATE] = measure(walks, [&](size_t) { sink += s.iterate(); });
+  cells[ITERATE].nsPerOp = held ? cells[ITERATE].nsPerOp / held : 0.0;
+  cells[ITERATE].allocsPerOp = held ? cells[ITERATE].allocsPerOp / held : 0.0;
+
+  cells[DELETE] = measure(held, [&](size_t i) { sink += s.erase(deletes[i]); });
+  s.clear();
+
+  for (int k : shuffled) s.insert(k);
+  cells[MIXED] = measure(n, [&](size_t i) {
+    uint32_t r = mixed[i];
+    int k = static_cast<int>((r >> 2) % (2 * n));
+    switch (r & 3) {
+      case 0:
+      case 1: sink += s.find(k); break;
+      case 2: s.insert(k); break;
+      default: sink += s.erase(k); break;
+    }
+  });
+  s.clear();
+  bench::doNotOptimize(sink);
+}
+
+// ---- Output ------------------------------------------------------------
+
+enum Subject { LIST, BST, SKIP, HASH, RING, SUBJECTS };
+static const char* const SUBJECT_NAMES[SUBJECTS] = {
+  ListSubject::name(), BstSubject::name(), SkipSubject::name(),
+  HashSubject::name(), RingSubject::name(),
+};
+
+static void printSummary(size_t n, Cell cells[SUBJECTS][WORKLOADS]) {
+  std::printf("\nn = %zu   ns/op  (allocs/op)   * = stopped at the time budget\n", n);
+  std::printf("%-12s", "");
+  for (int w = 0; w < WORKLOADS; w++) std::printf(" %17s", WORKLOAD_NAMES[w]);
+  std::printf(" %9s\n", "RSS KB");
+  for (int s = 0; s < SUBJECTS; s++) {
+    std::printf("%-12s", SUBJECT_NAMES[s]);
+    for (int w = 0; w < WORKLOADS; w++) {
+      const Cell& c = cells[s][w];
+      char text[32];
+      std::snprintf(text, sizeof(text), "%.1f%s (%.2f)", c.nsPerOp, c.ops < c.target ? "*" : "",
+                    c.allocsPerOp);
+      std::printf(" %17s", text);
+    }
+    std::printf(" %9ld\n", cells[s][RAND_INSERT].peakRssKb);
+  }
+}
+
+int main(int argc, char** argv) {
+  const size_t maxN = bench::maxSizeArg(argc, argv, 100000);
+  const char* csvPath = argc > 2 ? argv[2] : "structures.csv";
+
+  FILE* csv = std::fopen(csvPath, "w");
+  if (!csv) {
+    std::fprintf(stderr, "cannot write %s\n", csvPath);
+    return EXIT_FAILURE;
+  }
+  std::fprintf(csv, "structure,workload,n,ops,ns_per_op,allocs_per_op,peak_rss_kb\n");
+
+  for (size_t n = 100; n <= maxN; n *= 10) {
+    Cell cells[SUBJECTS][WORKLOADS];
+    runAll<ListSubject>(n, cells[LIST]);
+    runAll<BstSubject>(n, cells[BST]);
+    runAll<SkipSubject>(n, cells[SKIP]);
+    runAll<HashSubject>(n, cells[HASH]);
+    runAll<RingSubject>(n, cells[RING]);
+
+    for (int s = 0; s < SUBJECTS; s++) {
+      for (int w = 0; w < WORKLOADS; w++) {
+        const Cell& c = cells[s][w];
+        std::fprintf(csv, "%s,%s,%zu,%zu,%.2f,%.3f,%ld\n", SUBJECT_NAMES[s], WORKLOAD_NAMES[w], n,
+                     c.ops, c.nsPerOp, c.allocsPerOp, c.peakRssKb);
+      }
+    }
+    printSummary(n, cells);
+  }
+
+  std::fclose(csv);
+  std::printf("\nwrote %s\n", csvPath);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+// ============================================================================
+// Cancel-heavy timer list: removeValue() vs IntrusiveDList::remove()
+// ============================================================================
+// Usage: timer_cancel_bench [max_active]   (default 100000)
+//
+// Keeps `active` timers armed. Every step cancels one random armed timer and
+// arms a new one in its place (think debounce timers restarted on every
+// button bounce). ns/step covers one cancel plus one schedule.
+//   removeValue — timers are ids in a ListNode list; cancel searches, O(n)
+//   handle      — timers embed a DListHook; cancel unlinks directly, O(1)
+// ============================================================================
+
+#include "bench.h"
+#include "linked_list/intrusive_dlist.h"
+#include "linked_list/linked_list.h"
+
+#include <vector>
+
+struct Timer {
+  int id;
+  unsigned long deadline;
+  DListHook<Timer> hook;
+};
+
+int main(int argc, char** argv) {
+  const size_t maxActive = bench::maxSizeArg(argc, argv, 100000);
+
+  std::printf("%10s %16s %16s %10s\n", "active", "removeValue ns", "handle ns", "speedup");
+
+  for (size_t active = 100; active <= maxActive; active *= 10) {
+    // O(n) baseline gets fewer steps so big lists still finish quickly
+    const size_t handleSteps = 1000000;
+    size_t listSteps = 200000000 / active;
+    if (listSteps > handleSteps) listSteps = handleSteps;
+
+    bench::Rng rng(active);
+    std::vector<uint32_t> picks(handleSteps);
+    for (uint32_t& p : picks) p = rng.below(static_cast<uint32_t>(active));
+
+    // --- ListNode ids + removeValue() ---
+    // slot[i] holds the id currently armed in position i
+    std::vector<int> slot(active);
+    ListNode* list = nullptr;
+    for (size_t i = 0; i < active; i++) {
+      slot[i] = static_cast<int>(i);
+      prepend(list, slot[i]);
+    }
+    int nextId = static_cast<int>(active);
+    uint64_t t0 = bench::nowNs();
+    for (size_t s = 0; s < listSteps; s++) {
+      uint32_t i = picks[s];
+      removeValue(list, slot[i]);
+      slot[i] = nextId++;
+      prepend(list, slot[i]);
+    }
+    uint64_t listNs = bench::nowNs() - t0;
+
+    // Every cancel must have found its timer: same count, same ids
+    size_t listCount = 0;
+    long long listSum = 0, slotSum = 0;
+    for (ListNode* n = list; n; n = n->next, listCount++) listSum += n->value;
+    for (int id : slot) slotSum += id;
+    if (listCount != active || listSum != slotSum) {
+      std::fprintf(stderr, "FAIL: removeValue lost a timer (active=%zu)\n", active);
+      return EXIT_FAILURE;
+    }
+    freeList(list);
+
+    // --- Intrusive doubly linked list + handles ---
+    std::vector<Timer> timers(active);
+    IntrusiveDList<Timer, &Timer::hook> armed;
+    for (size_t i = 0; i < active; i++) {
+      timers[i].id = static_cast<int>(i);
+      timers[i].deadline = i;
+      armed.pushBack(&timers[i]);
+    }
+    nextId = static_cast<int>(active);
+    t0 = bench::nowNs();
+    for (size_t s = 0; s < handleSteps; s++) {
+      Timer* t = &timers[picks[s]];
+      armed.remove(t);       // cancel
+      t->id = nextId++;      // re-arm with a new deadline
+      t->deadline += 1000;
+      armed.pushBack(t);
+    }
+    uint64_t handleNs = bench::nowNs() - t0;
+    size_t armedCount = 0;
+    for (Timer* t = armed.front(); t; t = armed.next(t)) armedCount++;
+    if (armed.size() != active || armedCount != active) {
+      std::fprintf(stderr, "FAIL: IntrusiveDList lost a timer (active=%zu)\n", active);
+      return EXIT_FAILURE;
+    }
+
+    double listPer = bench::nsPer(listNs, listSteps);
+    double handlePer = bench::nsPer(handleNs, handleSteps);
+    std::printf("%10zu %16.1f %16.1f %9.0fx\n", active, listPer, handlePer, listPer / handlePer);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+// ============================================================================
+// Unrolled list vs ListNode chain vs std::vector
+// ============================================================================
+// Usage: unrolled_list_bench [max_items]   (default 1000000)
+//
+// Columns (ns per element visited, or per operation):
+//   traverse — sum every value
+//   search   — 200 lookups of random values (half of them misses)
+//   remove   — removeValue() of 200 random present values
+//
+// The ListNode chain is linked in shuffled allocation order to mimic a
+// heap that has been churning for a while; a freshly built list would sit
+// in address order and hide the pointer-chasing cost.
+// ============================================================================
+
+#include "bench.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/unrolled_list.h"
+
+#include <algorithm>
+#include <vector>
+
+static const int QUERIES = 200;
+
+int main(int argc, char** argv) {
+  const size_t maxItems = bench::maxSizeArg(argc, argv, 1000000);
+
+  std::printf("%9s | %-22s | %-29s | %-29s\n", "", "traverse ns/elem", "search ns/op",
+              "remove ns/op");
+  std::printf("%9s | %6s %7s %7s | %9s %9s %9s | %9s %9s %9s\n", "items", "list", "unroll",
+              "vector", "list", "unroll", "vector", "list", "unroll", "vector");
+
+  for (size_t n = 1000; n <= maxItems; n *= 10) {
+    bench::Rng rng(n);
+    std::vector<int> values(n);
+    for (size_t i = 0; i < n; i++) values[i] = static_cast<int>(2 * i);
+
+    // ListNode chain in shuffled allocation order
+    std::vector<ListNode*> nodes(n);
+    for (size_t i = 0; i < n; i++) nodes[i] = new ListNode{ values[i], nullptr };
+    for (size_t i = n; i > 1; i--) std::swap(nodes[i - 1], nodes[rng.next() % i]);
+    for (size_t i = 0; i + 1 < n; i++) nodes[i]->next = nodes[i + 1];
+    ListNode* head = nodes[0];
+    std::vector<int> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = nodes[i]->value;
+
+    UnrolledList unrolled;
+    for (int v : order) append(unrolled, v);
+    std::vector<int> vec(order);
+
+    std::vector<int> probes(QUERIES);
+    for (int& p : probes) p = static_cast<int>(rng.below(2 * n));  // odd = miss
+    std::vector<int> victims(QUERIES);
+    for (int& v : victims) v = static_cast<int>(2 * rng.below(n));
+
+    // --- traverse ---
+    long long a = 0, b = 0, c = 0;
+    uint64_t t0 = bench::nowNs();
+    for (ListNode* cur = head; cur; cur = cur->next) a += cur->value;
+    uint64_t listTrav = bench::nowNs() - t0;
+    t0 = bench::nowNs();
+    for (UnrolledChunk* ch = unrolled.head; ch; ch = ch->next)
+      for (unsigned short i = 0; i < ch->count; i++) b += ch->values[i];
+    uint64_t unrollTrav = bench::nowNs() - t0;
+    t0 = bench::nowNs();
+    for (int v : vec) c += v;
+    uint64_t vecTrav = bench::nowNs() - t0;
+    if (a != b || b != c) return EXIT_FAILURE;
+
+    // --- search ---
+    int hitsA = 0, hitsB = 0, hitsC = 0;
+    t0 = bench::nowNs();
+    for (int p : probes) hitsA += search(head, p);
+    uint64_t listSearch = bench::nowNs() - t0;
+    t0 = bench::nowNs();
+    for (int p : probes) hitsB += search(unrolled, p);
+    uint64_t unrollSearch = bench::nowNs() - t0;
+    t0 = bench::nowNs();
+    for (int p : probes) hitsC += std::find(vec.begin(), vec.end(), p) != vec.end();
+    uint64_t vecSearch = bench::nowNs() - t0;
+    if (hitsA != hitsB || hitsB != hitsC) return EXIT_FAILURE;
+
+    // --- remove ---
+    int goneA = 0, goneB = 0, goneC = 0;
+    t0 = bench::nowNs();
+    for (int v : victims) goneA += removeValue(head, v);
+    uint64_t listRemove = bench::nowNs() - t0;
+    t0 = bench::nowNs();
+    for (int v : victims) goneB += removeValue(unrolled, v);
+    uint64_t unrollRemove = bench::nowNs() - t0;
+    t0 = bench::nowNs();
+    for (int v : victims) {
+      std::vector<int>::iterator it = std::find(vec.begin(), vec.end(), v);
+      if (it != vec.end()) { vec.erase(it); goneC++; }
+    }
+    uint64_t vecRemove = bench::nowNs() - t0;
+    if (goneA != goneB || goneB != goneC) return EXIT_FAILURE;
+
+    std::printf("%9zu | %6.2f %7.2f %7.2f | %9.0f %9.0f %9.0f | %9.0f %9.0f %9.0f\n", n,
+                bench::nsPer(listTrav, n), bench::nsPer(unrollTrav, n), bench::nsPer(vecTrav, n),
+                bench::nsPer(listSearch, QUERIES), bench::nsPer(unrollSearch, QUERIES),
+                bench::nsPer(vecSearch, QUERIES), bench::nsPer(listRemove, QUERIES),
+                bench::nsPer(unrollRemove, QUERIES), bench::nsPer(vecRemove, QUERIES));
+
+    freeList(head);
+    freeList(unrolled);
+  }
+  return EXIT_SUCCESS;
+}
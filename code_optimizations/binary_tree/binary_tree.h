@@ -0,0 +1,292 @@
+#ifndef BINARY_TREE_H
+#define BINARY_TREE_H
+
+#include <stddef.h>
+
+// ============================================================================
+// Binary Search Tree — core operations (no Arduino dependencies)
+// ============================================================================
+// Shared by binary_tree.ino and the host benchmarks in ../bench/.
+// Anything that prints lives in the sketch, not here.
+//
+// Key property: left child < parent < right child (set behavior, no dupes)
+// ============================================================================
+
+struct TreeNode {
+  int value;
+  TreeNode* left;
+  TreeNode* right;
+};
+
+inline TreeNode* newNode(int value) {
+  return new TreeNode{ value, nullptr, nullptr };
+}
+
+// Insert — O(log n) average
+inline TreeNode* insert(TreeNode* root, int value) {
+  if (!root) return newNode(value);
+  if (value < root->value)
+    root->left  = insert(root->left,  value);
+  else if (value > root->value)
+    root->right = insert(root->right, value);
+  // equal values are ignored (set behavior)
+  return root;
+}
+
+// Search — O(log n) average
+inline bool search(TreeNode* root, int value) {
+  if (!root) return false;
+  if (value == root->value) return true;
+  if (value < root->value) return search(root->left,  value);
+  else                     return search(root->right, value);
+}
+
+// Find the minimum node (used for deletion)
+inline TreeNode* findMin(TreeNode* root) {
+  while (root->left) root = root->left;
+  return root;
+}
+
+// Remove a value — O(log n) average
+inline TreeNode* remove(TreeNode* root, int value) {
+  if (!root) return nullptr;
+  if (value < root->value) {
+    root->left  = remove(root->left,  value);
+  } else if (value > root->value) {
+    root->right = remove(root->right, value);
+  } else {
+    // Found the node to delete
+    if (!root->left) {          // no left child
+      TreeNode* temp = root->right;
+      delete root;
+      return temp;
+    } else if (!root->right) {  // no right child
+      TreeNode* temp = root->left;
+      delete root;
+      return temp;
+    }
+    // Two children: replace with in-order successor
+    TreeNode* successor = findMin(root->right);
+    root->value = successor->value;
+    root->right = remove(root->right, successor->value);
+  }
+  return root;
+}
+
+// Tree height (useful to check if it's becoming unbalanced)
+inline int height(TreeNode* root) {
+  if (!root) return 0;
+  int l = height(root->left);
+  int r = height(root->right);
+  return 1 + (l > r ? l : r);
+}
+
+inline void freeTree(TreeNode* root) {
+  if (!root) return;
+  freeTree(root->left);
+  freeTree(root->right);
+  delete root;
+}
+
+inline size_t countNodes(TreeNode* root) {
+  if (!root) return 0;
+  return 1 + countNodes(root->left) + countNodes(root->right);
+}
+
+// ---- Bulk build --------------------------------------------------------
+// Repeated insert() of sorted input builds a linked list: O(n²) time and
+// O(n) height. Picking the middle element as the root and recursing on
+// each half gives a perfectly balanced tree in O(n), recursion depth log n.
+//
+// Input must be sorted ascending with no duplicates.
+
+// Give nodes[lo..hi) the values sorted[lo..hi) and link them balanced
+inline TreeNode* linkBalanced(TreeNode** nodes, const int* sorted, size_t lo, size_t hi) {
+  if (lo >= hi) return nullptr;
+  size_t mid = lo + (hi - lo) / 2;
+  TreeNode* node = nodes[mid];
+  node->value = sorted[mid];
+  node->left  = linkBalanced(nodes, sorted, lo, mid);
+  node->right = linkBalanced(nodes, sorted, mid + 1, hi);
+  return node;
+}
+
+// Same, but the nodes are consecutive elements of one array
+inline TreeNode* linkBalanced(TreeNode* storage, const int* sorted, size_t lo, size_t hi) {
+  if (lo >= hi) return nullptr;
+  size_t mid = lo + (hi - lo) / 2;
+  TreeNode* node = &storage[mid];
+  node->value = sorted[mid];
+  node->left  = linkBalanced(storage, sorted, lo, mid);
+  node->right = linkBalanced(storage, sorted, mid + 1, hi);
+  return node;
+}
+
+// Build from sorted data — O(n), one new per node.
+// The result is an ordinary tree: insert(), remove() and freeTree() all work.
+inline TreeNode* buildBalanced(const int* sorted, size_t n) {
+  if (n == 0) return nullptr;
+  TreeNode** nodes = new TreeNode*[n];
+  for (size_t i = 0; i < n; i++) nodes[i] = new TreeNode{ 0, nullptr, nullptr };
+  TreeNode* root = linkBalanced(nodes, sorted, 0, n);
+  delete[] nodes;
+  return root;
+}
+
+// Build from sorted data into caller-provided storage — O(n), no heap.
+// storage must hold n nodes (a static array on the MCU, or new TreeNode[n]).
+// The caller owns storage: do NOT call remove() or freeTree() on this tree.
+// Ideal for lookup tables that are built once at startup and only searched.
+inline TreeNode* buildBalanced(const int* sorted, size_t n, TreeNode* storage) {
+  return linkBalanced(storage, sorted, 0, n);
+}
+
+// Append the nodes of root to out[] in sorted order, returning the new count
+inline size_t collectInOrder(TreeNode* root, TreeNode** out, size_t count) {
+  if (!root) return count;
+  count = collectInOrder(root->left, out, count);
+  out[count++] = root;
+  return collectInOrder(root->right, out, count);
+}
+
+// Insert a sorted batch into an existing tree — O(n + m), returns new root.
+// Merges the tree's in-order sequence with the batch (dropping values that
+// are already present) and relinks everything balanced. Existing nodes are
+// reused; only genuinely new values allocate.
+inline TreeNode* mergeSorted(TreeNode* root, const int* sorted, size_t m) {
+  size_t n = countNodes(root);
+  if (m == 0) return root;
+
+  TreeNode** nodes = new TreeNode*[n + m];
+  int* merged = new int[n + m];
+  collectInOrder(root, nodes, 0);
+
+  // Classic two-way merge of the tree's values with the batch
+  size_t i = 0, j = 0, total = 0;
+  while (i < n || j < m) {
+    int next;
+    if (j == m || (i < n && nodes[i]->value <= sorted[j])) {
+      next = nodes[i++]->value;
+    } else {
+      next = sorted[j++];
+    }
+    if (total == 0 || merged[total - 1] != next) merged[total++] = next;
+  }
+
+  for (size_t k = n; k < total; k++) nodes[k] = new TreeNode{ 0, nullptr, nullptr };
+  TreeNode* mergedRoot = linkBalanced(nodes, merged, 0, total);
+
+  delete[] merged;
+  delete[] nodes;
+  return mergedRoot;
+}
+
+// ---- Ordered queries ---------------------------------------------------
+
+// First node with value >= key, or nullptr — O(log n) average, no recursion
+inline TreeNode* lowerBound(TreeNode* root, int key) {
+  TreeNode* best = nullptr;
+  while (root) {
+    if (root->value >= key) { best = root; root = root->left; }
+    else                    { root = root->right; }
+  }
+  return best;
+}
+
+// First node with value > key, or nullptr
+inline TreeNode* upperBound(TreeNode* root, int key) {
+  TreeNode* best = nullptr;
+  while (root) {
+    if (root->value > key) { best = root; root = root->left; }
+    else                   { root = root->right; }
+  }
+  return best;
+}
+
+// ---- Range iterator ----------------------------------------------------
+// Streams the values in [lo, hi) in sorted order:
+//
+//   RangeIterator it;
+//   rangeBegin(it, root, 20, 60);
+//   int v;
+//   while (rangeNext(it, v)) { ... }
+//
+// The iterator keeps the pending ancestors on a fixed-size stack inside
+// the struct, so iterating never touches the heap. Subtrees entirely
+// below lo or at/above hi are never entered.
+//
+// A degenerate tree can be deeper than the stack. When that happens the
+// oldest (largest) pending ancestor is dropped, and once the stack runs
+// dry the iterator re-descends from the root to the first value after the
+// last one it returned. Output stays correct; only that step costs O(h).
+
+const int RANGE_STACK_DEPTH = 32;
+
+struct RangeIterator {
+  TreeNode* root;
+  TreeNode* stack[RANGE_STACK_DEPTH];
+  int depth;       // entries currently on the stack
+  int hi;          // exclusive upper bound
+  int last;        // last value returned (for re-descend)
+  bool started;    // true once a value has been returned
+  bool truncated;  // true if an ancestor was dropped from the stack
+};
+
+inline void rangePush(RangeIterator& it, TreeNode* node) {
+  if (it.depth == RANGE_STACK_DEPTH) {
+    // Drop the bottom entry — it is the largest pending value
+    for (int i = 1; i < RANGE_STACK_DEPTH; i++) it.stack[i - 1] = it.stack[i];
+    it.depth--;
+    it.truncated = true;
+  }
+  it.stack[it.depth++] = node;
+}
+
+// Push the left spine of every node >= key on the way down from node
+inline void rangeDescend(RangeIterator& it, TreeNode* node, int key, bool inclusive) {
+  while (node) {
+    if (node->value > key || (inclusive && node->value == key)) {
+      rangePush(it, node);
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+}
+
+// Position the iterator before the first value >= lo
+inline void rangeBegin(RangeIterator& it, TreeNode* root, int lo, int hi) {
+  it.root = root;
+  it.depth = 0;
+  it.hi = hi;
+  it.last = lo;
+  it.started = false;
+  it.truncated = false;
+  rangeDescend(it, root, lo, true);
+}
+
+// Fetch the next value in range — O(1) amortized; false when exhausted
+inline bool rangeNext(RangeIterator& it, int& out) {
+  if (it.depth == 0) {
+    if (!it.truncated) return false;
+    // Lost ancestors to stack overflow — rebuild the path from the root
+    it.truncated = false;
+    rangeDescend(it, it.root, it.last, !it.started);
+    if (it.depth == 0) return false;
+  }
+  TreeNode* node = it.stack[--it.depth];
+  if (node->value >= it.hi) {
+    // Everything still pending is even larger — stop for good
+    it.depth = 0;
+    it.truncated = false;
+    return false;
+  }
+  out = node->value;
+  it.last = node->value;
+  it.started = true;
+  // Successors: the left spine of the right subtree (all > node, all >= lo)
+  for (TreeNode* cur = node->right; cur; cur = cur->left) rangePush(it, cur);
+  return true;
+}
+
+#endif // BINARY_TREE_H
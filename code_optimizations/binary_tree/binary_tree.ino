@@ -6,6 +6,12 @@
 //   search()   O(log n)
 //   remove()   O(log n)
 //   inOrder()  O(n)     — prints sorted output!
+//   lowerBound() O(log n) — first value >= key (upperBound: > key)
+//   rangeNext()  O(1)*    — streams [lo, hi) without visiting the rest
+//   buildBalanced() O(n)  — balanced tree straight from sorted data
+//   mergeSorted()   O(n+m) — bulk-insert a sorted batch, stays balanced
+//
+//   * amortized, after an O(log n) rangeBegin()
 //
 // Key property: left child < parent < right child
 // Best for: sorted data, fast lookup, range queries
@@ -13,69 +19,31 @@
 //             → use AVL or Red-Black tree for self-balancing
 // ============================================================
 
-struct Node {
-  int value;
-  Node* left;
-  Node* right;
+#include "binary_tree.h"      // TreeNode, insert(), search(), remove(), range iterator
+#include "order_stat_tree.h"  // StatNode, rank(), select(), SlidingWindow
+#include "bst_map.h"          // BST<K, V, Compare> ordered map
+#if defined(ALLOC_TRACK)
+#include <alloc_track.h>  // heapReport() — counts every new/delete
+#else
+// Tracking is opt-in (make compile SKETCH=... ALLOC_TRACK=1): without it
+// the core's own new/delete run and these calls count nothing
+struct AllocStats {};
+inline AllocStats allocStats() { return AllocStats(); }
+inline long allocsSince(const AllocStats&) { return -1; }  // -1 = not counted
+struct AllocScope {
+  explicit AllocScope(const char*) {}
 };
+inline void heapReport(Print& out) { out.println(F("heap: not tracked (build with ALLOC_TRACK=1)")); }
+#endif
 
-Node* newNode(int value) {
-  return new Node{ value, nullptr, nullptr };
-}
-
-// Insert — O(log n) average
-Node* insert(Node* root, int value) {
-  if (!root) return newNode(value);
-  if (value < root->value)
-    root->left  = insert(root->left,  value);
-  else if (value > root->value)
-    root->right = insert(root->right, value);
-  // equal values are ignored (set behavior)
-  return root;
-}
-
-// Search — O(log n) average
-bool search(Node* root, int value) {
-  if (!root) return false;
-  if (value == root->value) return true;
-  if (value < root->value) return search(root->left,  value);
-  else                     return search(root->right, value);
-}
-
-// Find the minimum node (used for deletion)
-Node* findMin(Node* root) {
-  while (root->left) root = root->left;
-  return root;
-}
-
-// Remove a value — O(log n) average
-Node* remove(Node* root, int value) {
-  if (!root) return nullptr;
-  if (value < root->value) {
-    root->left  = remove(root->left,  value);
-  } else if (value > root->value) {
-    root->right = remove(root->right, value);
-  } else {
-    // Found the node to delete
-    if (!root->left) {          // no left child
-      Node* temp = root->right;
-      delete root;
-      return temp;
-    } else if (!root->right) {  // no right child
-      Node* temp = root->left;
-      delete root;
-      return temp;
-    }
-    // Two children: replace with in-order successor
-    Node* successor = findMin(root->right);
-    root->value = successor->value;
-    root->right = remove(root->right, successor->value);
-  }
-  return root;
-}
+// Per-sensor calibration, stored by value in the map
+struct Calibration {
+  int offset;
+  int gainPercent;
+};
 
 // In-order traversal: LEFT → ROOT → RIGHT → always prints sorted!
-void inOrder(Node* root) {
+void inOrder(TreeNode* root) {
   if (!root) return;
   inOrder(root->left);
   Serial.print(root->value);
@@ -83,31 +51,19 @@ void inOrder(Node* root) {
   inOrder(root->right);
 }
 
-// Tree height (useful to check if it's becoming unbalanced)
-int height(Node* root) {
-  if (!root) return 0;
-  int l = height(root->left);
-  int r = height(root->right);
-  return 1 + (l > r ? l : r);
-}
-
-void freeTree(Node* root) {
-  if (!root) return;
-  freeTree(root->left);
-  freeTree(root->right);
-  delete root;
-}
-
 // ---
 
 void setup() {
   Serial.begin(115200);
 
-  Node* root = nullptr;
+  TreeNode* root = nullptr;
 
   // Insert values in random order
   int values[] = { 50, 30, 70, 20, 40, 60, 80 };
-  for (int v : values) root = insert(root, v);
+  {
+    AllocScope scope("bst");
+    for (int v : values) root = insert(root, v);
+  }
 
   //        50
   //       /  \
@@ -134,7 +90,74 @@ void setup() {
   inOrder(root);  // 20 40 50 60 70 80
   Serial.println();
 
+  // Range query — only the subtrees overlapping [45, 75) are visited
+  Serial.print("Range [45, 75): ");
+  RangeIterator it;
+  rangeBegin(it, root, 45, 75);
+  int v;
+  while (rangeNext(it, v)) {
+    Serial.print(v);
+    Serial.print(" ");
+  }
+  Serial.println();  // 50 60 70
+
+  TreeNode* lb = lowerBound(root, 55);
+  Serial.print("lowerBound(55): ");
+  Serial.println(lb ? lb->value : -1);  // 60
+
   freeTree(root);
+
+  // Sorted config table → balanced tree in O(n), no heap at all
+  static const int thresholds[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150 };
+  const size_t count = sizeof(thresholds) / sizeof(thresholds[0]);
+  static TreeNode storage[count];
+  AllocStats before = allocStats();
+  TreeNode* table = buildBalanced(thresholds, count, storage);
+  Serial.print("Allocations for the static table: ");
+  Serial.println(allocsSince(before));  // 0
+
+  Serial.print("Balanced table height: ");
+  Serial.println(height(table));  // 4 (repeated insert() would give 15)
+
+  // Bulk merge into a heap tree — existing nodes are relinked, not copied
+  TreeNode* live = buildBalanced(thresholds, 7);
+  static const int batch[] = { 5, 25, 45, 65, 85 };
+  live = mergeSorted(live, batch, 5);
+  Serial.print("After mergeSorted: ");
+  inOrder(live);  // 5 10 20 25 30 40 45 50 60 65 70 85
+  Serial.println();
+  Serial.print("Height: ");
+  Serial.println(height(live));  // 4
+  freeTree(live);
+  // storage is static — nothing to free for 'table'
+
+  // Order-statistics tree: percentiles of the last 16 readings, no sorting
+  static int recent[16];
+  SlidingWindow window;
+  windowInit(window, recent, 16);
+  for (int i = 0; i < 40; i++) windowPush(window, 500 + (i * 37) % 50);  // fake ADC noise
+
+  Serial.print("Last 16 readings — p50: ");
+  Serial.print(windowPercentile(window, 50));
+  Serial.print("  p95: ");
+  Serial.print(windowPercentile(window, 95));
+  Serial.print("  below 520: ");
+  Serial.println((int)rank(window.root, 520));
+  windowFree(window);
+
+  // Generic map: sensor ID → calibration record, kept sorted by ID
+  BST<uint8_t, Calibration> calibration;
+  calibration.insertOrAssign(12, Calibration{ -3, 100 });
+  calibration.insertOrAssign(4,  Calibration{ 5, 98 });
+  calibration.insertOrAssign(12, Calibration{ -2, 101 });  // overwrites ID 12
+
+  Calibration* cal = calibration.find(12);
+  Serial.print("Sensor 12 offset: ");
+  Serial.println(cal ? cal->offset : 0);  // -2
+  Serial.print("Calibrated sensors: ");
+  Serial.println((int)calibration.size());  // 2
+
+  heapReport(Serial);  // the calibration map is still live here
 }
 
 void loop() {}
@@ -0,0 +1,157 @@
+#ifndef BST_MAP_H
+#define BST_MAP_H
+
+// ============================================================================
+// BST<K, V, Compare> — generic ordered map, no STL required
+// ============================================================================
+// binary_tree.h only stores int keys with set semantics. This is the same
+// tree as a key → value map:
+//
+//   insertOrAssign()  O(log n) — new key inserts, existing key overwrites
+//   find()            O(log n) — pointer to the value, or nullptr
+//   remove()          O(log n)
+//   forEach()         O(n)     — visits pairs in key order
+//
+// Values are MOVED into the tree, never copied, so V can be a move-only
+// type (e.g. a record that owns a buffer). Compare is any functor with
+// bool operator()(const K&, const K&) meaning "a comes before b".
+//
+// Only <stddef.h> is used, so it builds with avr-gcc (no <utility>,
+// no std::move — bstMove() below does the same cast).
+// ============================================================================
+
+#include <stddef.h>
+
+template <typename T> struct BstRemoveRef      { typedef T type; };
+template <typename T> struct BstRemoveRef<T&>  { typedef T type; };
+template <typename T> struct BstRemoveRef<T&&> { typedef T type; };
+
+// Equivalent of std::move
+template <typename T>
+inline typename BstRemoveRef<T>::type&& bstMove(T&& value) {
+  return static_cast<typename BstRemoveRef<T>::type&&>(value);
+}
+
+// Default ordering: operator<
+template <typename K>
+struct BstLess {
+  bool operator()(const K& a, const K& b) const { return a < b; }
+};
+
+template <typename K, typename V, typename Compare = BstLess<K> >
+class BST {
+public:
+  explicit BST(Compare compare = Compare()) : root_(nullptr), size_(0), less_(compare) {}
+  ~BST() { clear(); }
+
+  // Owns its nodes: movable, not copyable
+  BST(const BST&) = delete;
+  BST& operator=(const BST&) = delete;
+  BST(BST&& other) : root_(other.root_), size_(other.size_), less_(other.less_) {
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  // Insert or overwrite — returns true if the key was new
+  bool insertOrAssign(const K& key, V&& value) {
+    Node** link = findLink(key);
+    if (*link) {
+      (*link)->value = bstMove(value);
+      return false;
+    }
+    *link = new Node{ key, bstMove(value), nullptr, nullptr };
+    size_++;
+    return true;
+  }
+
+  // Lookup — pointer to the stored value, or nullptr if not found
+  V* find(const K& key) {
+    Node* node = *findLink(key);
+    return node ? &node->value : nullptr;
+  }
+
+  const V* find(const K& key) const {
+    return const_cast<BST*>(this)->find(key);
+  }
+
+  bool contains(const K& key) const { return find(key) != nullptr; }
+
+  // Remove a key — returns false if it was not present
+  bool remove(const K& key) {
+    Node** link = findLink(key);
+    Node* node = *link;
+    if (!node) return false;
+
+    if (node->left && node->right) {
+      // Two children: move the in-order successor's pair into this node,
+      // then unlink the successor (it has no left child)
+      Node** succLink = &node->right;
+      while ((*succLink)->left) succLink = &(*succLink)->left;
+      Node* succ = *succLink;
+      node->key = bstMove(succ->key);
+      node->value = bstMove(succ->value);
+      *succLink = succ->right;
+      delete succ;
+    } else {
+      *link = node->left ? node->left : node->right;
+      delete node;
+    }
+    size_--;
+    return true;
+  }
+
+  // Call fn(key, value) for every pair in key order
+  template <typename Fn>
+  void forEach(Fn fn) const { visit(root_, fn); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    freeNodes(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+private:
+  struct Node {
+    K key;
+    V value;
+    Node* left;
+    Node* right;
+  };
+
+  Node* root_;
+  size_t size_;
+  Compare less_;
+
+  // Walk to the link that holds key (or where it would be inserted).
+  // Returning Node** lets insert and remove rewrite the parent's pointer
+  // without recursion or a separate parent variable.
+  Node** findLink(const K& key) {
+    Node** link = &root_;
+    while (*link) {
+      if (less_(key, (*link)->key))      link = &(*link)->left;
+      else if (less_((*link)->key, key)) link = &(*link)->right;
+      else break;
+    }
+    return link;
+  }
+
+  template <typename Fn>
+  static void visit(const Node* node, Fn& fn) {
+    if (!node) return;
+    visit(node->left, fn);
+    fn(node->key, node->value);
+    visit(node->right, fn);
+  }
+
+  static void freeNodes(Node* node) {
+    if (!node) return;
+    freeNodes(node->left);
+    freeNodes(node->right);
+    delete node;
+  }
+};
+
+#endif // BST_MAP_H
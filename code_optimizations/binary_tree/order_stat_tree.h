@@ -0,0 +1,223 @@
+#ifndef ORDER_STAT_TREE_H
+#define ORDER_STAT_TREE_H
+
+#include <stddef.h>
+
+// ============================================================================
+// Order-Statistics Tree — streaming percentiles without sorting
+// ============================================================================
+// A BST where every node also knows how many samples live in its subtree.
+// That one extra field turns "what is the 95th percentile?" from a sort
+// into a single walk down the tree:
+//
+//   statInsert()  O(log n)* — duplicates allowed (counted per node)
+//   statRemove()  O(log n)* — removes ONE occurrence of a value
+//   rank()        O(log n)  — how many samples are < value
+//   select()      O(log n)  — k-th smallest sample (0-based)
+//   percentile()  O(log n)  — nearest-rank p-th percentile
+//
+//   * amortized: a subtree whose child holds more than 3/4 of its nodes is
+//     rebuilt balanced (same midpoint trick as buildBalanced()), so slowly
+//     drifting sensor values can't degrade the tree into a list.
+//
+// SlidingWindow keeps the last N samples: a ring of raw values in arrival
+// order plus the tree. Each push evicts the oldest sample once full.
+// ============================================================================
+
+struct StatNode {
+  int value;
+  size_t count;  // samples equal to value
+  size_t size;   // samples in this subtree (counts duplicates)
+  size_t nodes;  // distinct nodes in this subtree (drives rebalancing)
+  StatNode* left;
+  StatNode* right;
+};
+
+inline size_t statSize(StatNode* root)  { return root ? root->size : 0; }
+inline size_t statNodes(StatNode* root) { return root ? root->nodes : 0; }
+
+// Recompute size/nodes from the children — call after relinking
+inline void statUpdate(StatNode* root) {
+  root->size  = root->count + statSize(root->left) + statSize(root->right);
+  root->nodes = 1 + statNodes(root->left) + statNodes(root->right);
+}
+
+// ---- Partial rebuilding ------------------------------------------------
+
+inline size_t statCollect(StatNode* root, StatNode** out, size_t count) {
+  if (!root) return count;
+  count = statCollect(root->left, out, count);
+  out[count++] = root;
+  return statCollect(root->right, out, count);
+}
+
+inline StatNode* statLink(StatNode** nodes, size_t lo, size_t hi) {
+  if (lo >= hi) return nullptr;
+  size_t mid = lo + (hi - lo) / 2;
+  StatNode* node = nodes[mid];
+  node->left  = statLink(nodes, lo, mid);
+  node->right = statLink(nodes, mid + 1, hi);
+  statUpdate(node);
+  return node;
+}
+
+// Rebuild root's subtree perfectly balanced if either child is too heavy
+inline StatNode* statRebalance(StatNode* root) {
+  size_t limit = root->nodes * 3;
+  if (statNodes(root->left) * 4 <= limit && statNodes(root->right) * 4 <= limit) return root;
+
+  size_t n = root->nodes;
+  StatNode** nodes = new StatNode*[n];
+  statCollect(root, nodes, 0);
+  root = statLink(nodes, 0, n);
+  delete[] nodes;
+  return root;
+}
+
+// ---- Updates -----------------------------------------------------------
+
+// Insert one sample — O(log n) amortized
+inline StatNode* statInsert(StatNode* root, int value) {
+  if (!root) return new StatNode{ value, 1, 1, 1, nullptr, nullptr };
+  if (value == root->value) {
+    root->count++;
+    root->size++;
+    return root;
+  }
+  if (value < root->value)
+    root->left  = statInsert(root->left,  value);
+  else
+    root->right = statInsert(root->right, value);
+  statUpdate(root);
+  return statRebalance(root);
+}
+
+// Unlink the minimum node of root's subtree into minNode
+inline StatNode* statDetachMin(StatNode* root, StatNode*& minNode) {
+  if (!root->left) {
+    minNode = root;
+    return root->right;
+  }
+  root->left = statDetachMin(root->left, minNode);
+  statUpdate(root);
+  return root;
+}
+
+// Remove one occurrence of value (no-op if absent) — O(log n) amortized
+inline StatNode* statRemove(StatNode* root, int value) {
+  if (!root) return nullptr;
+  if (value < root->value) {
+    root->left  = statRemove(root->left,  value);
+  } else if (value > root->value) {
+    root->right = statRemove(root->right, value);
+  } else if (root->count > 1) {
+    root->count--;
+    root->size--;
+    return root;
+  } else {
+    // Last occurrence — unlink the node
+    StatNode* left  = root->left;
+    StatNode* right = root->right;
+    delete root;
+    if (!left)  return right;
+    if (!right) return left;
+    // Two children: the in-order successor takes this node's place
+    StatNode* successor;
+    right = statDetachMin(right, successor);
+    successor->left  = left;
+    successor->right = right;
+    root = successor;
+  }
+  statUpdate(root);
+  return statRebalance(root);
+}
+
+inline void freeStatTree(StatNode* root) {
+  if (!root) return;
+  freeStatTree(root->left);
+  freeStatTree(root->right);
+  delete root;
+}
+
+// ---- Queries -----------------------------------------------------------
+
+// Number of samples strictly less than value
+inline size_t rank(StatNode* root, int value) {
+  size_t below = 0;
+  while (root) {
+    if (value <= root->value) {
+      root = root->left;
+    } else {
+      below += statSize(root->left) + root->count;
+      root = root->right;
+    }
+  }
+  return below;
+}
+
+// k-th smallest sample, 0-based. Requires k < statSize(root).
+inline int select(StatNode* root, size_t k) {
+  while (root) {
+    size_t leftSize = statSize(root->left);
+    if (k < leftSize) {
+      root = root->left;
+    } else if (k < leftSize + root->count) {
+      return root->value;
+    } else {
+      k -= leftSize + root->count;
+      root = root->right;
+    }
+  }
+  return 0;  // k out of range
+}
+
+// Nearest-rank percentile (pct in 0..100). Requires a non-empty tree.
+inline int percentile(StatNode* root, unsigned pct) {
+  size_t n = statSize(root);
+  size_t k = (pct * n + 99) / 100;  // ceil(pct/100 * n)
+  return select(root, k ? k - 1 : 0);
+}
+
+// ---- Sliding window ----------------------------------------------------
+
+struct SlidingWindow {
+  StatNode* root;
+  int* samples;     // ring of raw samples, oldest at 'oldest'
+  size_t capacity;
+  size_t oldest;
+  size_t count;
+};
+
+// samples must hold capacity ints (static array on the MCU)
+inline void windowInit(SlidingWindow& w, int* samples, size_t capacity) {
+  w.root = nullptr;
+  w.samples = samples;
+  w.capacity = capacity;
+  w.oldest = 0;
+  w.count = 0;
+}
+
+// Add a sample, evicting the oldest one when the window is full
+inline void windowPush(SlidingWindow& w, int value) {
+  if (w.count == w.capacity) {
+    w.root = statRemove(w.root, w.samples[w.oldest]);
+    w.samples[w.oldest] = value;
+    w.oldest = (w.oldest + 1) % w.capacity;
+  } else {
+    w.samples[(w.oldest + w.count) % w.capacity] = value;
+    w.count++;
+  }
+  w.root = statInsert(w.root, value);
+}
+
+inline int windowPercentile(SlidingWindow& w, unsigned pct) {
+  return percentile(w.root, pct);
+}
+
+inline void windowFree(SlidingWindow& w) {
+  freeStatTree(w.root);
+  w.root = nullptr;
+  w.count = 0;
+}
+
+#endif // ORDER_STAT_TREE_H
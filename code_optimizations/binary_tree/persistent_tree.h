@@ -0,0 +1,232 @@
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+// ============================================================================
+// Persistent (copy-on-write) BST — lock-free readers, one writer at a time
+// ============================================================================
+// HOST ONLY: needs <atomic>, <mutex> and <vector>. The sketch does not
+// include this file, so arduino-cli never compiles it.
+//
+// binary_tree.h mutates nodes in place, so a reader walking the tree while
+// another thread inserts can see half-linked nodes. Here nodes are never
+// modified after they are published:
+//
+//   insert()/remove()  copy the O(log n) nodes on the search path, share
+//                      every untouched subtree, then swap in the new root
+//                      with one atomic store.
+//   ReadGuard          pins the current epoch and loads the root. That root
+//                      is a consistent snapshot for as long as the guard
+//                      lives — no locks, no retries.
+//
+// Memory reclamation (epoch-based):
+//   Each update retires the path nodes it replaced, tagged with the current
+//   global epoch E, then advances the epoch. A reader announces the epoch it
+//   saw before loading the root, so a reader announcing > E can only see the
+//   new root. Nodes retired at E are freed once every active reader has
+//   announced an epoch > E (or is idle).
+// ============================================================================
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct PNode {
+  int value;
+  const PNode* left;
+  const PNode* right;
+};
+
+// ---- Read-side helpers (work on any snapshot root) ---------------------
+
+inline bool search(const PNode* root, int value) {
+  while (root) {
+    if (value == root->value) return true;
+    root = value < root->value ? root->left : root->right;
+  }
+  return false;
+}
+
+inline const PNode* lowerBound(const PNode* root, int key) {
+  const PNode* best = nullptr;
+  while (root) {
+    if (root->value >= key) { best = root; root = root->left; }
+    else                    { root = root->right; }
+  }
+  return best;
+}
+
+class PersistentTree {
+public:
+  static constexpr int MAX_READERS = 64;
+
+  PersistentTree() = default;
+  PersistentTree(const PersistentTree&) = delete;
+  PersistentTree& operator=(const PersistentTree&) = delete;
+
+  // Caller must guarantee no readers or writers are still running
+  ~PersistentTree() {
+    freeTree(root_.load(std::memory_order_relaxed));
+    for (const Retired& r : retired_) delete r.node;
+  }
+
+  // Claim a reader slot — once per reader thread. Returns -1 when all
+  // MAX_READERS are taken; unregisterReader() frees a slot for reuse.
+  int registerReader() {
+    for (int i = 0; i < MAX_READERS; i++) {
+      bool free = false;
+      if (slots_[i].taken.compare_exchange_strong(free, true)) return i;
+    }
+    return -1;
+  }
+
+  // Give a slot back — no ReadGuard may still be using it
+  void unregisterReader(int slot) {
+    if (slot < 0 || slot >= MAX_READERS) return;
+    assert(slots_[slot].epoch.load() == IDLE && "reader slot released while a guard uses it");
+    slots_[slot].taken.store(false, std::memory_order_release);
+  }
+
+  // RAII snapshot: the root stays valid until the guard is destroyed.
+  // `slot` must come from registerReader(); an invalid one (-1 when full)
+  // asserts, and in release builds the guard holds the writer lock instead —
+  // still a valid snapshot, but it blocks writers (so don't write under it).
+  class ReadGuard {
+  public:
+    ReadGuard(PersistentTree& tree, int slot) : tree_(tree), slot_(slot) {
+      assert(slot >= 0 && slot < MAX_READERS && "ReadGuard needs a registered reader slot");
+      if (slot_ < 0 || slot_ >= MAX_READERS) {
+        slot_ = -1;
+        tree_.writer_.lock();
+        root_ = tree_.root_.load();
+        return;
+      }
+      // Announce the epoch BEFORE loading the root (seq_cst on both)
+      tree_.slots_[slot_].epoch.store(tree_.epoch_.load());
+      root_ = tree_.root_.load();
+    }
+    ~ReadGuard() {
+      if (slot_ < 0) tree_.writer_.unlock();
+      else tree_.slots_[slot_].epoch.store(IDLE, std::memory_order_release);
+    }
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    const PNode* root() const { return root_; }
+
+  private:
+    PersistentTree& tree_;
+    int slot_;
+    const PNode* root_;
+  };
+
+  // Insert — O(log n) new nodes; returns false if already present
+  bool insert(int value) {
+    std::lock_guard<std::mutex> lock(writer_);
+    const PNode* old = root_.load(std::memory_order_relaxed);
+    if (search(old, value)) return false;
+    publish(insertCopy(old, value));
+    return true;
+  }
+
+  // Remove — O(log n) new nodes; returns false if absent
+  bool remove(int value) {
+    std::lock_guard<std::mutex> lock(writer_);
+    const PNode* old = root_.load(std::memory_order_relaxed);
+    if (!search(old, value)) return false;
+    publish(removeCopy(old, value));
+    return true;
+  }
+
+  // Nodes waiting for readers to move on (for monitoring/benchmarks)
+  size_t retiredCount() const { return retired_.size(); }
+
+private:
+  static constexpr uint64_t IDLE = UINT64_MAX;
+
+  struct alignas(64) Slot {  // one cache line each: no false sharing
+    std::atomic<uint64_t> epoch{ IDLE };
+    std::atomic<bool> taken{ false };  // handed out by registerReader()
+  };
+
+  struct Retired {
+    uint64_t epoch;
+    const PNode* node;
+  };
+
+  std::atomic<const PNode*> root_{ nullptr };
+  std::atomic<uint64_t> epoch_{ 1 };
+  Slot slots_[MAX_READERS];
+  std::mutex writer_;                 // serializes writers only
+  std::vector<Retired> retired_;      // guarded by writer_
+  std::vector<const PNode*> pending_; // path nodes replaced by this update
+
+  static void freeTree(const PNode* root) {
+    if (!root) return;
+    freeTree(root->left);
+    freeTree(root->right);
+    delete root;
+  }
+
+  // Copy of node with new children; the original is retired
+  const PNode* copyWith(const PNode* node, const PNode* left, const PNode* right) {
+    pending_.push_back(node);
+    return new PNode{ node->value, left, right };
+  }
+
+  const PNode* insertCopy(const PNode* root, int value) {
+    if (!root) return new PNode{ value, nullptr, nullptr };
+    if (value < root->value) return copyWith(root, insertCopy(root->left, value), root->right);
+    return copyWith(root, root->left, insertCopy(root->right, value));
+  }
+
+  // Copy of root's subtree without its minimum; min is reported via out
+  const PNode* removeMinCopy(const PNode* root, const PNode*& minNode) {
+    if (!root->left) {
+      minNode = root;
+      pending_.push_back(root);
+      return root->right;
+    }
+    return copyWith(root, removeMinCopy(root->left, minNode), root->right);
+  }
+
+  const PNode* removeCopy(const PNode* root, int value) {
+    if (value < root->value) return copyWith(root, removeCopy(root->left, value), root->right);
+    if (value > root->value) return copyWith(root, root->left, removeCopy(root->right, value));
+    pending_.push_back(root);
+    if (!root->left) return root->right;
+    if (!root->right) return root->left;
+    // Two children: the in-order successor moves up into a fresh node
+    const PNode* successor;
+    const PNode* right = removeMinCopy(root->right, successor);
+    return new PNode{ successor->value, root->left, right };
+  }
+
+  // Swap in the new root, retire the replaced path, free what is safe
+  void publish(const PNode* newRoot) {
+    root_.store(newRoot);
+    uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+    for (const PNode* node : pending_) retired_.push_back(Retired{ epoch, node });
+    pending_.clear();
+    epoch_.store(epoch + 1);
+    reclaim();
+  }
+
+  void reclaim() {
+    uint64_t oldest = IDLE;
+    for (const Slot& slot : slots_) {
+      uint64_t e = slot.epoch.load();
+      if (e < oldest) oldest = e;
+    }
+    // Everything retired before the oldest announced epoch is unreachable
+    size_t kept = 0;
+    for (const Retired& r : retired_) {
+      if (r.epoch < oldest) delete r.node;
+      else retired_[kept++] = r;
+    }
+    retired_.resize(kept);
+  }
+};
+
+#endif // PERSISTENT_TREE_H
@@ -8,23 +8,46 @@
 //  hash_table/    — key-value lookup, O(1) average
 //  ring_buffer/   — circular FIFO, O(1) always, no heap alloc
 //
-// Quick comparison:
+// Each sketch keeps its data structure in a plain header (no Arduino.h)
+// so bench/ can build and time it on the host:  make bench
 //
-//  Structure     | Access | Search | Insert | Delete | Memory
-//  --------------|--------|--------|--------|--------|-------
-//  Array         | O(1)   | O(n)   | O(n)   | O(n)   | static
-//  Linked List   | O(n)   | O(n)   | O(1)*  | O(1)*  | heap
-//  Binary Tree   | O(n)   | O(logn)| O(logn)| O(logn)| heap
-//  Hash Table    | O(1)** | O(1)** | O(1)** | O(1)** | heap
-//  Ring Buffer   | O(1)   | O(n)   | O(1)   | O(1)   | static
+// alloc_track/alloc_track.h counts every new/delete per call site;
+// sketches that use it end with a heapReport(). Tracking is opt-in:
+//   make compile SKETCH=code_optimizations/linked_list ALLOC_TRACK=1
 //
-//  * O(1) only at front/back; finding position is still O(n)
-//  ** average case; O(n) worst case on hash collisions
+// fuzz/diff_fuzz checks every structure against a std:: model on random
+// operation sequences and flags ops/sec regressions:  make fuzz
+//
+// Measured, not guessed — ns per operation at n = 1,000 → 100,000 keys.
+// From bench/structures_bench on an x86-64 host (Release); it also writes
+// structures.csv with every workload, allocations/op and peak RSS.
+//
+//  Structure     | Insert      | Search        | Delete        | Iterate | Allocs
+//  --------------|-------------|---------------|---------------|---------|-------
+//  Linked List   | 34 → 41     | 1.0K → 262K   | 560 → 287K    | 3 → 5   | 1/insert
+//  Binary Tree   | 129 → 476   | 49 → 369      | 112 → 487     | 4 → 28  | 1/insert
+//  Skip List     | 152 → 781   | 101 → 840     | 117 → 871     | 3 → 118 | 1/insert
+//  Hash Table    | 272 → 10K*  | 268 → 148K    | 161 → 141K    | 2 → 43  | 1/insert
+//  Ring Buffer   | 4 → 6       | 120 → 142     | 6 → 7         | 3 → 2   | none
+//
+//  Insert = random order. Already-sorted input turns the BST into a list:
+//    3.9K ns/insert at 1K keys, 37K at 7K keys (skip list: 131 → 202).
+//  Hash table: only 16 buckets, so past a few hundred keys every chain is
+//    long — it behaves like 16 linked lists. Size TABLE_SIZE to the data.
+//  Ring buffer search scans at most 64 bytes, so it never grows.
+//  Iterate at 100K is all cache misses: nodes inserted in random order
+//    are scattered, so every hop is a trip to DRAM.
+//  * measurement stopped at its time budget before reaching 100,000 keys
 //
 // For embedded (tight RAM, no OS):
 //   → Prefer Ring Buffer and arrays (no heap, no fragmentation)
 //   → Use Hash Table / Linked List only on ESP32/Teensy+ (>32KB RAM)
+//     (or back the list with a NodePool — linked_list/node_pool.h)
 //   → BST is great for config/lookup tables built at startup
+//   → Repeated reads of slow sensors? LRU cache with TTL
+//     (ring_buffer/lru_cache.h) — fixed size, no heap, O(1) get/put
+//   → Sorted data arriving in order? Skip list (linked_list/skip_list.h)
+//     stays O(log n) where the BST degrades to a list
 // ============================================================
 
 void setup() {
@@ -0,0 +1,639 @@
+// ============================================================================
+// Differential fuzzer + throughput baseline for the data structure sketches
+// ============================================================================
+// Every target decodes the same byte string into a sequence of operations
+// and runs it twice: once against the sketch structure and once against a
+// std:: reference model. Any difference in an observable result (return
+// values, sizes, iteration order) aborts with the target and op index.
+//
+//   target      structure                     model
+//   list        LinkedList (heap nodes)       std::deque<int>
+//   list+pool   LinkedList on a NodePool<32>  std::deque<int>, capacity 32
+//   bst         TreeNode* + RangeIterator     std::set<int>
+//   skip        SkipList<int>                 std::set<int>
+//   hash        HashTable                     std::map<key index, int>
+//   ring        RingBuffer                    std::deque<char>, capacity 64
+//
+// Input format: 3 bytes per op — an opcode byte and a 16-bit argument.
+// Trailing bytes that don't form a whole op are ignored.
+//
+// Two ways to run it:
+//
+//   libFuzzer   configure with -DDIFF_FUZZ_LIBFUZZER=ON (clang) to build
+//               diff_fuzz_libfuzzer; it feeds every input to all targets.
+//
+//   standalone  diff_fuzz [options] [input files...]
+//     --seeds N          random inputs per target (default 2000)
+//     --len BYTES        bytes per input (default 3000, i.e. 1000 ops)
+//     --seed S           first seed (default 1)
+//     --baseline FILE    ops/sec per target (default diff_fuzz_baseline.csv)
+//     --threshold PCT    allowed throughput drop (default 15)
+//     --update-baseline  overwrite FILE with this run's numbers
+//   Input files (e.g. libFuzzer crash artifacts) are replayed and checked;
+//   no timing is done in that mode.
+//
+// After checking, standalone mode replays the same ops against the sketch
+// structure alone (no model, best of 5) and reports ops/sec. With no
+// baseline file yet, the numbers are written as the baseline. Exit codes:
+// 0 ok, 2 throughput regression; a mismatch abort()s so sanitizers and
+// libFuzzer catch it too.
+// ============================================================================
+
+#include "bench/bench.h"
+#include "binary_tree/binary_tree.h"
+#include "hash_table/hash_table.h"
+#include "linked_list/linked_list.h"
+#include "linked_list/node_pool.h"
+#include "linked_list/skip_list.h"
+#include "ring_buffer/ring_buffer.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// ---- Input decoding ----
+
+struct Op {
+  uint8_t code;
+  uint16_t arg;
+};
+
+static std::vector<Op> decodeOps(const uint8_t* data, size_t size) {
+  std::vector<Op> ops;
+  ops.reserve(size / 3);
+  for (size_t i = 0; i + 3 <= size; i += 3) {
+    ops.push_back(Op{ data[i], static_cast<uint16_t>(data[i + 1] | (data[i + 2] << 8)) });
+  }
+  return ops;
+}
+
+// ---- Failure reporting ----
+
+static const char* g_target = "";
+static size_t g_opIndex = 0;
+static uint64_t g_seed = 0;  // 0 when replaying a file or under libFuzzer
+
+static void diffFail(const char* what, long long got, long long want) {
+  std::fprintf(stderr, "MISMATCH in %s at op %zu: %s — structure %lld, model %lld\n",
+               g_target, g_opIndex, what, got, want);
+  if (g_seed) std::fprintf(stderr, "reproduce: diff_fuzz --seed %llu --seeds 1\n",
+                           static_cast<unsigned long long>(g_seed));
+  std::abort();
+}
+
+#define DIFF_EQ(what, got, want)                                                   \
+  do {                                                                             \
+    long long got_ = static_cast<long long>(got);                                  \
+    long long want_ = static_cast<long long>(want);                                \
+    if (got_ != want_) diffFail(what, got_, want_);                                \
+  } while (0)
+
+// ---- Targets ----
+// Each target has:
+//   check(op)  apply op to structure and model, compare results
+//   run(op)    apply op to the structure only (timed pass)
+//   verify()   compare full contents; called every kVerifyEvery ops and at the end
+
+const size_t kVerifyEvery = 32;
+
+// Small value ranges so inserts, lookups and removes keep colliding
+inline int listValue(uint16_t arg) { return arg & 255; }
+inline int treeValue(uint16_t arg) { return arg & 1023; }
+
+template <typename Nodes>
+struct ListTargetBase {
+  LinkedList list;
+  Nodes nodes;
+  std::deque<int> model;
+  size_t capacity = SIZE_MAX;
+  long long sink = 0;
+
+  ~ListTargetBase() { freeList(list, nodes); }
+
+  void check(const Op& op) {
+    int v = listValue(op.arg);
+    bool room = model.size() < capacity;
+    switch (op.code % 5) {
+      case 0:
+        DIFF_EQ("prepend", prepend(list, nodes, v), room);
+        if (room) model.push_front(v);
+        break;
+      case 1:
+        DIFF_EQ("append", append(list, nodes, v), room);
+        if (room) model.push_back(v);
+        break;
+      case 2: {
+        int want = model.empty() ? -1 : model.front();
+        DIFF_EQ("dequeue", dequeue(list, nodes), want);
+        if (!model.empty()) model.pop_front();
+        break;
+      }
+      case 3: {
+        auto it = std::find(model.begin(), model.end(), v);
+        DIFF_EQ("removeValue", removeValue(list, nodes, v), it != model.end());
+        if (it != model.end()) model.erase(it);
+        break;
+      }
+      default: {
+        bool want = std::find(model.begin(), model.end(), v) != model.end();
+        DIFF_EQ("search", search(list, v), want);
+        break;
+      }
+    }
+    DIFF_EQ("count", list.count, model.size());
+    DIFF_EQ("isEmpty", isEmpty(list), model.empty());
+  }
+
+  void run(const Op& op) {
+    int v = listValue(op.arg);
+    switch (op.code % 5) {
+      case 0: sink += prepend(list, nodes, v); break;
+      case 1: sink += append(list, nodes, v); break;
+      case 2: sink += dequeue(list, nodes); break;
+      case 3: sink += removeValue(list, nodes, v); break;
+      default: sink += search(list, v); break;
+    }
+  }
+
+  void verify() {
+    size_t i = 0;
+    ListNode* last = nullptr;
+    for (ListNode* cur = list.head; cur; last = cur, cur = cur->next, i++) {
+      if (i >= model.size()) diffFail("list longer than model", static_cast<long long>(i), model.size());
+      DIFF_EQ("element", cur->value, model[i]);
+    }
+    DIFF_EQ("walked length", i, model.size());
+    DIFF_EQ("tail is last node", list.tail == last, 1);
+  }
+};
+
+struct ListTarget : ListTargetBase<HeapNodes> {
+  static const char* name() { return "list"; }
+};
+
+struct PooledListTarget : ListTargetBase<NodePool<ListNode, 32> > {
+  static const char* name() { return "list+pool"; }
+  PooledListTarget() { capacity = 32; }
+  void verify() {
+    ListTargetBase<NodePool<ListNode, 32> >::verify();
+    DIFF_EQ("pool used", nodes.used(), model.size());
+  }
+};
+
+struct TreeTarget {
+  static const char* name() { return "bst"; }
+  TreeNode* root = nullptr;
+  std::set<int> model;
+  long long sink = 0;
+
+  ~TreeTarget() { freeTree(root); }
+
+  // [lo, lo + len) where lo = low 10 bits and len = high 6 bits of arg
+  static int rangeLo(uint16_t arg) { return arg & 1023; }
+  static int rangeHi(uint16_t arg) { return (arg & 1023) + (arg >> 10); }
+
+  void checkRange(int lo, int hi) {
+    RangeIterator it;
+    rangeBegin(it, root, lo, hi);
+    auto want = model.lower_bound(lo);
+    int v;
+    while (rangeNext(it, v)) {
+      if (want == model.end() || *want >= hi) diffFail("range yielded extra value", v, hi);
+      DIFF_EQ("range value", v, *want);
+      ++want;
+    }
+    DIFF_EQ("range stopped early", want == model.end() || *want >= hi, 1);
+  }
+
+  void check(const Op& op) {
+    int v = treeValue(op.arg);
+    switch (op.code % 5) {
+      case 0:
+      case 1:
+        root = insert(root, v);
+        model.insert(v);
+        break;
+      case 2:
+        root = remove(root, v);
+        model.erase(v);
+        break;
+      case 3:
+        DIFF_EQ("search", search(root, v), model.count(v));
+        break;
+      default:
+        checkRange(rangeLo(op.arg), rangeHi(op.arg));
+        break;
+    }
+  }
+
+  void run(const Op& op) {
+    int v = treeValue(op.arg);
+    switch (op.code % 5) {
+      case 0:
+      case 1: root = insert(root, v); break;
+      case 2: root = remove(root, v); break;
+      case 3: sink += search(root, v); break;
+      default: {
+        RangeIterator it;
+        rangeBegin(it, root, rangeLo(op.arg), rangeHi(op.arg));
+        int out;
+        while (rangeNext(it, out)) sink += out;
+        break;
+      }
+    }
+  }
+
+  void verify() {
+    DIFF_EQ("countNodes", countNodes(root), model.size());
+    checkRange(INT_MIN, INT_MAX);
+  }
+};
+
+struct SkipTarget {
+  static const char* name() { return "skip"; }
+  SkipList<int> skip;
+  std::set<int> model;
+  long long sink = 0;
+
+  void check(const Op& op) {
+    int v = treeValue(op.arg);
+    switch (op.code % 5) {
+      case 0:
+      case 1:
+        DIFF_EQ("insert", skip.insert(v), model.insert(v).second);
+        break;
+      case 2:
+        DIFF_EQ("remove", skip.remove(v), model.erase(v));
+        break;
+      case 3:
+        DIFF_EQ("contains", skip.contains(v), model.count(v));
+        break;
+      default: {
+        int lo = TreeTarget::rangeLo(op.arg);
+        int hi = TreeTarget::rangeHi(op.arg);
+        SkipList<int>::Range r = skip.range(lo, hi);
+        auto want = model.lower_bound(lo);
+        int out;
+        while (r.next(out)) {
+          if (want == model.end() || *want >= hi) diffFail("range yielded extra value", out, hi);
+          DIFF_EQ("range value", out, *want);
+          ++want;
+        }
+        DIFF_EQ("range stopped early", want == model.end() || *want >= hi, 1);
+        break;
+      }
+    }
+    DIFF_EQ("size", skip.size(), model.size());
+  }
+
+  void run(const Op& op) {
+    int v = treeValue(op.arg);
+    switch (op.code % 5) {
+      case 0:
+      case 1: sink += skip.insert(v); break;
+      case 2: sink += skip.remove(v); break;
+      case 3: sink += skip.contains(v); break;
+      default: {
+        SkipList<int>::Range r = skip.range(TreeTarget::rangeLo(op.arg), TreeTarget::rangeHi(op.arg));
+        int out;
+        while (r.next(out)) sink += out;
+        break;
+      }
+    }
+  }
+
+  void verify() {
+    auto want = model.begin();
+    skip.forEach([&](int v) {
+      if (want == model.end()) diffFail("forEach yielded extra value", v, 0);
+      DIFF_EQ("forEach value", v, *want);
+      ++want;
+    });
+    DIFF_EQ("forEach stopped early", want == model.end(), 1);
+  }
+};
+
+struct HashTarget {
+  static const char* name() { return "hash"; }
+  // The table stores key pointers, so keys live here for the whole run.
+  // 96 keys over 16 buckets: every chain holds several entries.
+  static const int kKeys = 96;
+  char keys[kKeys][8];
+  HashTable table;
+  std::map<int, int> model;
+  long long sink = 0;
+
+  HashTarget() {
+    for (int i = 0; i < kKeys; i++) std::snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+  }
+  ~HashTarget() { freeTable(table); }
+
+  void check(const Op& op) {
+    int k = (op.arg & 255) % kKeys;
+    int v = op.arg >> 8;
+    // Look up through a copy so matches go by content, not by pointer
+    char probe[8];
+    std::memcpy(probe, keys[k], sizeof(probe));
+    switch (op.code % 4) {
+      case 0:
+      case 1:
+        set(table, keys[k], v);
+        model[k] = v;
+        break;
+      case 2:
+        DIFF_EQ("removeKey", removeKey(table, probe), model.erase(k));
+        break;
+      default: {
+        int* got = get(table, probe);
+        auto want = model.find(k);
+        DIFF_EQ("get found", got != nullptr, want != model.end());
+        if (got) DIFF_EQ("get value", *got, want->second);
+        break;
+      }
+    }
+  }
+
+  void run(const Op& op) {
+    int k = (op.arg & 255) % kKeys;
+    switch (op.code % 4) {
+      case 0:
+      case 1: set(table, keys[k], op.arg >> 8); break;
+      case 2: sink += removeKey(table, keys[k]); break;
+      default: {
+        int* got = get(table, keys[k]);
+        sink += got ? *got : -1;
+        break;
+      }
+    }
+  }
+
+  void verify() {
+    size_t entries = 0;
+    for (int i = 0; i < TABLE_SIZE; i++) {
+      for (Entry* e = table.buckets[i]; e; e = e->next, entries++) {
+        DIFF_EQ("entry in its hash bucket", hashKey(e->key), i);
+        int k = std::atoi(e->key + 1);
+        auto want = model.find(k);
+        if (want == model.end()) diffFail("entry missing from model", k, -1);
+        DIFF_EQ("entry value", e->value, want->second);
+      }
+    }
+    DIFF_EQ("entries", entries, model.size());
+  }
+};
+
+struct RingTarget {
+  static const char* name() { return "ring"; }
+  RingBuffer rb;
+  std::deque<char> model;
+  long long sink = 0;
+
+  void check(const Op& op) {
+    char c = static_cast<char>(op.arg);
+    // Pushes outnumber pops 2:1 so the buffer regularly fills and wraps
+    switch (op.code % 4) {
+      case 0:
+      case 1: {
+        bool room = model.size() < static_cast<size_t>(BUF_SIZE);
+        DIFF_EQ("push", push(rb, c), room);
+        if (room) model.push_back(c);
+        break;
+      }
+      case 2: {
+        char out = 0;
+        bool got = pop(rb, out);
+        DIFF_EQ("pop", got, !model.empty());
+        if (got) {
+          DIFF_EQ("pop value", out, model.front());
+          model.pop_front();
+        }
+        break;
+      }
+      default:
+        DIFF_EQ("isEmpty", isEmpty(rb), model.empty());
+        break;
+    }
+    DIFF_EQ("count", rb.count, model.size());
+  }
+
+  void run(const Op& op) {
+    char out;
+    switch (op.code % 4) {
+      case 0:
+      case 1: sink += push(rb, static_cast<char>(op.arg)); break;
+      case 2: sink += pop(rb, out) ? out : 0; break;
+      default: sink += isEmpty(rb); break;
+    }
+  }
+
+  void verify() {
+    for (size_t i = 0; i < model.size(); i++) {
+      DIFF_EQ("buffered byte", rb.data[(rb.tail + i) % BUF_SIZE], model[i]);
+    }
+  }
+};
+
+// ---- Drivers ----
+
+template <typename Target>
+static void checkOps(const std::vector<Op>& ops) {
+  g_target = Target::name();
+  Target t;
+  for (g_opIndex = 0; g_opIndex < ops.size(); g_opIndex++) {
+    t.check(ops[g_opIndex]);
+    if (g_opIndex % kVerifyEvery == kVerifyEvery - 1) t.verify();
+  }
+  t.verify();
+}
+
+static void checkAll(const uint8_t* data, size_t size) {
+  std::vector<Op> ops = decodeOps(data, size);
+  checkOps<ListTarget>(ops);
+  checkOps<PooledListTarget>(ops);
+  checkOps<TreeTarget>(ops);
+  checkOps<SkipTarget>(ops);
+  checkOps<HashTarget>(ops);
+  checkOps<RingTarget>(ops);
+}
+
+#ifdef DIFF_FUZZ_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  checkAll(data, size);
+  return 0;
+}
+
+#else
+
+struct Options {
+  size_t seeds = 2000;
+  size_t len = 3000;
+  uint64_t firstSeed = 1;
+  std::string baseline = "diff_fuzz_baseline.csv";
+  double thresholdPct = 15.0;
+  bool updateBaseline = false;
+  std::vector<std::string> files;
+};
+
+static std::vector<uint8_t> randomInput(uint64_t seed, size_t len) {
+  bench::Rng rng(seed * 0x9E3779B97F4A7C15ull);
+  std::vector<uint8_t> bytes(len);
+  for (uint8_t& b : bytes) b = static_cast<uint8_t>(rng.next() >> 56);
+  return bytes;
+}
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+  FILE* f = std::fopen(path.c_str(), "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  std::fclose(f);
+  return true;
+}
+
+// Replay every input on the structure alone; best of 5 → ops/sec
+template <typename Target>
+static double opsPerSec(const std::vector<std::vector<Op> >& inputs) {
+  size_t total = 0;
+  for (const std::vector<Op>& ops : inputs) total += ops.size();
+  uint64_t best = UINT64_MAX;
+  for (int rep = 0; rep < 5; rep++) {
+    long long sink = 0;
+    uint64_t t0 = bench::nowNs();
+    for (const std::vector<Op>& ops : inputs) {
+      Target t;
+      for (const Op& op : ops) t.run(op);
+      sink += t.sink;
+    }
+    uint64_t elapsed = bench::nowNs() - t0;
+    bench::doNotOptimize(sink);
+    if (elapsed < best) best = elapsed;
+  }
+  return best ? static_cast<double>(total) * 1e9 / static_cast<double>(best) : 0.0;
+}
+
+struct Result {
+  std::string target;
+  double opsPerSec;
+};
+
+static std::map<std::string, double> loadBaseline(const std::string& path) {
+  std::map<std::string, double> rows;
+  FILE* f = std::fopen(path.c_str(), "r");
+  if (!f) return rows;
+  char line[256];
+  while (std::fgets(line, sizeof(line), f)) {
+    char name[64];
+    double value;
+    if (std::sscanf(line, "%63[^,],%lf", name, &value) == 2) rows[name] = value;
+  }
+  std::fclose(f);
+  return rows;
+}
+
+static bool saveBaseline(const std::string& path, const std::vector<Result>& results) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (!f) return false;
+  std::fprintf(f, "target,ops_per_sec\n");
+  for (const Result& r : results) std::fprintf(f, "%s,%.0f\n", r.target.c_str(), r.opsPerSec);
+  std::fclose(f);
+  return true;
+}
+
+static bool parseArgs(int argc, char** argv, Options& opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--seeds" && hasValue)          opt.seeds = std::strtoull(argv[++i], nullptr, 10);
+    else if (arg == "--len" && hasValue)       opt.len = std::strtoull(argv[++i], nullptr, 10);
+    else if (arg == "--seed" && hasValue)      opt.firstSeed = std::strtoull(argv[++i], nullptr, 10);
+    else if (arg == "--baseline" && hasValue)  opt.baseline = argv[++i];
+    else if (arg == "--threshold" && hasValue) opt.thresholdPct = std::strtod(argv[++i], nullptr);
+    else if (arg == "--update-baseline")       opt.updateBaseline = true;
+    else if (arg.compare(0, 2, "--") == 0)     return false;
+    else                                       opt.files.push_back(arg);
+  }
+  return opt.firstSeed != 0;
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    std::fprintf(stderr, "usage: %s [--seeds N] [--len BYTES] [--seed S] [--baseline FILE]\n"
+                         "          [--threshold PCT] [--update-baseline] [input files...]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // Replay mode: check the given inputs, no timing
+  if (!opt.files.empty()) {
+    for (const std::string& path : opt.files) {
+      std::vector<uint8_t> bytes;
+      if (!readFile(path, bytes)) {
+        std::fprintf(stderr, "cannot read %s\n", path.c_str());
+        return EXIT_FAILURE;
+      }
+      checkAll(bytes.data(), bytes.size());
+      std::printf("%s: %zu bytes, all targets match\n", path.c_str(), bytes.size());
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // Seeded mode: check every input against the models...
+  std::vector<std::vector<Op> > inputs;
+  inputs.reserve(opt.seeds);
+  for (size_t i = 0; i < opt.seeds; i++) {
+    g_seed = opt.firstSeed + i;
+    std::vector<uint8_t> bytes = randomInput(g_seed, opt.len);
+    checkAll(bytes.data(), bytes.size());
+    inputs.push_back(decodeOps(bytes.data(), bytes.size()));
+  }
+  g_seed = 0;
+  std::printf("%zu seeded inputs x %zu ops: all targets match their models\n\n",
+              opt.seeds, opt.len / 3);
+
+  // ...then time the same ops on the structures alone
+  std::vector<Result> results;
+  results.push_back(Result{ ListTarget::name(), opsPerSec<ListTarget>(inputs) });
+  results.push_back(Result{ PooledListTarget::name(), opsPerSec<PooledListTarget>(inputs) });
+  results.push_back(Result{ TreeTarget::name(), opsPerSec<TreeTarget>(inputs) });
+  results.push_back(Result{ SkipTarget::name(), opsPerSec<SkipTarget>(inputs) });
+  results.push_back(Result{ HashTarget::name(), opsPerSec<HashTarget>(inputs) });
+  results.push_back(Result{ RingTarget::name(), opsPerSec<RingTarget>(inputs) });
+
+  std::map<std::string, double> baseline = loadBaseline(opt.baseline);
+  bool regressed = false;
+  std::printf("%-10s %14s %14s %8s\n", "target", "ops/sec", "baseline", "change");
+  for (const Result& r : results) {
+    auto it = baseline.find(r.target);
+    if (it == baseline.end() || it->second <= 0) {
+      std::printf("%-10s %14.0f %14s %8s\n", r.target.c_str(), r.opsPerSec, "-", "-");
+      continue;
+    }
+    double change = (r.opsPerSec / it->second - 1.0) * 100.0;
+    bool slow = change < -opt.thresholdPct;
+    regressed = regressed || slow;
+    std::printf("%-10s %14.0f %14.0f %+7.1f%%%s\n", r.target.c_str(), r.opsPerSec, it->second,
+                change, slow ? "  REGRESSION" : "");
+  }
+
+  if (baseline.empty() || opt.updateBaseline) {
+    if (!saveBaseline(opt.baseline, results)) {
+      std::fprintf(stderr, "cannot write %s\n", opt.baseline.c_str());
+      return EXIT_FAILURE;
+    }
+    std::printf("\nbaseline written to %s\n", opt.baseline.c_str());
+  } else if (regressed) {
+    std::printf("\nthroughput dropped more than %.1f%% below %s\n", opt.thresholdPct,
+                opt.baseline.c_str());
+    return 2;
+  }
+  return EXIT_SUCCESS;
+}
+
+#endif // DIFF_FUZZ_LIBFUZZER
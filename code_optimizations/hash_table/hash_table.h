@@ -0,0 +1,93 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include <string.h>
+
+// ============================================================================
+// Hash Table (with chaining) — core operations (no Arduino dependencies)
+// ============================================================================
+// Shared by hash_table.ino and the host benchmarks in ../bench/.
+// Anything that prints lives in the sketch, not here.
+//
+// Keys are NOT copied: the table stores the const char* it was given, so
+// the string must outlive its entry (string literals always do).
+// ============================================================================
+
+const int TABLE_SIZE = 16;  // must be power of 2 for fast modulo
+
+struct Entry {
+  const char* key;
+  int value;
+  Entry* next;  // chaining: multiple entries per bucket
+};
+
+struct HashTable {
+  Entry* buckets[TABLE_SIZE] = { nullptr };
+};
+
+// djb2 hash — fast, good distribution for small tables
+inline unsigned int hashKey(const char* key) {
+  unsigned int hash = 5381;
+  while (*key) hash = ((hash << 5) + hash) + (unsigned char)*key++;
+  return hash % TABLE_SIZE;
+}
+
+// Insert or update — O(1) average
+inline void set(HashTable& table, const char* key, int value) {
+  unsigned int idx = hashKey(key);
+  Entry* cur = table.buckets[idx];
+
+  // Update existing key
+  while (cur) {
+    if (strcmp(cur->key, key) == 0) { cur->value = value; return; }
+    cur = cur->next;
+  }
+
+  // New entry — insert at front of chain
+  Entry* entry = new Entry{ key, value, table.buckets[idx] };
+  table.buckets[idx] = entry;
+}
+
+// Lookup — O(1) average
+// Returns pointer to value, or nullptr if not found
+inline int* get(HashTable& table, const char* key) {
+  unsigned int idx = hashKey(key);
+  Entry* cur = table.buckets[idx];
+  while (cur) {
+    if (strcmp(cur->key, key) == 0) return &cur->value;
+    cur = cur->next;
+  }
+  return nullptr;
+}
+
+// Remove a key — O(1) average
+inline bool removeKey(HashTable& table, const char* key) {
+  unsigned int idx = hashKey(key);
+  Entry* cur  = table.buckets[idx];
+  Entry* prev = nullptr;
+  while (cur) {
+    if (strcmp(cur->key, key) == 0) {
+      if (prev) prev->next = cur->next;
+      else       table.buckets[idx] = cur->next;
+      delete cur;
+      return true;
+    }
+    prev = cur;
+    cur  = cur->next;
+  }
+  return false;
+}
+
+inline void freeTable(HashTable& table) {
+  for (int i = 0; i < TABLE_SIZE; i++) {
+    Entry* cur = table.buckets[i];
+    while (cur) {
+      Entry* next = cur->next;
+      delete cur;
+      cur = next;
+    }
+    table.buckets[i] = nullptr;
+  }
+}
+
+#endif // HASH_TABLE_H
@@ -12,70 +12,20 @@
 //             keys are unknown at design time on tiny MCUs
 // ============================================================
 
-const int TABLE_SIZE = 16;  // must be power of 2 for fast modulo
-
-struct Entry {
-  const char* key;
-  int value;
-  Entry* next;  // chaining: multiple entries per bucket
-};
-
-struct HashTable {
-  Entry* buckets[TABLE_SIZE] = { nullptr };
+#include "hash_table.h"  // Entry, HashTable, set(), get(), removeKey()
+#if defined(ALLOC_TRACK)
+#include <alloc_track.h>  // heapReport() — counts every new/delete
+#else
+// Tracking is opt-in (make compile SKETCH=... ALLOC_TRACK=1): without it
+// the core's own new/delete run and these calls count nothing
+struct AllocStats {};
+inline AllocStats allocStats() { return AllocStats(); }
+inline long allocsSince(const AllocStats&) { return -1; }  // -1 = not counted
+struct AllocScope {
+  explicit AllocScope(const char*) {}
 };
-
-// djb2 hash — fast, good distribution for small tables
-unsigned int hashKey(const char* key) {
-  unsigned int hash = 5381;
-  while (*key) hash = ((hash << 5) + hash) + (unsigned char)*key++;
-  return hash % TABLE_SIZE;
-}
-
-// Insert or update — O(1) average
-void set(HashTable& table, const char* key, int value) {
-  unsigned int idx = hashKey(key);
-  Entry* cur = table.buckets[idx];
-
-  // Update existing key
-  while (cur) {
-    if (strcmp(cur->key, key) == 0) { cur->value = value; return; }
-    cur = cur->next;
-  }
-
-  // New entry — insert at front of chain
-  Entry* entry = new Entry{ key, value, table.buckets[idx] };
-  table.buckets[idx] = entry;
-}
-
-// Lookup — O(1) average
-// Returns pointer to value, or nullptr if not found
-int* get(HashTable& table, const char* key) {
-  unsigned int idx = hashKey(key);
-  Entry* cur = table.buckets[idx];
-  while (cur) {
-    if (strcmp(cur->key, key) == 0) return &cur->value;
-    cur = cur->next;
-  }
-  return nullptr;
-}
-
-// Remove a key — O(1) average
-bool removeKey(HashTable& table, const char* key) {
-  unsigned int idx = hashKey(key);
-  Entry* cur  = table.buckets[idx];
-  Entry* prev = nullptr;
-  while (cur) {
-    if (strcmp(cur->key, key) == 0) {
-      if (prev) prev->next = cur->next;
-      else       table.buckets[idx] = cur->next;
-      delete cur;
-      return true;
-    }
-    prev = cur;
-    cur  = cur->next;
-  }
-  return false;
-}
+inline void heapReport(Print& out) { out.println(F("heap: not tracked (build with ALLOC_TRACK=1)")); }
+#endif
 
 // Print all entries (unordered — hash tables don't preserve order!)
 void printTable(HashTable& table) {
@@ -93,18 +43,6 @@ void printTable(HashTable& table) {
   }
 }
 
-void freeTable(HashTable& table) {
-  for (int i = 0; i < TABLE_SIZE; i++) {
-    Entry* cur = table.buckets[i];
-    while (cur) {
-      Entry* next = cur->next;
-      delete cur;
-      cur = next;
-    }
-    table.buckets[i] = nullptr;
-  }
-}
-
 // ---
 
 void setup() {
@@ -112,11 +50,14 @@ void setup() {
 
   HashTable config;
 
-  // O(1) — set sensor config values by name
-  set(config, "temp_pin",    A0);
-  set(config, "pressure_pin", A1);
-  set(config, "threshold",   75);
-  set(config, "sample_rate", 100);
+  // O(1) — set sensor config values by name (one new Entry each)
+  {
+    AllocScope scope("config");
+    set(config, "temp_pin",    A0);
+    set(config, "pressure_pin", A1);
+    set(config, "threshold",   75);
+    set(config, "sample_rate", 100);
+  }
 
   // O(1) — lookup directly by name, no looping needed!
   int* pin = get(config, "temp_pin");
@@ -127,8 +68,11 @@ void setup() {
   Serial.print("sample_rate = ");
   Serial.println(rate ? *rate : -1);  // 100
 
-  // O(1) — update existing key
+  // O(1) — update existing key, no allocation
+  AllocStats before = allocStats();
   set(config, "threshold", 80);
+  Serial.print("Allocations for an update: ");
+  Serial.println(allocsSince(before));  // 0
   int* thresh = get(config, "threshold");
   Serial.print("threshold (updated) = ");
   Serial.println(thresh ? *thresh : -1);  // 80
@@ -142,6 +86,7 @@ void setup() {
   printTable(config);
 
   freeTable(config);
+  heapReport(Serial);  // config: 4 allocs, 0 B live
 }
 
 void loop() {}
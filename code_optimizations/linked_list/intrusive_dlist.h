@@ -0,0 +1,129 @@
+#ifndef INTRUSIVE_DLIST_H
+#define INTRUSIVE_DLIST_H
+
+#include <stddef.h>
+
+// ============================================================================
+// Doubly Linked Intrusive List — O(1) removal when you hold the element
+// ============================================================================
+// removeValue() on a singly linked list is O(n): it has to find the node,
+// then find the node BEFORE it. With a prev pointer in every element, and
+// the caller holding the element itself (the "handle"), unlinking is just
+// rewiring two neighbours:
+//
+//   pushFront()/pushBack()/popFront()  O(1)
+//   remove(item)                       O(1) — cancel a timer, finish a task
+//   moveToFront(item)                  O(1) — LRU "touch"
+//   splice(other)                      O(1) — append a whole list, no copying
+//
+// Like IntrusiveList, the link lives inside the caller's struct, so nothing
+// is allocated and the list never owns its elements:
+//
+//   struct Timer {
+//     unsigned long deadline;
+//     DListHook<Timer> hook;
+//   };
+//   IntrusiveDList<Timer, &Timer::hook> active;
+//   active.pushBack(&blinkTimer);
+//   active.remove(&blinkTimer);   // O(1), no search
+// ============================================================================
+
+template <typename T>
+struct DListHook {
+  T* prev = nullptr;
+  T* next = nullptr;
+};
+
+template <typename T, DListHook<T> T::*Hook>
+class IntrusiveDList {
+public:
+  bool empty() const { return head_ == nullptr; }
+  size_t size() const { return count_; }
+  T* front() const { return head_; }
+  T* back() const { return tail_; }
+
+  static T* next(T* item) { return (item->*Hook).next; }
+  static T* prev(T* item) { return (item->*Hook).prev; }
+
+  // Insert at FRONT — O(1)
+  void pushFront(T* item) {
+    DListHook<T>& h = item->*Hook;
+    h.prev = nullptr;
+    h.next = head_;
+    if (head_) (head_->*Hook).prev = item;
+    else       tail_ = item;
+    head_ = item;
+    count_++;
+  }
+
+  // Insert at END — O(1)
+  void pushBack(T* item) {
+    DListHook<T>& h = item->*Hook;
+    h.next = nullptr;
+    h.prev = tail_;
+    if (tail_) (tail_->*Hook).next = item;
+    else       head_ = item;
+    tail_ = item;
+    count_++;
+  }
+
+  // Insert item right after pos (already in this list) — O(1)
+  void insertAfter(T* pos, T* item) {
+    DListHook<T>& p = pos->*Hook;
+    DListHook<T>& h = item->*Hook;
+    h.prev = pos;
+    h.next = p.next;
+    if (p.next) (p.next->*Hook).prev = item;
+    else        tail_ = item;
+    p.next = item;
+    count_++;
+  }
+
+  // Unlink item (must be in this list) — O(1), no search
+  void remove(T* item) {
+    DListHook<T>& h = item->*Hook;
+    if (h.prev) (h.prev->*Hook).next = h.next;
+    else        head_ = h.next;
+    if (h.next) (h.next->*Hook).prev = h.prev;
+    else        tail_ = h.prev;
+    h.prev = nullptr;
+    h.next = nullptr;
+    count_--;
+  }
+
+  // Remove from FRONT — O(1), nullptr when empty
+  T* popFront() {
+    T* item = head_;
+    if (item) remove(item);
+    return item;
+  }
+
+  // Move an element already in the list to the front — O(1)
+  void moveToFront(T* item) {
+    if (item == head_) return;
+    remove(item);
+    pushFront(item);
+  }
+
+  // Move every element of other to the end of this list — O(1)
+  void splice(IntrusiveDList& other) {
+    if (other.empty() || &other == this) return;
+    if (tail_) {
+      (tail_->*Hook).next = other.head_;
+      (other.head_->*Hook).prev = tail_;
+    } else {
+      head_ = other.head_;
+    }
+    tail_ = other.tail_;
+    count_ += other.count_;
+    other.head_ = other.tail_ = nullptr;
+    other.count_ = 0;
+  }
+
+private:
+  T* head_ = nullptr;
+  T* tail_ = nullptr;
+  size_t count_ = 0;
+};
+
+#endif // INTRUSIVE_DLIST_H
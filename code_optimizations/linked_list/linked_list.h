@@ -0,0 +1,238 @@
+#ifndef LINKED_LIST_H
+#define LINKED_LIST_H
+
+#include <stddef.h>
+
+// ============================================================================
+// Singly Linked List — core operations (no Arduino dependencies)
+// ============================================================================
+// Shared by linked_list.ino and the host benchmarks in ../bench/.
+//
+// Three flavours, from simplest to cheapest:
+//   ListNode* head + free functions  — the classic version, append() is O(n)
+//   LinkedList { head, tail }        — O(1) append/prepend/dequeue
+//   IntrusiveList<T, &T::hook>       — O(1), and no allocation at all: the
+//                                      link lives inside the caller's struct
+// ============================================================================
+
+struct ListNode {
+  int value;
+  ListNode* next;
+};
+
+// Insert at FRONT — O(1)
+inline void prepend(ListNode*& head, int value) {
+  ListNode* newNode = new ListNode{ value, head };
+  head = newNode;
+}
+
+// Insert at END — O(n)
+inline void append(ListNode*& head, int value) {
+  ListNode* newNode = new ListNode{ value, nullptr };
+  if (head == nullptr) { head = newNode; return; }
+  ListNode* cur = head;
+  while (cur->next) cur = cur->next;
+  cur->next = newNode;
+}
+
+// Remove from FRONT and return value — O(1)
+inline int dequeue(ListNode*& head) {
+  if (!head) return -1;
+  int val = head->value;
+  ListNode* old = head;
+  head = head->next;
+  delete old;
+  return val;
+}
+
+// Remove a specific value — O(n)
+inline bool removeValue(ListNode*& head, int value) {
+  if (!head) return false;
+  if (head->value == value) { dequeue(head); return true; }
+  ListNode* cur = head;
+  while (cur->next) {
+    if (cur->next->value == value) {
+      ListNode* toDelete = cur->next;
+      cur->next = toDelete->next;
+      delete toDelete;
+      return true;
+    }
+    cur = cur->next;
+  }
+  return false;
+}
+
+// Search — O(n)
+inline bool search(ListNode* head, int value) {
+  while (head) {
+    if (head->value == value) return true;
+    head = head->next;
+  }
+  return false;
+}
+
+inline void freeList(ListNode*& head) {
+  while (head) dequeue(head);
+}
+
+// ---- Head + tail list --------------------------------------------------
+// Remembering the last node makes append() O(1): no walk to the end.
+// Same function names as above, so switching is just a type change.
+//
+// Where nodes come from is a parameter: every operation has a version
+// taking a node source with alloc()/release(). HeapNodes uses new/delete;
+// NodePool (node_pool.h) hands out slots from a static array, so a list
+// running on a pool never touches the heap. Without a source argument the
+// heap is used.
+
+struct LinkedList {
+  ListNode* head = nullptr;
+  ListNode* tail = nullptr;
+  size_t count = 0;
+};
+
+struct HeapNodes {
+  ListNode* alloc() { return new ListNode; }
+  void release(ListNode* node) { delete node; }
+};
+
+// Insert at FRONT — O(1). False if the node source is exhausted.
+template <typename Nodes>
+inline bool prepend(LinkedList& list, Nodes& nodes, int value) {
+  ListNode* newNode = nodes.alloc();
+  if (!newNode) return false;
+  newNode->value = value;
+  newNode->next = list.head;
+  list.head = newNode;
+  if (!list.tail) list.tail = newNode;
+  list.count++;
+  return true;
+}
+
+// Insert at END — O(1) thanks to the tail pointer
+template <typename Nodes>
+inline bool append(LinkedList& list, Nodes& nodes, int value) {
+  ListNode* newNode = nodes.alloc();
+  if (!newNode) return false;
+  newNode->value = value;
+  newNode->next = nullptr;
+  if (list.tail) list.tail->next = newNode;
+  else           list.head = newNode;
+  list.tail = newNode;
+  list.count++;
+  return true;
+}
+
+// Remove from FRONT and return value — O(1)
+template <typename Nodes>
+inline int dequeue(LinkedList& list, Nodes& nodes) {
+  if (!list.head) return -1;
+  ListNode* old = list.head;
+  int val = old->value;
+  list.head = old->next;
+  if (!list.head) list.tail = nullptr;  // list is now empty
+  nodes.release(old);
+  list.count--;
+  return val;
+}
+
+// Remove a specific value — O(n)
+template <typename Nodes>
+inline bool removeValue(LinkedList& list, Nodes& nodes, int value) {
+  ListNode* prev = nullptr;
+  for (ListNode* cur = list.head; cur; prev = cur, cur = cur->next) {
+    if (cur->value != value) continue;
+    if (prev) prev->next = cur->next;
+    else      list.head = cur->next;
+    if (list.tail == cur) list.tail = prev;
+    nodes.release(cur);
+    list.count--;
+    return true;
+  }
+  return false;
+}
+
+template <typename Nodes>
+inline void freeList(LinkedList& list, Nodes& nodes) {
+  while (list.head) dequeue(list, nodes);
+}
+
+// Heap-backed shorthands
+inline void prepend(LinkedList& list, int value) { HeapNodes heap; prepend(list, heap, value); }
+inline void append(LinkedList& list, int value)  { HeapNodes heap; append(list, heap, value); }
+inline int dequeue(LinkedList& list)             { HeapNodes heap; return dequeue(list, heap); }
+inline bool removeValue(LinkedList& list, int value) {
+  HeapNodes heap;
+  return removeValue(list, heap, value);
+}
+inline void freeList(LinkedList& list) { HeapNodes heap; freeList(list, heap); }
+
+inline bool search(const LinkedList& list, int value) { return search(list.head, value); }
+
+inline bool isEmpty(const LinkedList& list) { return list.head == nullptr; }
+
+// ---- Intrusive list ----------------------------------------------------
+// The caller embeds the link in its own struct, so enqueueing an object
+// never allocates — the object IS the node:
+//
+//   struct Task {
+//     void (*run)();
+//     ListHook<Task> hook;
+//   };
+//   IntrusiveList<Task, &Task::hook> ready;
+//   ready.pushBack(&task);
+//
+// One object can sit in several lists at once by embedding one hook per
+// list. An object must not be in the same list twice. The list does not
+// own its elements — it never calls new or delete.
+
+template <typename T>
+struct ListHook {
+  T* next = nullptr;
+};
+
+template <typename T, ListHook<T> T::*Hook>
+class IntrusiveList {
+public:
+  bool empty() const { return head_ == nullptr; }
+  size_t size() const { return count_; }
+  T* front() const { return head_; }
+  T* back() const { return tail_; }
+
+  static T* next(T* item) { return (item->*Hook).next; }
+
+  // Insert at FRONT — O(1)
+  void pushFront(T* item) {
+    (item->*Hook).next = head_;
+    head_ = item;
+    if (!tail_) tail_ = item;
+    count_++;
+  }
+
+  // Insert at END — O(1)
+  void pushBack(T* item) {
+    (item->*Hook).next = nullptr;
+    if (tail_) (tail_->*Hook).next = item;
+    else       head_ = item;
+    tail_ = item;
+    count_++;
+  }
+
+  // Remove from FRONT — O(1), nullptr when empty
+  T* popFront() {
+    T* item = head_;
+    if (!item) return nullptr;
+    head_ = (item->*Hook).next;
+    if (!head_) tail_ = nullptr;
+    (item->*Hook).next = nullptr;
+    count_--;
+    return item;
+  }
+
+private:
+  T* head_ = nullptr;
+  T* tail_ = nullptr;
+  size_t count_ = 0;
+};
+
+#endif // LINKED_LIST_H
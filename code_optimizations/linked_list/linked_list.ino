@@ -3,72 +3,52 @@
 // ============================================================
 // Operations:
 //   append()   O(n) — walk to end, then insert
+//              O(1) with LinkedList, which also tracks the tail
 //   prepend()  O(1) — insert at front instantly
 //   dequeue()  O(1) — remove from front instantly
 //   search()   O(n) — must traverse
+//              O(log n) with SkipList, which keeps values sorted
 //   remove()   O(n) — must find the node first
+//              O(1) with IntrusiveDList when you hold the element
+//
+// Tight RAM? Run LinkedList on a NodePool: same O(1) queue, no heap.
 //
 // Best for: dynamic queues, task lists, unknown item counts
 // Avoid when: you need random access by index (use array instead)
 // ============================================================
 
-struct Node {
-  int value;
-  Node* next;
+#include "linked_list.h"      // ListNode, LinkedList, IntrusiveList
+#include "unrolled_list.h"    // UnrolledList — many values per node
+#include "node_pool.h"        // NodePool — fixed node storage, no heap
+#include "intrusive_dlist.h"  // IntrusiveDList — O(1) remove by handle
+#include "skip_list.h"        // SkipList — sorted, O(log n) search
+#if defined(ALLOC_TRACK)
+#include <alloc_track.h>  // heapReport() — counts every new/delete
+#else
+// Tracking is opt-in (make compile SKETCH=... ALLOC_TRACK=1): without it
+// the core's own new/delete run and these calls count nothing
+struct AllocStats {};
+inline AllocStats allocStats() { return AllocStats(); }
+inline long allocsSince(const AllocStats&) { return -1; }  // -1 = not counted
+struct AllocScope {
+  explicit AllocScope(const char*) {}
 };
+inline void heapReport(Print& out) { out.println(F("heap: not tracked (build with ALLOC_TRACK=1)")); }
+#endif
 
-// Insert at FRONT — O(1)
-void prepend(Node*& head, int value) {
-  Node* newNode = new Node{ value, head };
-  head = newNode;
-}
-
-// Insert at END — O(n)
-void append(Node*& head, int value) {
-  Node* newNode = new Node{ value, nullptr };
-  if (head == nullptr) { head = newNode; return; }
-  Node* cur = head;
-  while (cur->next) cur = cur->next;
-  cur->next = newNode;
-}
-
-// Remove from FRONT and return value — O(1)
-int dequeue(Node*& head) {
-  if (!head) return -1;
-  int val = head->value;
-  Node* old = head;
-  head = head->next;
-  delete old;
-  return val;
-}
-
-// Remove a specific value — O(n)
-bool removeValue(Node*& head, int value) {
-  if (!head) return false;
-  if (head->value == value) { dequeue(head); return true; }
-  Node* cur = head;
-  while (cur->next) {
-    if (cur->next->value == value) {
-      Node* toDelete = cur->next;
-      cur->next = toDelete->next;
-      delete toDelete;
-      return true;
-    }
-    cur = cur->next;
-  }
-  return false;
-}
+// A task that can sit in an IntrusiveList without any extra allocation
+struct Task {
+  int id;
+  ListHook<Task> hook;
+};
 
-// Search — O(n)
-bool search(Node* head, int value) {
-  while (head) {
-    if (head->value == value) return true;
-    head = head->next;
-  }
-  return false;
-}
+// A software timer the caller keeps a handle to, so cancelling is O(1)
+struct Timer {
+  unsigned long deadline;
+  DListHook<Timer> hook;
+};
 
-void printList(Node* head) {
+void printList(ListNode* head) {
   while (head) {
     Serial.print(head->value);
     Serial.print(" -> ");
@@ -77,16 +57,12 @@ void printList(Node* head) {
   Serial.println("NULL");
 }
 
-void freeList(Node*& head) {
-  while (head) dequeue(head);
-}
-
 // ---
 
 void setup() {
   Serial.begin(115200);
 
-  Node* list = nullptr;
+  ListNode* list = nullptr;
 
   // O(1) — insert at front
   prepend(list, 10);
@@ -116,6 +92,95 @@ void setup() {
   Serial.println(search(list, 99) ? "found" : "not found");
 
   freeList(list);
+
+  // O(1) queue — LinkedList remembers its tail, so append() never walks
+  LinkedList queue;
+  for (int i = 1; i <= 5; i++) append(queue, i * 10);
+  Serial.print("Queue:                  ");
+  printList(queue.head);  // 10 -> 20 -> 30 -> 40 -> 50 -> NULL
+  Serial.print("Dequeued: ");
+  Serial.println(dequeue(queue));  // 10
+  freeList(queue);
+
+  // Intrusive list — tasks carry their own link, nothing is allocated
+  static Task tasks[] = { { 1, {} }, { 2, {} }, { 3, {} } };
+  IntrusiveList<Task, &Task::hook> ready;
+  for (Task& t : tasks) ready.pushBack(&t);
+  Serial.print("Ready tasks: ");
+  while (Task* t = ready.popFront()) {
+    Serial.print(t->id);
+    Serial.print(" ");
+  }
+  Serial.println();  // 1 2 3
+
+  // Unrolled list — 30 ints per 64-byte chunk on AVR, one pointer per chunk
+  UnrolledList samples;
+  for (int i = 0; i < 100; i++) append(samples, i);
+  removeValue(samples, 42);
+  Serial.print("Unrolled: ");
+  Serial.print((int)samples.count);
+  Serial.print(" values, search 42: ");
+  Serial.println(search(samples, 42) ? "found" : "not found");  // 99, not found
+  freeList(samples);
+
+  // Pool-backed queue — 4 nodes reserved at compile time, zero new/delete
+  static NodePool<ListNode, 4> pool;
+  LinkedList pooled;
+  AllocStats before = allocStats();
+  for (int i = 1; i <= 5; i++) {
+    if (!append(pooled, pool, i)) {
+      Serial.print("Pool exhausted at item ");
+      Serial.println(i);  // 5
+    }
+  }
+  dequeue(pooled, pool);
+  Serial.print("Pool in use: ");
+  Serial.print((int)pool.used());      // 3
+  Serial.print("  peak: ");
+  Serial.print((int)pool.peak());      // 4
+  Serial.print("  failures: ");
+  Serial.println((int)pool.failures());  // 1
+  freeList(pooled, pool);
+  Serial.print("Heap allocations by the pooled queue: ");
+  Serial.println(allocsSince(before));  // 0 — proven, not assumed
+
+  // Doubly linked intrusive list — cancel a timer without searching
+  static Timer blink = { 500, {} }, debounce = { 20, {} }, report = { 1000, {} };
+  IntrusiveDList<Timer, &Timer::hook> timers;
+  timers.pushBack(&blink);
+  timers.pushBack(&debounce);
+  timers.pushBack(&report);
+  timers.remove(&debounce);     // O(1) — we hold the handle
+  timers.moveToFront(&report);  // O(1)
+  Serial.print("Timers: ");
+  for (Timer* t = timers.front(); t; t = timers.next(t)) {
+    Serial.print(t->deadline);
+    Serial.print(" ");
+  }
+  Serial.println();  // 1000 500
+
+  // Skip list — sorted even when fed sorted input; fixed seed = same shape every boot
+  SkipList<int> sorted;
+  {
+    AllocScope scope("skip list");
+    for (int i = 0; i < 50; i++) sorted.insert(i * 3);
+  }
+  Serial.print("Skip list search 42: ");
+  Serial.println(sorted.contains(42) ? "found" : "not found");  // found
+  Serial.print("Range [10, 25): ");
+  SkipList<int>::Range range = sorted.range(10, 25);
+  int v;
+  while (range.next(v)) {
+    Serial.print(v);
+    Serial.print(" ");
+  }
+  Serial.println();  // 12 15 18 21 24
+  Serial.print("Levels: ");
+  Serial.print(sorted.level());
+  Serial.print("  node bytes: ");
+  Serial.println((int)sorted.memoryBytes());
+
+  heapReport(Serial);  // the skip list is still live here
 }
 
 void loop() {}
@@ -0,0 +1,203 @@
+#ifndef LOCKFREE_LIST_H
+#define LOCKFREE_LIST_H
+
+// ============================================================================
+// Lock-free stack (Treiber) and queue (Michael-Scott) — multi-producer,
+// multi-consumer, no mutex
+// ============================================================================
+// HOST ONLY: needs <atomic>. The sketch does not include this file.
+//
+//   LockFreeStack<N>   push()/pop()       — prepend()/dequeue() semantics
+//   LockFreeQueue<N>   enqueue()/dequeue() — append()/dequeue() semantics
+//
+// Both draw nodes from a TaggedPool of N nodes (same idea as NodePool, but
+// shared between threads): push/enqueue return false when it runs out.
+//
+// ABA protection — tagged pointers:
+//   A "pointer" is a 64-bit word: the low 32 bits hold node index + 1
+//   (0 = null) and the high 32 bits a tag that is bumped on every CAS.
+//   If a node is popped, recycled and pushed back between our load and our
+//   CAS, the index matches but the tag does not, so the CAS fails. The word
+//   fits a plain 64-bit CAS — no double-width cmpxchg16b needed.
+//
+// Memory reclamation — type-stable pool:
+//   Nodes are recycled through the pool's own lock-free free list and never
+//   returned to the heap while the container lives. A thread holding a
+//   stale index may read a recycled node, but that memory is always a valid
+//   node (all fields are atomics), and the tag check makes it discard what
+//   it read. This is the reclamation scheme from the original Michael-Scott
+//   paper.
+// ============================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Tagged pointer helpers: [tag:32 | index+1:32]
+inline uint32_t taggedIndex(uint64_t word) { return static_cast<uint32_t>(word); }
+inline uint32_t taggedTag(uint64_t word) { return static_cast<uint32_t>(word >> 32); }
+inline uint64_t makeTagged(uint32_t index, uint32_t tag) {
+  return (static_cast<uint64_t>(tag) << 32) | index;
+}
+
+const uint32_t TAGGED_NULL = 0;
+
+template <size_t N>
+class TaggedPool {
+public:
+  struct Node {
+    std::atomic<int> value;
+    std::atomic<uint64_t> next;  // tagged pointer
+  };
+
+  TaggedPool() {
+    // Chain every node into the free list: 1 → 2 → ... → N → null
+    for (uint32_t i = 1; i <= N; i++) {
+      node(i).value.store(0, std::memory_order_relaxed);
+      node(i).next.store(makeTagged(i < N ? i + 1 : TAGGED_NULL, 0), std::memory_order_relaxed);
+    }
+    free_.store(makeTagged(1, 0));
+  }
+
+  Node& node(uint32_t index) { return nodes_[index - 1]; }
+
+  // Pop a free node index, or TAGGED_NULL when exhausted — lock-free
+  uint32_t alloc() {
+    uint64_t head = free_.load();
+    while (taggedIndex(head) != TAGGED_NULL) {
+      uint64_t next = node(taggedIndex(head)).next.load();
+      if (free_.compare_exchange_weak(head, makeTagged(taggedIndex(next), taggedTag(head) + 1)))
+        return taggedIndex(head);
+    }
+    return TAGGED_NULL;
+  }
+
+  // Push a node back on the free list — lock-free
+  void release(uint32_t index) {
+    uint64_t head = free_.load();
+    do {
+      uint64_t old = node(index).next.load(std::memory_order_relaxed);
+      node(index).next.store(makeTagged(taggedIndex(head), taggedTag(old) + 1));
+    } while (!free_.compare_exchange_weak(head, makeTagged(index, taggedTag(head) + 1)));
+  }
+
+private:
+  Node nodes_[N];
+  alignas(64) std::atomic<uint64_t> free_;
+};
+
+// ---- Treiber stack -----------------------------------------------------
+
+template <size_t N>
+class LockFreeStack {
+public:
+  LockFreeStack() : head_(makeTagged(TAGGED_NULL, 0)) {}
+
+  // Insert at FRONT — false if the pool is exhausted
+  bool push(int value) {
+    uint32_t index = pool_.alloc();
+    if (index == TAGGED_NULL) return false;
+    typename TaggedPool<N>::Node& n = pool_.node(index);
+    n.value.store(value, std::memory_order_relaxed);
+
+    uint64_t head = head_.load();
+    do {
+      uint64_t old = n.next.load(std::memory_order_relaxed);
+      n.next.store(makeTagged(taggedIndex(head), taggedTag(old) + 1));
+    } while (!head_.compare_exchange_weak(head, makeTagged(index, taggedTag(head) + 1)));
+    return true;
+  }
+
+  // Remove from FRONT — false if empty
+  bool pop(int& out) {
+    uint64_t head = head_.load();
+    while (taggedIndex(head) != TAGGED_NULL) {
+      typename TaggedPool<N>::Node& n = pool_.node(taggedIndex(head));
+      uint64_t next = n.next.load();
+      if (head_.compare_exchange_weak(head, makeTagged(taggedIndex(next), taggedTag(head) + 1))) {
+        out = n.value.load(std::memory_order_relaxed);  // we own the node now
+        pool_.release(taggedIndex(head));
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  alignas(64) std::atomic<uint64_t> head_;
+  TaggedPool<N> pool_;
+};
+
+// ---- Michael-Scott queue -----------------------------------------------
+// head_ always points at a dummy node; the first real value lives in
+// head_->next. tail_ may lag one node behind — any thread that notices
+// helps swing it forward, so no thread ever waits on another.
+
+template <size_t N>
+class LockFreeQueue {
+public:
+  LockFreeQueue() {
+    uint32_t dummy = pool_.alloc();  // N >= 1, so this cannot fail
+    pool_.node(dummy).next.store(makeTagged(TAGGED_NULL, 0));
+    head_.store(makeTagged(dummy, 0));
+    tail_.store(makeTagged(dummy, 0));
+  }
+
+  // Insert at END — false if the pool is exhausted
+  bool enqueue(int value) {
+    uint32_t index = pool_.alloc();
+    if (index == TAGGED_NULL) return false;
+    typename TaggedPool<N>::Node& n = pool_.node(index);
+    n.value.store(value, std::memory_order_relaxed);
+    uint64_t old = n.next.load(std::memory_order_relaxed);
+    n.next.store(makeTagged(TAGGED_NULL, taggedTag(old) + 1));
+
+    uint64_t tail;
+    for (;;) {
+      tail = tail_.load();
+      uint64_t next = pool_.node(taggedIndex(tail)).next.load();
+      if (tail != tail_.load()) continue;  // tail moved under us
+      if (taggedIndex(next) == TAGGED_NULL) {
+        // Tail really is last — link the new node after it
+        if (pool_.node(taggedIndex(tail)).next.compare_exchange_weak(
+                next, makeTagged(index, taggedTag(next) + 1)))
+          break;
+      } else {
+        // Tail is lagging — help move it forward, then retry
+        tail_.compare_exchange_weak(tail, makeTagged(taggedIndex(next), taggedTag(tail) + 1));
+      }
+    }
+    // Swing tail to the new node (fine if another thread already did)
+    tail_.compare_exchange_strong(tail, makeTagged(index, taggedTag(tail) + 1));
+    return true;
+  }
+
+  // Remove from FRONT — false if empty
+  bool dequeue(int& out) {
+    for (;;) {
+      uint64_t head = head_.load();
+      uint64_t tail = tail_.load();
+      uint64_t next = pool_.node(taggedIndex(head)).next.load();
+      if (head != head_.load()) continue;
+      if (taggedIndex(head) == taggedIndex(tail)) {
+        if (taggedIndex(next) == TAGGED_NULL) return false;  // empty
+        tail_.compare_exchange_weak(tail, makeTagged(taggedIndex(next), taggedTag(tail) + 1));
+      } else {
+        // Read before the CAS: afterwards another dequeuer may recycle next
+        int value = pool_.node(taggedIndex(next)).value.load(std::memory_order_relaxed);
+        if (head_.compare_exchange_weak(head, makeTagged(taggedIndex(next), taggedTag(head) + 1))) {
+          out = value;
+          pool_.release(taggedIndex(head));  // old dummy; next is the new dummy
+          return true;
+        }
+      }
+    }
+  }
+
+private:
+  alignas(64) std::atomic<uint64_t> head_;
+  alignas(64) std::atomic<uint64_t> tail_;
+  TaggedPool<N> pool_;
+};
+
+#endif // LOCKFREE_LIST_H
@@ -0,0 +1,85 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stddef.h>
+
+// ============================================================================
+// NodePool<T, N> — fixed-capacity node allocator, no heap after init
+// ============================================================================
+// new/delete on a 2KB MCU fragments the heap until a small allocation fails
+// even though plenty of bytes are free. A pool reserves N nodes up front
+// (static storage, sized at compile time) and hands them out in O(1):
+//
+//   alloc()    O(1) — pop a slot off the free list, nullptr when exhausted
+//   release()  O(1) — push the slot back
+//
+// Free slots are chained through their own storage, so the bookkeeping
+// costs one pointer plus a few counters — not a bitmap, not a second array.
+//
+// T must be a plain struct (like ListNode): slots are handed out without
+// running a constructor, and the caller fills in every field.
+//
+//   static NodePool<ListNode, 32> pool;
+//   append(queue, pool, 42);   // false once all 32 nodes are in use
+// ============================================================================
+
+template <typename T, size_t N>
+class NodePool {
+public:
+  NodePool() : freeList_(nullptr), used_(0), peak_(0), failures_(0) {
+    for (size_t i = N; i > 0; i--) {
+      slots_[i - 1].nextFree = freeList_;
+      freeList_ = &slots_[i - 1];
+    }
+  }
+
+  // Take a node — O(1). Returns nullptr (and counts a failure) when empty.
+  T* alloc() {
+    if (!freeList_) {
+      failures_++;
+      return nullptr;
+    }
+    Slot* slot = freeList_;
+    freeList_ = slot->nextFree;
+    if (++used_ > peak_) peak_ = used_;
+    return &slot->node;
+  }
+
+  // Give a node back — O(1). node must have come from this pool.
+  void release(T* node) {
+    if (!node) return;
+    Slot* slot = reinterpret_cast<Slot*>(node);  // node is the union's first member
+    slot->nextFree = freeList_;
+    freeList_ = slot;
+    used_--;
+  }
+
+  bool owns(const T* node) const {
+    const Slot* slot = reinterpret_cast<const Slot*>(node);
+    return slot >= slots_ && slot < slots_ + N;
+  }
+
+  size_t capacity() const { return N; }
+  size_t used() const { return used_; }
+  size_t available() const { return N - used_; }
+  size_t peak() const { return peak_; }          // high-water mark
+  size_t failures() const { return failures_; }  // alloc() calls that found no slot
+  bool exhausted() const { return freeList_ == nullptr; }
+
+private:
+  union Slot {
+    T node;
+    Slot* nextFree;
+  };
+
+  Slot slots_[N];
+  Slot* freeList_;
+  size_t used_;
+  size_t peak_;
+  size_t failures_;
+
+  NodePool(const NodePool&);             // not copyable: the free list
+  NodePool& operator=(const NodePool&);  // points into this object
+};
+
+#endif // NODE_POOL_H
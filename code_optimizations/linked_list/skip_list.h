@@ -0,0 +1,230 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Skip List — sorted linked list with O(log n) search
+// ============================================================================
+// A sorted singly linked list where some nodes also carry "express lane"
+// links that skip ahead. A node's height is picked at random on insert:
+// height 1 always, each further level with probability 1/4. Searching
+// starts in the top lane and drops a lane whenever the next hop would
+// overshoot, so it visits O(log n) nodes on average — whatever the insert
+// order. (The BST degrades to a list on sorted input; this does not.)
+//
+//   insert()    O(log n) avg — set semantics, duplicates are ignored
+//   contains()  O(log n) avg
+//   remove()    O(log n) avg
+//   range()     O(log n) to find lo, then O(1) per value — [lo, hi)
+//
+// Memory: every node is ONE allocation holding its key and exactly as many
+// links as its height (1.33 links per node on average). MaxLevel caps the
+// height, so no node ever costs more than MaxLevel pointers. With p = 1/4,
+// MaxLevel levels stay efficient up to about 4^MaxLevel keys.
+//
+// Reproducible: heights come from a small xorshift generator seeded in the
+// constructor. The same seed and the same inserts give the same shape on
+// the MCU and on the host. Call seed() to restart the sequence.
+//
+//   SkipList<int> readings;
+//   readings.insert(42);
+//   SkipList<int>::Range r = readings.range(20, 60);
+//   int v;
+//   while (r.next(v)) { ... }
+// ============================================================================
+
+#if defined(__AVR__)
+const uint8_t SKIPLIST_MAX_LEVEL = 6;   // up to ~4K keys — far beyond 2KB of RAM
+#else
+const uint8_t SKIPLIST_MAX_LEVEL = 16;  // up to ~4G keys
+#endif
+
+const uint32_t SKIPLIST_DEFAULT_SEED = 0x2545F491u;
+
+// Default ordering: operator<
+template <typename K>
+struct SkipLess {
+  bool operator()(const K& a, const K& b) const { return a < b; }
+};
+
+// Tag for constructing a key inside raw node memory without <new>
+struct SkipListPlacement {};
+inline void* operator new(size_t, void* where, SkipListPlacement) { return where; }
+inline void operator delete(void*, void*, SkipListPlacement) {}
+
+template <typename K, uint8_t MaxLevel = SKIPLIST_MAX_LEVEL, typename Compare = SkipLess<K> >
+class SkipList {
+  // Each height costs 2 random bits; one 32-bit draw covers 16 levels
+  static_assert(MaxLevel >= 1 && MaxLevel <= 16, "MaxLevel must be 1..16");
+
+  struct Node {
+    K key;
+    uint8_t height;
+    Node* next[1];  // really `height` entries — allocated to fit
+  };
+
+public:
+  explicit SkipList(uint32_t seed = SKIPLIST_DEFAULT_SEED, Compare compare = Compare())
+      : level_(0), size_(0), bytes_(0), rng_(seed ? seed : 1), less_(compare) {
+    for (uint8_t i = 0; i < MaxLevel; i++) head_[i] = nullptr;
+  }
+  ~SkipList() { clear(); }
+
+  // Owns its nodes: not copyable
+  SkipList(const SkipList&) = delete;
+  SkipList& operator=(const SkipList&) = delete;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  uint8_t level() const { return level_; }       // tallest node in use
+  size_t memoryBytes() const { return bytes_; }  // node storage, excluding allocator overhead
+
+  // Restart the height sequence — same seed + same inserts = same shape
+  void seed(uint32_t value) { rng_ = value ? value : 1; }
+
+  // Insert — O(log n) avg. Returns false if the key was already present.
+  bool insert(const K& key) {
+    Node** links[MaxLevel];
+    findLinks(key, links);
+    Node* found = *links[0];
+    if (found && !less_(key, found->key)) return false;
+
+    uint8_t h = randomHeight();
+    if (h > level_) level_ = h;
+
+    Node* node = newNode(key, h);
+    for (uint8_t i = 0; i < h; i++) {
+      node->next[i] = *links[i];
+      *links[i] = node;
+    }
+    size_++;
+    return true;
+  }
+
+  // Search — O(log n) avg
+  bool contains(const K& key) const {
+    const Node* node = lowerBound(key);
+    return node && !less_(key, node->key);
+  }
+
+  // Remove — O(log n) avg. Returns false if the key was not present.
+  bool remove(const K& key) {
+    Node** links[MaxLevel];
+    findLinks(key, links);
+    Node* node = *links[0];
+    if (!node || less_(key, node->key)) return false;
+
+    // Below its height, every lane's link to key points at this node
+    for (uint8_t i = 0; i < node->height; i++) *links[i] = node->next[i];
+    while (level_ > 0 && !head_[level_ - 1]) level_--;
+    freeNode(node);
+    size_--;
+    return true;
+  }
+
+  void clear() {
+    Node* node = head_[0];
+    while (node) {
+      Node* next = node->next[0];
+      freeNode(node);
+      node = next;
+    }
+    for (uint8_t i = 0; i < MaxLevel; i++) head_[i] = nullptr;
+    level_ = 0;
+    size_ = 0;
+  }
+
+  // Visit every key in order — O(n)
+  template <typename Fn>
+  void forEach(Fn fn) const {
+    for (const Node* node = head_[0]; node; node = node->next[0]) fn(node->key);
+  }
+
+  // ---- Range iteration ----
+  // Streams the keys in [lo, hi) in sorted order. Holds one node pointer,
+  // no stack — the bottom lane is already a sorted list. Inserting or
+  // removing keys invalidates open ranges.
+  class Range {
+  public:
+    bool next(K& out) {
+      if (!node_ || !less_(node_->key, hi_)) return false;
+      out = node_->key;
+      node_ = node_->next[0];
+      return true;
+    }
+
+  private:
+    friend class SkipList;
+    Range(const Node* first, const K& hi, Compare less) : node_(first), hi_(hi), less_(less) {}
+    const Node* node_;
+    K hi_;
+    Compare less_;
+  };
+
+  Range range(const K& lo, const K& hi) const { return Range(lowerBound(lo), hi, less_); }
+
+private:
+  // First node with key >= key, or nullptr
+  const Node* lowerBound(const K& key) const {
+    Node* const* next = head_;
+    for (int i = level_ - 1; i >= 0; i--) {
+      while (next[i] && less_(next[i]->key, key)) next = next[i]->next;
+    }
+    return next[0];
+  }
+
+  // For each lane, the link that points at the first node >= key
+  // (lanes above level_ are empty, so that is the lane head)
+  void findLinks(const K& key, Node** links[]) {
+    for (int i = level_; i < MaxLevel; i++) links[i] = &head_[i];
+    Node** next = head_;
+    for (int i = level_ - 1; i >= 0; i--) {
+      while (next[i] && less_(next[i]->key, key)) next = next[i]->next;
+      links[i] = &next[i];
+    }
+  }
+
+  // 1 + number of leading "00" bit pairs — P(height > h) = 4^-h
+  uint8_t randomHeight() {
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    uint32_t bits = rng_;
+    uint8_t h = 1;
+    while (h < MaxLevel && (bits & 3) == 0) {
+      h++;
+      bits >>= 2;
+    }
+    return h;
+  }
+
+  static size_t nodeBytes(uint8_t height) {
+    return sizeof(Node) + (height - 1) * sizeof(Node*);
+  }
+
+  Node* newNode(const K& key, uint8_t height) {
+    size_t bytes = nodeBytes(height);
+    Node* node = static_cast<Node*>(::operator new(bytes));
+    new (&node->key, SkipListPlacement()) K(key);
+    node->height = height;
+    bytes_ += bytes;
+    return node;
+  }
+
+  void freeNode(Node* node) {
+    bytes_ -= nodeBytes(node->height);
+    node->key.~K();
+    ::operator delete(node);
+  }
+
+  Node* head_[MaxLevel];  // lane heads live in the list itself, no sentinel node
+  uint8_t level_;
+  size_t size_;
+  size_t bytes_;
+  uint32_t rng_;
+  Compare less_;
+};
+
+#endif // SKIP_LIST_H
@@ -0,0 +1,188 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// Unrolled Linked List — several values per node
+// ============================================================================
+// A plain ListNode holds ONE int and one pointer, so walking n values means
+// n pointer chases (and n cache misses once the heap is fragmented). Here
+// each chunk is one cache line holding a small array:
+//
+//   [next|count| v0 v1 ... v12 ] → [next|count| v13 ... ] → NULL
+//
+//   append()/prepend()/dequeue()  O(1)  — touch only the head/tail chunk
+//   search()                      O(n)  — but ~13 values per pointer chase
+//   insertAt()                    O(n)  — full chunk splits in two halves
+//   removeValue()                 O(n)  — underfull chunk merges with next
+//
+// Shifting values inside a chunk costs at most UNROLLED_CAPACITY moves, a
+// constant, so front operations stay O(1).
+// ============================================================================
+
+#ifndef UNROLLED_CHUNK_BYTES
+#define UNROLLED_CHUNK_BYTES 64  // one cache line on most host CPUs
+#endif
+
+// Values per chunk: whatever fits after the header (13 on 64-bit hosts,
+// 30 on AVR where int and pointers are 2 bytes)
+const size_t UNROLLED_CAPACITY =
+    (UNROLLED_CHUNK_BYTES - sizeof(void*) - sizeof(unsigned short)) / sizeof(int);
+
+struct UnrolledChunk {
+  UnrolledChunk* next;
+  unsigned short count;
+  int values[UNROLLED_CAPACITY];
+};
+
+struct UnrolledList {
+  UnrolledChunk* head = nullptr;
+  UnrolledChunk* tail = nullptr;
+  size_t count = 0;
+};
+
+inline UnrolledChunk* newChunk(UnrolledChunk* next) {
+  UnrolledChunk* chunk = new UnrolledChunk;
+  chunk->next = next;
+  chunk->count = 0;
+  return chunk;
+}
+
+// Insert at END — O(1)
+inline void append(UnrolledList& list, int value) {
+  if (!list.tail || list.tail->count == UNROLLED_CAPACITY) {
+    UnrolledChunk* chunk = newChunk(nullptr);
+    if (list.tail) list.tail->next = chunk;
+    else           list.head = chunk;
+    list.tail = chunk;
+  }
+  list.tail->values[list.tail->count++] = value;
+  list.count++;
+}
+
+// Insert at FRONT — O(1)
+inline void prepend(UnrolledList& list, int value) {
+  UnrolledChunk* chunk = list.head;
+  if (!chunk || chunk->count == UNROLLED_CAPACITY) {
+    chunk = newChunk(list.head);
+    list.head = chunk;
+    if (!list.tail) list.tail = chunk;
+  }
+  memmove(&chunk->values[1], &chunk->values[0], chunk->count * sizeof(int));
+  chunk->values[0] = value;
+  chunk->count++;
+  list.count++;
+}
+
+// Remove from FRONT and return value — O(1)
+inline int dequeue(UnrolledList& list) {
+  UnrolledChunk* chunk = list.head;
+  if (!chunk) return -1;
+  int val = chunk->values[0];
+  chunk->count--;
+  memmove(&chunk->values[0], &chunk->values[1], chunk->count * sizeof(int));
+  if (chunk->count == 0) {
+    list.head = chunk->next;
+    if (!list.head) list.tail = nullptr;
+    delete chunk;
+  }
+  list.count--;
+  return val;
+}
+
+// Search — O(n), scans a whole chunk per pointer chase
+inline bool search(const UnrolledList& list, int value) {
+  for (const UnrolledChunk* chunk = list.head; chunk; chunk = chunk->next) {
+    for (unsigned short i = 0; i < chunk->count; i++) {
+      if (chunk->values[i] == value) return true;
+    }
+  }
+  return false;
+}
+
+// Split a full chunk: the upper half moves into a new chunk after it
+inline void splitChunk(UnrolledList& list, UnrolledChunk* chunk) {
+  UnrolledChunk* upper = newChunk(chunk->next);
+  unsigned short keep = chunk->count / 2;
+  upper->count = chunk->count - keep;
+  memcpy(upper->values, &chunk->values[keep], upper->count * sizeof(int));
+  chunk->count = keep;
+  chunk->next = upper;
+  if (list.tail == chunk) list.tail = upper;
+}
+
+// Insert before position index (index == count appends) — O(n)
+inline bool insertAt(UnrolledList& list, size_t index, int value) {
+  if (index > list.count) return false;
+  if (index == list.count) { append(list, value); return true; }
+
+  UnrolledChunk* chunk = list.head;
+  while (index > chunk->count) {  // never runs off: index < list.count
+    index -= chunk->count;
+    chunk = chunk->next;
+  }
+  if (chunk->count == UNROLLED_CAPACITY) {
+    splitChunk(list, chunk);
+    if (index > chunk->count) {
+      index -= chunk->count;
+      chunk = chunk->next;
+    }
+  }
+  memmove(&chunk->values[index + 1], &chunk->values[index],
+          (chunk->count - index) * sizeof(int));
+  chunk->values[index] = value;
+  chunk->count++;
+  list.count++;
+  return true;
+}
+
+// Remove the first occurrence of value — O(n)
+// A chunk left less than half full absorbs its neighbour when both fit in
+// one chunk, so memory use stays within ~2x of the values stored.
+inline bool removeValue(UnrolledList& list, int value) {
+  UnrolledChunk* prev = nullptr;
+  for (UnrolledChunk* chunk = list.head; chunk; prev = chunk, chunk = chunk->next) {
+    for (unsigned short i = 0; i < chunk->count; i++) {
+      if (chunk->values[i] != value) continue;
+
+      chunk->count--;
+      memmove(&chunk->values[i], &chunk->values[i + 1], (chunk->count - i) * sizeof(int));
+      list.count--;
+
+      if (chunk->count == 0) {
+        // Empty chunk — unlink it
+        if (prev) prev->next = chunk->next;
+        else      list.head = chunk->next;
+        if (list.tail == chunk) list.tail = prev;
+        delete chunk;
+      } else if (chunk->count < UNROLLED_CAPACITY / 2 && chunk->next &&
+                 chunk->count + chunk->next->count <= UNROLLED_CAPACITY) {
+        // Merge the next chunk into this one
+        UnrolledChunk* next = chunk->next;
+        memcpy(&chunk->values[chunk->count], next->values, next->count * sizeof(int));
+        chunk->count += next->count;
+        chunk->next = next->next;
+        if (list.tail == next) list.tail = chunk;
+        delete next;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool isEmpty(const UnrolledList& list) { return list.head == nullptr; }
+
+inline void freeList(UnrolledList& list) {
+  while (list.head) {
+    UnrolledChunk* next = list.head->next;
+    delete list.head;
+    list.head = next;
+  }
+  list.tail = nullptr;
+  list.count = 0;
+}
+
+#endif // UNROLLED_LIST_H
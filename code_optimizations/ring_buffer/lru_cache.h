@@ -0,0 +1,189 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// LRU Cache with TTL — hash table + doubly linked recency list
+// ============================================================================
+// Shared by ring_buffer.ino (cached sensor reads) and ../bench/.
+//
+// A fixed number of entries, keyed by a short string ("READ:TEMP"):
+//
+//   buckets[]      chained hash table (djb2, as in hash_table.h) → find O(1)
+//   head ... tail  recency list, most recent first → touch/evict O(1)
+//
+//   get(key, now, out)       O(1) — hit moves the entry to the front;
+//                                   an expired entry is dropped (a miss)
+//   put(key, value, now, ttl) O(1) — full cache evicts the tail (LRU)
+//
+// Every entry stores when it was written and its own TTL, in the same
+// ticks as `now` (millis() in the sketch). Ages are computed with
+// unsigned subtraction, so the millis() wrap after ~49 days is harmless.
+//
+// No heap: all entries live in the object and unused ones sit on a free
+// list. Keys are COPIED (unlike HashTable), so a reused command buffer is
+// fine as a key. Keys of LRU_KEY_LEN chars or more are not cached.
+// ============================================================================
+
+#ifndef LRU_KEY_LEN
+#define LRU_KEY_LEN 16  // including the terminating '\0'
+#endif
+
+struct LruStats {
+  uint32_t hits;
+  uint32_t misses;       // includes expired entries
+  uint32_t expirations;  // entries found but past their TTL
+  uint32_t evictions;    // entries pushed out to make room
+};
+
+template <typename V, size_t Capacity, size_t Buckets = 16>
+class LruCache {
+  static_assert(Capacity > 0, "LruCache needs at least one entry");
+  static_assert(Buckets > 0 && Buckets <= 256, "bucket index is stored in a uint8_t");
+
+public:
+  LruCache() { clear(); }
+
+  // Lookup — O(1). True and `out` filled if present and still fresh.
+  bool get(const char* key, uint32_t now, V& out) {
+    Node* node = find(key, hashOf(key));
+    if (!node) {
+      stats_.misses++;
+      return false;
+    }
+    if (now - node->stored >= node->ttl) {
+      stats_.misses++;
+      stats_.expirations++;
+      erase(node);
+      return false;
+    }
+    moveToFront(node);
+    out = node->value;
+    stats_.hits++;
+    return true;
+  }
+
+  // Insert or refresh — O(1). False only if the key is too long.
+  bool put(const char* key, const V& value, uint32_t now, uint32_t ttl) {
+    size_t len = strlen(key);
+    if (len >= LRU_KEY_LEN) return false;
+    size_t bucket = hashOf(key);
+    Node* node = find(key, bucket);
+    if (node) {
+      moveToFront(node);
+    } else {
+      if (!free_) {
+        erase(tail_);  // evict least recently used
+        stats_.evictions++;
+      }
+      node = free_;
+      free_ = node->chain;
+      memcpy(node->key, key, len + 1);
+      node->bucket = static_cast<uint8_t>(bucket);
+      node->chain = buckets_[bucket];
+      buckets_[bucket] = node;
+      linkFront(node);
+      size_++;
+    }
+    node->value = value;
+    node->stored = now;
+    node->ttl = ttl;
+    return true;
+  }
+
+  // Drop one key — O(1). False if it wasn't cached.
+  bool remove(const char* key) {
+    Node* node = find(key, hashOf(key));
+    if (!node) return false;
+    erase(node);
+    return true;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < Buckets; i++) buckets_[i] = nullptr;
+    for (size_t i = 0; i < Capacity; i++) nodes_[i].chain = i + 1 < Capacity ? &nodes_[i + 1] : nullptr;
+    free_ = &nodes_[0];
+    head_ = tail_ = nullptr;
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return Capacity; }
+  const LruStats& stats() const { return stats_; }
+  void resetStats() { stats_ = LruStats(); }
+
+  // Key of the most / least recently used entry (nullptr when empty)
+  const char* newest() const { return head_ ? head_->key : nullptr; }
+  const char* oldest() const { return tail_ ? tail_->key : nullptr; }
+
+private:
+  struct Node {
+    char key[LRU_KEY_LEN];
+    V value;
+    uint32_t stored;  // tick of the last put()
+    uint32_t ttl;
+    uint8_t bucket;  // saves rehashing the key on erase
+    Node* chain;  // next in hash bucket, or next free node
+    Node* prev;   // recency list
+    Node* next;
+  };
+
+  static size_t hashOf(const char* key) {
+    uint32_t hash = 5381;
+    while (*key) hash = ((hash << 5) + hash) + (unsigned char)*key++;
+    return hash % Buckets;
+  }
+
+  Node* find(const char* key, size_t bucket) const {
+    for (Node* cur = buckets_[bucket]; cur; cur = cur->chain) {
+      if (strcmp(cur->key, key) == 0) return cur;
+    }
+    return nullptr;
+  }
+
+  void linkFront(Node* node) {
+    node->prev = nullptr;
+    node->next = head_;
+    if (head_) head_->prev = node;
+    else       tail_ = node;
+    head_ = node;
+  }
+
+  void unlink(Node* node) {
+    if (node->prev) node->prev->next = node->next;
+    else            head_ = node->next;
+    if (node->next) node->next->prev = node->prev;
+    else            tail_ = node->prev;
+  }
+
+  void moveToFront(Node* node) {
+    if (node == head_) return;
+    unlink(node);
+    linkFront(node);
+  }
+
+  // Unlink from its bucket and the recency list, return to the free list.
+  // Chains hold about Capacity / Buckets entries, so the walk is O(1).
+  void erase(Node* node) {
+    Node** link = &buckets_[node->bucket];
+    while (*link != node) link = &(*link)->chain;
+    *link = node->chain;
+    unlink(node);
+    node->chain = free_;
+    free_ = node;
+    size_--;
+  }
+
+  Node nodes_[Capacity];
+  Node* buckets_[Buckets];
+  Node* free_;
+  Node* head_;
+  Node* tail_;
+  size_t size_;
+  LruStats stats_ = LruStats();
+};
+
+#endif // LRU_CACHE_H
@@ -0,0 +1,42 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+// ============================================================================
+// Ring Buffer — core operations (no Arduino dependencies)
+// ============================================================================
+// Shared by ring_buffer.ino and the host benchmarks in ../bench/.
+//
+// Fixed-size circular FIFO of bytes: push() at head, pop() at tail.
+// No heap, and every operation is O(1). When full, push() drops the byte.
+// ============================================================================
+
+const int BUF_SIZE = 64;
+
+struct RingBuffer {
+  char data[BUF_SIZE];
+  volatile int head  = 0;  // volatile: written by ISR in real firmware
+  volatile int tail  = 0;
+  volatile int count = 0;
+};
+
+inline bool push(RingBuffer& rb, char c) {
+  if (rb.count == BUF_SIZE) return false;  // full — byte dropped
+  rb.data[rb.head] = c;
+  rb.head = (rb.head + 1) % BUF_SIZE;
+  rb.count++;
+  return true;
+}
+
+inline bool pop(RingBuffer& rb, char& out) {
+  if (rb.count == 0) return false;
+  out = rb.data[rb.tail];
+  rb.tail = (rb.tail + 1) % BUF_SIZE;
+  rb.count--;
+  return true;
+}
+
+inline bool isEmpty(RingBuffer& rb) {
+  return rb.count == 0;
+}
+
+#endif // RING_BUFFER_H
@@ -12,44 +12,34 @@
 //   → They run at different speeds — the buffer absorbs the gap
 //
 // Commands arrive as: "LED:ON\n", "LED:OFF\n", "READ:TEMP\n"
+//
+// Read commands go through an LRU cache (lru_cache.h): polling READ:TEMP
+// ten times a second costs one analogRead per TTL, not one per poll.
+// "CACHE" prints hit/miss counts.
 // ============================================================
 
 // ---- Ring Buffer ----------------------------------------
 
-const int BUF_SIZE = 64;
-
-struct RingBuffer {
-  char data[BUF_SIZE];
-  volatile int head  0;  // volatile: written by ISR in real firmware
-  volatile int tail  0;
-  volatile int count = 0;
-};
-
-bool push(RingBuffer& rb, char c) {
-  if (rb.count == BUF_SIZE) return false;  // full — byte dropped
-  rb.data[rb.head] = c;
-  rb.head = (rb.head + 1) % BUF_SIZE;
-  rb.count++;
-  return true;
-}
-
-bool pop(RingBuffer& rb, char& out) {
-  if (rb.count == 0) return false;
-  out = rb.data[rb.tail];
-  rb.tail = (rb.tail + 1) % BUF_SIZE;
-  rb.count--;
-  return true;
-}
-
-bool isEmpty(RingBuffer& rb) {
-  
-  return rb.count == 0;
-}
+#include "ring_buffer.h"  // RingBuffer, push(), pop(), isEmpty()
+#include "lru_cache.h"    // LruCache: hash table + recency list, per-entry TTL
 
 // ---- Command processor ----------------------------------
 
 RingBuffer rxBuf;
 
+// Raw ADC readings by command name. 4 entries × 33 bytes on AVR, no heap.
+LruCache<int, 4> readCache;
+
+// analogRead() through the cache: a fresh entry skips the ADC entirely.
+// ttlMs is how long a reading stays valid — slow sensors get a long one.
+int cachedRead(const char* name, uint8_t pin, uint32_t ttlMs) {
+  int raw;
+  if (readCache.get(name, millis(), raw)) return raw;
+  raw = analogRead(pin);
+  readCache.put(name, raw, millis(), ttlMs);
+  return raw;
+}
+
 // Called when a complete command (terminated by '\n') is ready
 void handleCommand(const char* cmd) {
   Serial.print("[CMD] received: \"");
@@ -65,13 +55,29 @@ void handleCommand(const char* cmd) {
     Serial.println("  → LED turned OFF");
 
   } else if (strcmp(cmd, "READ:TEMP") == 0) {
-    int raw = a ogRead(A0);
+    int raw = cachedRead(cmd, A0, 1000);  // TMP36 drifts slowly
     float voltage = raw * (5.0 / 1023.0);
     float tempC = (voltage - 0.5) * 100.0;  // TMP36 formula
     Serial.print("  → Temperature: ");
     Serial.print(tempC);
     Serial.println(" °C");
 
+  } else if (strcmp(cmd, "READ:LIGHT") == 0) {
+    int raw = cachedRead(cmd, A1, 100);  // light changes faster
+    Serial.print("  → Light level: ");
+    Serial.println(raw);
+
+  } else if (strcmp(cmd, "CACHE") == 0) {
+    const LruStats& st = readCache.stats();
+    Serial.print("  → hits ");
+    Serial.print(st.hits);
+    Serial.print(", misses ");
+    Serial.print(st.misses);
+    Serial.print(" (");
+    Serial.print(st.expirations);
+    Serial.print(" expired), evictions ");
+    Serial.println(st.evictions);
+
   } else {
     Serial.println("  → Unknown command");
   }
@@ -79,7 +85,7 @@ void handleCommand(const char* cmd) {
 
 // Reads bytes from the ring buffer, builds a command, fires handleCommand()
 // when '\n' is found. Non-blocking — exits immediately if buffer is empty.
-void process ffer() {
+void processBuffer() {
   static char cmdBuf[32];  // assembles the current command
   static int cmdLen = 0;
 
@@ -87,7 +93,7 @@ void process ffer() {
   while (pop(rxBuf, c)) {
     if (c == '\n' || c == '\r') {
       if (cmdLen > 0) {
-        cmdBuf[cmdL  // null-terminate
+        cmdBuf[cmdLen] = '\0';  // null-terminate
         handleCommand(cmdBuf);
         cmdLen = 0;  // reset for next command
       }
@@ -104,12 +110,12 @@ void setup() {
   Serial.begin(115200);
   pinMode(LED_BUILTIN, OUTPUT);
 
-  Serial.println("Ready. Send: LED:ON  LED:OFF  READ:TEMP");
+  Serial.println("Ready. Send: LED:ON  LED:OFF  READ:TEMP  READ:LIGHT  CACHE");
   Serial.println("(or watch the simulation below)\n");
 
   // --- Simulation: push a sequence of commands into the buffer
   //     as if they arrived byte-by-byte over UART ---
-  const char* incoming = "LED:ON\nREAD:TEMP\nLED:OFF\nBAD:CMD\n";
+  const char* incoming = "LED:ON\nREAD:TEMP\nREAD:TEMP\nLED:OFF\nBAD:CMD\nCACHE\n";
   for (int i = 0; incoming[i] != '\0'; i++) {
     push(rxBuf, incoming[i]);
   }
@@ -122,5 +128,5 @@ void loop() {
     push(rxBuf, (char)Serial.read());
   }
 
- 
+  processBuffer();  // non-blocking — handles whatever has arrived
 }
@@ -0,0 +1,109 @@
+/*
+Benchmark Helpers
+Shared by the benchmarks in bench/ - timing, throughput and test data.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace bench {
+
+inline uint64_t nowNs() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Keep the optimizer from deleting a computed value
+template <typename T>
+inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// xorshift64 - deterministic, fast, good enough for test data
+struct Rng {
+  uint64_t state;
+  explicit Rng(uint64_t seed = 0x9E3779B97F4A7C15ull) : state(seed ? seed : 1) {}
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+// Buffer of pseudo-random bytes
+inline std::vector<uint8_t> randomBytes(size_t size, uint64_t seed = 1) {
+  std::vector<uint8_t> bytes(size);
+  Rng rng(seed);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word = rng.next();
+    for (int b = 0; b < 8; b++) {
+      bytes[i + b] = static_cast<uint8_t>(word >> (8 * b));
+    }
+  }
+  for (; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(rng.next());
+  }
+  return bytes;
+}
+
+// Optional first CLI argument overrides the largest input size
+inline size_t maxSizeArg(int argc, char **argv, size_t fallback) {
+  if (argc > 1) {
+    return static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+  }
+  return fallback;
+}
+
+// Best time for one fn() call. Small buffers are called in batches of at
+// least 64 KB so timer overhead doesn't dominate; samples repeat until
+// minBytes have been processed (at least 3). Best-of keeps one noisy run
+// from skewing GB/s.
+template <typename Fn>
+inline uint64_t bestNs(size_t bytesPerRun, size_t minBytes, Fn fn) {
+  size_t batch = bytesPerRun ? (size_t{64} << 10) / bytesPerRun : 1;
+  if (batch < 1) {
+    batch = 1;
+  }
+  size_t samples = bytesPerRun ? minBytes / (bytesPerRun * batch) : 1;
+  if (samples < 3) {
+    samples = 3;
+  }
+  uint64_t best = UINT64_MAX;
+  for (size_t s = 0; s < samples; s++) {
+    uint64_t t0 = nowNs();
+    for (size_t b = 0; b < batch; b++) {
+      fn();
+    }
+    uint64_t elapsed = (nowNs() - t0) / batch;
+    if (elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+inline double gbPerSec(size_t bytes, uint64_t ns) {
+  return ns ? static_cast<double>(bytes) / static_cast<double>(ns) : 0.0;
+}
+
+// "1 KB", "64 MB", "1 GB"
+inline const char *sizeLabel(size_t bytes, char (&out)[24]) {
+  static const char *units[] = {"B", "KB", "MB", "GB"};
+  int u = 0;
+  while (bytes >= 1024 && bytes % 1024 == 0 && u < 3) {
+    bytes /= 1024;
+    u++;
+  }
+  std::snprintf(out, sizeof(out), "%zu %s", bytes, units[u]);
+  return out;
+}
+
+} // namespace bench
@@ -0,0 +1,205 @@
+/*
+Bit Array Benchmark
+AND, OR, XOR and popcount over 100M-bit arrays: BitArray (dispatched and
+plain 64-bit kernels) vs std::bitset and std::vector<bool>.
+
+Usage: bit_array_bench [bits]   (default 100000000; std::bitset only runs
+                                 at the default, its size is fixed at compile time)
+
+Prints ms per operation and Gbit/s. Every container must produce the same
+bits and the same counts, or the benchmark exits with an error. The
+single-bit API, resize() and size mismatches are checked by
+tests/bit_array_test.cpp.
+*/
+
+#include "bench.hpp"
+#include "bit_array.hpp"
+#include "bit_kernels.hpp"
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <cstdio>
+#include <memory>
+
+static constexpr size_t BITSET_BITS = 100'000'000;
+using BigBitset = std::bitset<BITSET_BITS>;
+
+// One row of the table: same operation on every container
+struct Row {
+  const char *op;
+  double ns[4]; // BitArray, words64, bitset, vector<bool>; < 0 = not run
+};
+
+static void printRow(const Row &row, size_t bits) {
+  std::printf("%-9s", row.op);
+  for (double ns : row.ns) {
+    if (ns < 0) {
+      std::printf(" %20s", "-");
+    } else {
+      std::printf(" %9.2f ms %6.1f Gb/s", ns / 1e6, static_cast<double>(bits) / ns);
+    }
+  }
+  std::printf("\n");
+}
+
+// Same bits in vector<bool> and BitArray?
+static bool sameBits(const BitArray &a, const std::vector<bool> &v) {
+  for (size_t i = 0; i < v.size(); i++) {
+    if (a.test(i) != v[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const size_t bits = bench::maxSizeArg(argc, argv, BITSET_BITS);
+  const bool run_bitset = bits == BITSET_BITS;
+  const size_t bytes = (bits + 7) / 8;
+  const size_t min_bytes = size_t{256} << 20;
+  bool ok = true;
+
+  // Two random inputs, identical in every container
+  BitArray a(bits);
+  BitArray b(bits);
+  std::vector<bool> va(bits);
+  std::vector<bool> vb(bits);
+  // 12.5 MB each - too big for the stack
+  auto sa = std::make_unique<BigBitset>();
+  auto sb = std::make_unique<BigBitset>();
+  bench::Rng rng;
+  for (size_t i = 0; i < bits; i += 64) {
+    uint64_t wa = rng.next();
+    uint64_t wb = rng.next();
+    for (size_t j = 0; j < 64 && i + j < bits; j++) {
+      bool bit_a = (wa >> j) & 1;
+      bool bit_b = (wb >> j) & 1;
+      a.assign(i + j, bit_a);
+      b.assign(i + j, bit_b);
+      va[i + j] = bit_a;
+      vb[i + j] = bit_b;
+      if (run_bitset) {
+        sa->set(i + j, bit_a);
+        sb->set(i + j, bit_b);
+      }
+    }
+  }
+
+  std::printf("%zu bits (%.1f MB per array), BitArray ops dispatch to: %s\n\n", bits,
+              static_cast<double>(bytes) / (1 << 20), BitKernels::applyWordsKernelName());
+  std::printf("%-9s %20s %20s %20s %20s\n", "op", "BitArray", "BitArray words64", "std::bitset",
+              "std::vector<bool>");
+
+  const BitKernels::WordOp word_ops[] = {BitKernels::WordOp::And, BitKernels::WordOp::Or,
+                                         BitKernels::WordOp::Xor};
+  const char *op_names[] = {"AND", "OR", "XOR"};
+
+  for (int op = 0; op < 3; op++) {
+    Row row = {op_names[op], {-1, -1, -1, -1}};
+    const BitKernels::WordOp word_op = word_ops[op];
+
+    // Every timed op runs on a copy of `a`. AND and OR are idempotent and XOR
+    // flips back and forth, so the result is checked once, before timing
+    BitArray c = a;
+    std::vector<uint64_t> words(c.data().begin(), c.data().end());
+    std::vector<bool> vc = va;
+    auto sc = std::make_unique<BigBitset>(*sa);
+
+    auto bitArrayOp = [&]() {
+      if (word_op == BitKernels::WordOp::And) {
+        c &= b;
+      } else if (word_op == BitKernels::WordOp::Or) {
+        c |= b;
+      } else {
+        c ^= b;
+      }
+    };
+    auto bitsetOp = [&]() {
+      if (word_op == BitKernels::WordOp::And) {
+        *sc &= *sb;
+      } else if (word_op == BitKernels::WordOp::Or) {
+        *sc |= *sb;
+      } else {
+        *sc ^= *sb;
+      }
+    };
+    // No word access: one proxy read/write per bit
+    auto vectorBoolOp = [&]() {
+      for (size_t i = 0; i < bits; i++) {
+        vc[i] = word_op == BitKernels::WordOp::And  ? vc[i] && vb[i]
+                : word_op == BitKernels::WordOp::Or ? vc[i] || vb[i]
+                                                    : vc[i] != vb[i];
+      }
+    };
+
+    bitArrayOp();
+    bitsetOp();
+    BitKernels::applyWords64(word_op, words, b.data());
+    vectorBoolOp();
+    if (!sameBits(c, vc) || !std::equal(words.begin(), words.end(), c.data().begin())) {
+      std::fprintf(stderr, "%s: BitArray and std::vector<bool> disagree\n", op_names[op]);
+      ok = false;
+    }
+    if (run_bitset && sc->count() != c.count()) {
+      std::fprintf(stderr, "%s: BitArray and std::bitset disagree\n", op_names[op]);
+      ok = false;
+    }
+
+    row.ns[0] = static_cast<double>(bench::bestNs(bytes, min_bytes, [&] {
+      bitArrayOp();
+      bench::doNotOptimize(c.data()[0]);
+    }));
+    row.ns[1] = static_cast<double>(bench::bestNs(bytes, min_bytes, [&] {
+      BitKernels::applyWords64(word_op, words, b.data());
+      bench::doNotOptimize(words[0]);
+    }));
+    if (run_bitset) {
+      row.ns[2] = static_cast<double>(bench::bestNs(bytes, min_bytes, [&] {
+        bitsetOp();
+        bench::doNotOptimize(sc->test(0));
+      }));
+    }
+    // vector<bool> is bit-by-bit; one sample per run is plenty
+    row.ns[3] = static_cast<double>(bench::bestNs(bytes, 0, [&] {
+      vectorBoolOp();
+      bench::doNotOptimize(static_cast<bool>(vc[0]));
+    }));
+    printRow(row, bits);
+    std::fflush(stdout);
+  }
+
+  // Popcount - all four must agree
+  {
+    Row row = {"popcount", {-1, -1, -1, -1}};
+    size_t count_a = a.count();
+    size_t count_words = 0;
+    for (uint64_t w : a.data()) {
+      count_words += static_cast<size_t>(std::popcount(w));
+    }
+    size_t count_v = static_cast<size_t>(std::count(va.begin(), va.end(), true));
+    if (count_a != count_words || count_a != count_v || (run_bitset && count_a != sa->count())) {
+      std::fprintf(stderr, "popcount: containers disagree\n");
+      ok = false;
+    }
+
+    row.ns[0] = static_cast<double>(
+        bench::bestNs(bytes, min_bytes, [&] { bench::doNotOptimize(a.count()); }));
+    row.ns[1] = static_cast<double>(bench::bestNs(bytes, min_bytes, [&] {
+      size_t count = 0;
+      for (uint64_t w : a.data()) {
+        count += static_cast<size_t>(std::popcount(w));
+      }
+      bench::doNotOptimize(count);
+    }));
+    if (run_bitset) {
+      row.ns[2] = static_cast<double>(
+          bench::bestNs(bytes, min_bytes, [&] { bench::doNotOptimize(sa->count()); }));
+    }
+    row.ns[3] = static_cast<double>(bench::bestNs(bytes, 0, [&] {
+      bench::doNotOptimize(std::count(va.begin(), va.end(), true));
+    }));
+    printRow(row, bits);
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
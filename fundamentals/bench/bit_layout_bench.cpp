@@ -0,0 +1,120 @@
+/*
+Bit Layout Benchmark
+Packing and unpacking SensorPacket records one at a time (setters, or
+Layout::get into a struct) vs BitLayout::packAll/unpackAll over per-field arrays.
+
+Usage: bit_layout_bench [records]   (default 16M)
+
+Prints million records/s. Every path must give the same packed words and
+the same field values or the benchmark exits with an error.
+*/
+
+#include "bench.hpp"
+#include "real_world.hpp"
+#include <cstdio>
+#include <cstring>
+
+using Layout = SensorPacket::Layout;
+
+// One reading as the sketch would store it before packing (array of structs)
+struct Reading {
+  uint8_t temperature;
+  uint8_t humidity;
+  uint8_t light;
+};
+
+static void printRate(const char *name, size_t records, uint64_t ns) {
+  std::printf("  %-34s %8.1f M records/s  %6.2f ns/record\n", name,
+              static_cast<double>(records) * 1e3 / static_cast<double>(ns),
+              static_cast<double>(ns) / static_cast<double>(records));
+}
+
+int main(int argc, char **argv) {
+  const size_t records = bench::maxSizeArg(argc, argv, size_t{16} << 20);
+  const size_t min_bytes = size_t{256} << 20;
+  const size_t packed_bytes = records * sizeof(uint16_t);
+  bool ok = true;
+
+  // Random in-range readings, in both shapes
+  std::vector<Reading> readings(records);
+  std::vector<uint8_t> temps(records);
+  std::vector<uint8_t> humids(records);
+  std::vector<uint8_t> lights(records);
+  bench::Rng rng;
+  for (size_t i = 0; i < records; i++) {
+    uint64_t r = rng.next();
+    temps[i] = static_cast<uint8_t>(r & 0x1F);
+    humids[i] = static_cast<uint8_t>((r >> 8) & 0x1F);
+    lights[i] = static_cast<uint8_t>((r >> 16) & 0x3F);
+    readings[i] = {temps[i], humids[i], lights[i]};
+  }
+
+  std::vector<uint16_t> expected(records);
+  std::vector<uint16_t> packed(records);
+  std::printf("SensorPacket, %zu records (%zu KB packed)\n\nPack:\n", records,
+              packed_bytes >> 10);
+
+  auto packWithSetters = [&] {
+    for (size_t i = 0; i < records; i++) {
+      SensorPacket packet;
+      packet.setTemperature(readings[i].temperature);
+      packet.setHumidity(readings[i].humidity);
+      packet.setLight(readings[i].light);
+      expected[i] = packet.getRawData();
+    }
+  };
+  packWithSetters();
+  printRate("SensorPacket setters (AoS)", records,
+            bench::bestNs(packed_bytes, min_bytes, [&] {
+              packWithSetters();
+              bench::doNotOptimize(expected[0]);
+            }));
+
+  const Layout::ConstColumns columns = {temps, humids, lights};
+  Layout::packAll(columns, packed);
+  if (std::memcmp(packed.data(), expected.data(), packed_bytes) != 0) {
+    std::fprintf(stderr, "packAll differs from SensorPacket setters\n");
+    ok = false;
+  }
+  printRate("Layout::packAll (SoA)", records, bench::bestNs(packed_bytes, min_bytes, [&] {
+              Layout::packAll(columns, packed);
+              bench::doNotOptimize(packed[0]);
+            }));
+
+  std::printf("\nUnpack:\n");
+  std::vector<Reading> unpacked(records);
+  auto unpackPerRecord = [&] {
+    for (size_t i = 0; i < records; i++) {
+      const uint16_t word = packed[i];
+      unpacked[i] = {Layout::get<SensorPacket::TEMPERATURE>(word),
+                     Layout::get<SensorPacket::HUMIDITY>(word),
+                     Layout::get<SensorPacket::LIGHT>(word)};
+    }
+  };
+  unpackPerRecord();
+  if (std::memcmp(unpacked.data(), readings.data(), records * sizeof(Reading)) != 0) {
+    std::fprintf(stderr, "Layout::get did not round-trip\n");
+    ok = false;
+  }
+  printRate("Layout::get per record (AoS)", records,
+            bench::bestNs(packed_bytes, min_bytes, [&] {
+              unpackPerRecord();
+              bench::doNotOptimize(unpacked[0]);
+            }));
+
+  std::vector<uint8_t> out_temps(records);
+  std::vector<uint8_t> out_humids(records);
+  std::vector<uint8_t> out_lights(records);
+  const Layout::Columns out_columns = {out_temps, out_humids, out_lights};
+  Layout::unpackAll(packed, out_columns);
+  if (out_temps != temps || out_humids != humids || out_lights != lights) {
+    std::fprintf(stderr, "unpackAll did not round-trip\n");
+    ok = false;
+  }
+  printRate("Layout::unpackAll (SoA)", records, bench::bestNs(packed_bytes, min_bytes, [&] {
+              Layout::unpackAll(packed, out_columns);
+              bench::doNotOptimize(out_temps[0]);
+            }));
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
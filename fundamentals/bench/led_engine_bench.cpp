@@ -0,0 +1,206 @@
+/*
+LED Engine Benchmark
+Frames per second for a 10K-pixel installation (8 strips): each effect on
+its own, the WS2812 encoder (scalar vs AVX2, 3- and 4-bit), and a whole
+frame - render, gamma, encode.
+
+Usage: led_engine_bench [pixels]   (default 10000, split over 8 strips)
+
+Every encoded bitstream is checked bit for bit against a one-bit-at-a-time
+reference encoder and decoded back to the frame; effects must give the
+same picture at the same time whatever the frame rate. Any mismatch exits
+with an error.
+*/
+
+#include "bench.hpp"
+#include "cpu_features.hpp"
+#include "led_engine.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static constexpr size_t STRIPS = 8;
+static constexpr uint64_t SECOND_US = 1'000'000;
+
+using Encoding = WS2812::Encoding;
+
+// Reference: append one SPI bit at a time, straight from the timing table
+static std::vector<uint8_t> referenceBits(std::span<const uint8_t> data, Encoding encoding) {
+  const char *zero = encoding == Encoding::FourBit ? "1000" : "100";
+  const char *one = encoding == Encoding::FourBit ? "1110" : "110";
+  std::vector<uint8_t> out(data.size() * WS2812::spiBitsPerBit(encoding), 0);
+  size_t pos = 0;
+  for (uint8_t b : data) {
+    for (int bit = 7; bit >= 0; bit--) {
+      for (const char *s = (b >> bit) & 1 ? one : zero; *s; s++, pos++) {
+        if (*s == '1') {
+          out[pos >> 3] |= static_cast<uint8_t>(0x80 >> (pos & 7));
+        }
+      }
+    }
+  }
+  return out;
+}
+
+static void printFps(const char *name, uint64_t ns) {
+  std::printf("  %-34s %10.0f frames/s  %8.1f us/frame\n", name, 1e9 / static_cast<double>(ns),
+              static_cast<double>(ns) / 1e3);
+}
+
+// Encoder kernels on one frame's worth of wire bytes
+static bool encoders(std::span<const uint8_t> grb) {
+  bool ok = true;
+  struct Kernel {
+    const char *name;
+    void (*fn)(std::span<const uint8_t>, std::span<uint8_t>, Encoding) noexcept;
+    bool available;
+  };
+  const Kernel kernels[] = {
+      {"scalar", WS2812::encodeScalar, true},
+      {"AVX2", WS2812::encodeAvx2, CpuFeatures::hasAvx2()},
+  };
+  for (Encoding encoding : {Encoding::ThreeBit, Encoding::FourBit}) {
+    const unsigned group = WS2812::spiBitsPerBit(encoding);
+    const std::vector<uint8_t> expected = referenceBits(grb, encoding);
+    for (const Kernel &k : kernels) {
+      char name[48];
+      std::snprintf(name, sizeof(name), "encode %u-bit, %s", group, k.name);
+      if (!k.available) {
+        std::printf("  %-34s %10s\n", name, "-");
+        continue;
+      }
+      std::vector<uint8_t> spi(expected.size());
+      k.fn(grb, spi, encoding);
+      std::vector<uint8_t> decoded(grb.size());
+      if (spi != expected || !WS2812::decode(spi, decoded, encoding) ||
+          !std::equal(decoded.begin(), decoded.end(), grb.begin())) {
+        std::fprintf(stderr, "%s: bitstream differs from the reference\n", name);
+        ok = false;
+      }
+      printFps(name, bench::bestNs(grb.size(), size_t{256} << 20, [&] {
+                 k.fn(grb, spi, encoding);
+                 bench::doNotOptimize(spi[0]);
+               }));
+    }
+  }
+  return ok;
+}
+
+// Every strip's SPI bytes decode back to the front buffer, reset tail zero
+static bool engineBitsMatch(const LEDEngine &engine) {
+  const size_t pixels = engine.pixelsPerStrip();
+  const size_t data_bytes = 3 * pixels * WS2812::spiBitsPerBit(engine.encoding());
+  std::vector<uint8_t> grb(3 * pixels);
+  std::vector<uint8_t> decoded(3 * pixels);
+  for (size_t s = 0; s < engine.strips(); s++) {
+    std::span<const uint8_t> bits = engine.stripBits(s);
+    WS2812::toWireOrder(engine.front().packed().subspan(s * pixels, pixels), grb);
+    if (!WS2812::decode(bits.first(data_bytes), decoded, engine.encoding()) || decoded != grb ||
+        std::any_of(bits.begin() + data_bytes, bits.end(), [](uint8_t b) { return b != 0; })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const size_t requested = bench::maxSizeArg(argc, argv, 10000);
+  const size_t per_strip = std::max<size_t>(1, requested / STRIPS);
+  bool ok = true;
+
+  LEDEngine engine(STRIPS, per_strip);
+  std::printf("%zu strips x %zu pixels, WS2812 kernels: %s\n", STRIPS, per_strip,
+              WS2812::kernelName());
+  // What the wire allows: 24 bits of 1.25 us per pixel, then the latch
+  const double wire_us = static_cast<double>(per_strip) * 24 * 1e6 / WS2812::BIT_RATE_HZ +
+                         WS2812::RESET_US;
+  std::printf("WS2812 wire limit (strips in parallel): %.0f frames/s\n\n", 1e6 / wire_us);
+
+  // Effects: time advances 16.7 ms per call, like a 60 Hz loop
+  struct Effect {
+    const char *name;
+    void (*draw)(RGBFrame &, uint64_t);
+  };
+  const Effect effects[] = {
+      {"effect: chase",
+       [](RGBFrame &f, uint64_t t) { LEDEffects::chase(f, t, 0xFF6020, 120, 24); }},
+      {"effect: fade",
+       [](RGBFrame &f, uint64_t t) { LEDEffects::fade(f, t, 0x000010, 0xFFA040, 2 * SECOND_US); }},
+      {"effect: rainbow", [](RGBFrame &f, uint64_t t) { LEDEffects::rainbow(f, t, 3 * SECOND_US); }},
+  };
+  const size_t frame_bytes = STRIPS * per_strip * 4;
+  for (const Effect &e : effects) {
+    uint64_t t = 0;
+    printFps(e.name, bench::bestNs(frame_bytes, size_t{256} << 20, [&] {
+               engine.render(t += 16'667, e.draw);
+               bench::doNotOptimize(engine.front().packed()[0]);
+             }));
+
+    // Frame-rate independence: 60 fps and 144 fps runs agree at t = 1.5 s
+    LEDEngine fast(STRIPS, per_strip);
+    LEDEngine slow(STRIPS, per_strip);
+    for (uint64_t step = 0; step <= 90; step++) {
+      slow.render(step * 1'500'000 / 90, e.draw);
+    }
+    for (uint64_t step = 0; step <= 216; step++) {
+      fast.render(step * 1'500'000 / 216, e.draw);
+    }
+    if (!std::ranges::equal(fast.front().packed(), slow.front().packed())) {
+      std::fprintf(stderr, "%s depends on the frame rate\n", e.name);
+      ok = false;
+    }
+  }
+
+  // Encoder on one frame of wire bytes
+  std::vector<uint8_t> grb(3 * STRIPS * per_strip);
+  LEDEffects::rainbow(engine.back(), 123'456, 3 * SECOND_US);
+  WS2812::toWireOrder(engine.back().packed(), grb);
+  ok = encoders(grb) && ok;
+
+  // Double buffering: drawing into back() leaves front() and its bits alone
+  engine.render(0, [](RGBFrame &f, uint64_t t) { LEDEffects::rainbow(f, t, SECOND_US); });
+  engine.encode();
+  const std::vector<uint32_t> shown(engine.front().packed().begin(), engine.front().packed().end());
+  LEDEffects::fade(engine.back(), 0, 0xFFFFFF, 0xFFFFFF, SECOND_US);
+  if (!std::ranges::equal(engine.front().packed(), shown) || !engineBitsMatch(engine)) {
+    std::fprintf(stderr, "drawing the back buffer changed the front\n");
+    ok = false;
+  }
+
+  // ...and encoding the next frame leaves the bits DMA is still sending
+  std::span<const uint8_t> sending = engine.stripBits(0);
+  const std::vector<uint8_t> sent(sending.begin(), sending.end());
+  engine.present();
+  engine.encode();
+  if (!std::ranges::equal(sending, sent) || !engineBitsMatch(engine)) {
+    std::fprintf(stderr, "encode() overwrote the SPI bytes being sent\n");
+    ok = false;
+  }
+
+  // Whole frame: effect → gamma → encode every strip
+  std::printf("\n");
+  for (Encoding encoding : {Encoding::ThreeBit, Encoding::FourBit}) {
+    LEDEngine full(STRIPS, per_strip, encoding);
+    uint64_t t = 0;
+    auto frame = [&] {
+      full.render(t += 16'667, [](RGBFrame &f, uint64_t now) {
+        LEDEffects::chase(f, now, 0xFF6020, 120, 24);
+        f.gamma();
+      });
+      full.encode();
+    };
+    frame();
+    if (!engineBitsMatch(full)) {
+      std::fprintf(stderr, "engine SPI bytes don't decode to the front buffer\n");
+      ok = false;
+    }
+    char name[48];
+    std::snprintf(name, sizeof(name), "chase + gamma + encode %u-bit", WS2812::spiBitsPerBit(encoding));
+    printFps(name, bench::bestNs(frame_bytes, size_t{256} << 20, [&] {
+               frame();
+               bench::doNotOptimize(full.stripBits(0)[0]);
+             }));
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
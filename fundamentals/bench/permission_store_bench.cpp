@@ -0,0 +1,185 @@
+/*
+Permission Store Benchmark
+Access-control queries over 10M principals: a scan of one Permissions
+byte per principal vs PermissionStore's per-permission roaring bitmaps.
+
+Usage: permission_store_bench [principals]   (default 10000000)
+
+Prints milliseconds per query. Both sides must find the same principals
+(counts, and the IDs themselves for one query) or the benchmark exits with
+an error.
+*/
+
+#include "bench.hpp"
+#include "bit_kernels.hpp"
+#include "permission_store.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// Share of principals holding each permission, out of 4096: most can read,
+// few can delete, a handful are admins
+static constexpr uint32_t SHARE[5] = {
+    3686, // READ      90%
+    1434, // WRITE     35%
+    614,  // EXECUTE   15%
+    164,  // DELETE     4%
+    2,    // ADMIN      0.05%
+};
+
+struct Query {
+  const char *name;
+  uint8_t all;  // every one of these (or, with any = true, at least one)
+  uint8_t none; // and none of these
+  bool any;
+};
+
+// `&` rather than `&&`: no branch per principal, so the scan vectorizes
+static bool matches(const Query &q, Permissions p) {
+  return (q.any ? p.hasAny(q.all) : p.hasAll(q.all)) & !p.hasAny(q.none);
+}
+
+static double ms(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+int main(int argc, char **argv) {
+  const size_t principals = bench::maxSizeArg(argc, argv, 10'000'000);
+  const size_t min_bytes = size_t{256} << 20;
+  bool ok = true;
+
+  // ===== BUILD =====
+  std::vector<Permissions> table(principals);
+  bench::Rng rng;
+  for (size_t id = 0; id < principals; id++) {
+    const uint64_t r = rng.next();
+    for (unsigned bit = 0; bit < 5; bit++) {
+      if (((r >> (12 * bit)) & 0xFFF) < SHARE[bit]) {
+        table[id].grant(static_cast<uint8_t>(1 << bit));
+      }
+    }
+  }
+
+  PermissionStore store;
+  uint64_t t0 = bench::nowNs();
+  for (size_t id = 0; id < principals; id++) {
+    store.grant(static_cast<uint32_t>(id), table[id].flags);
+  }
+  const uint64_t build_ns = bench::nowNs() - t0;
+
+  std::printf("%zu principals, bitmap ops dispatch to: %s\n", principals,
+              BitKernels::applyWordsKernelName());
+  std::printf("  Permissions table  %8.1f MB\n", static_cast<double>(principals) / (1 << 20));
+  std::printf("  PermissionStore    %8.1f MB  (built in %.0f ms)\n",
+              static_cast<double>(store.bytes()) / (1 << 20), ms(build_ns));
+  const char *names[5] = {"READ", "WRITE", "EXECUTE", "DELETE", "ADMIN"};
+  for (unsigned bit = 0; bit < 5; bit++) {
+    const RoaringBitmap &column = store.holders(bit);
+    std::printf("    %-8s %9zu holders, %4zu containers (%zu bitmap)\n", names[bit],
+                column.cardinality(), column.containerCount(), column.bitmapContainerCount());
+  }
+
+  // ===== QUERIES =====
+  const Query queries[] = {
+      {"WRITE, not ADMIN", Permissions::WRITE, Permissions::ADMIN, false},
+      {"READ+WRITE, not DELETE", Permissions::READ | Permissions::WRITE, Permissions::DELETE,
+       false},
+      {"WRITE+EXECUTE+DELETE", Permissions::WRITE | Permissions::EXECUTE | Permissions::DELETE, 0,
+       false},
+      {"ADMIN", Permissions::ADMIN, 0, false},
+      {"DELETE or ADMIN, not EXECUTE", Permissions::DELETE | Permissions::ADMIN,
+       Permissions::EXECUTE, true},
+  };
+
+  std::printf("\n%-30s %12s %12s %12s %9s\n", "count query", "matches", "scan ms", "bitmap ms",
+              "speedup");
+  for (const Query &q : queries) {
+    size_t scan_count = 0;
+    auto scan = [&] {
+      scan_count = 0;
+      for (const Permissions &p : table) {
+        scan_count += matches(q, p);
+      }
+    };
+    size_t store_count = 0;
+    auto lookup = [&] {
+      store_count = q.any ? store.countAny(q.all, q.none) : store.count(q.all, q.none);
+    };
+    scan();
+    lookup();
+    if (scan_count != store_count) {
+      std::fprintf(stderr, "%s: scan found %zu, store %zu\n", q.name, scan_count, store_count);
+      ok = false;
+    }
+    const uint64_t scan_ns = bench::bestNs(principals, min_bytes, [&] {
+      scan();
+      bench::doNotOptimize(scan_count);
+    });
+    const uint64_t store_ns = bench::bestNs(principals, min_bytes, [&] {
+      lookup();
+      bench::doNotOptimize(store_count);
+    });
+    std::printf("%-30s %12zu %12.3f %12.3f %8.1fx\n", q.name, store_count, ms(scan_ns),
+                ms(store_ns), static_cast<double>(scan_ns) / static_cast<double>(store_ns));
+  }
+
+  // ===== LISTING IDS =====
+  // "WRITE, not ADMIN" as a list of IDs: push_back from the scan vs
+  // forEach over the result bitmap; the iterator must agree with both
+  const Query &q = queries[0];
+  std::vector<uint32_t> scanned;
+  std::vector<uint32_t> listed;
+  scanned.reserve(principals);
+  listed.reserve(principals);
+  const uint64_t scan_ns = bench::bestNs(principals, min_bytes, [&] {
+    scanned.clear();
+    for (size_t id = 0; id < principals; id++) {
+      if (matches(q, table[id])) {
+        scanned.push_back(static_cast<uint32_t>(id));
+      }
+    }
+  });
+  const uint64_t list_ns = bench::bestNs(principals, min_bytes, [&] {
+    listed.clear();
+    store.query(q.all, q.none).forEach([&](uint32_t id) { listed.push_back(id); });
+  });
+  const RoaringBitmap result = store.query(q.all, q.none);
+  if (listed != scanned || !std::equal(result.begin(), result.end(), scanned.begin(), scanned.end())) {
+    std::fprintf(stderr, "listing IDs: scan, forEach and iterator disagree\n");
+    ok = false;
+  }
+  std::printf("%-30s %12zu %12.3f %12.3f %8.1fx\n", "list IDs: WRITE, not ADMIN", listed.size(),
+              ms(scan_ns), ms(list_ns), static_cast<double>(scan_ns) / static_cast<double>(list_ns));
+
+  // ===== UPDATES =====
+  // Revoke WRITE from every 7th principal, drop every 1000th entirely,
+  // make every 5000th an admin - then both sides must still agree
+  for (size_t id = 0; id < principals; id += 7) {
+    table[id].revoke(Permissions::WRITE);
+    store.revoke(static_cast<uint32_t>(id), Permissions::WRITE);
+  }
+  for (size_t id = 0; id < principals; id += 1000) {
+    table[id].flags = 0;
+    store.remove(static_cast<uint32_t>(id));
+  }
+  for (size_t id = 3; id < principals; id += 5000) {
+    table[id].grant(Permissions::ADMIN);
+    store.grant(static_cast<uint32_t>(id), Permissions::ADMIN);
+  }
+  for (const Query &check : queries) {
+    const size_t expected = static_cast<size_t>(std::count_if(
+        table.begin(), table.end(), [&](Permissions p) { return matches(check, p); }));
+    const size_t got = check.any ? store.countAny(check.all, check.none)
+                                 : store.count(check.all, check.none);
+    if (expected != got) {
+      std::fprintf(stderr, "after updates, %s: scan %zu, store %zu\n", check.name, expected, got);
+      ok = false;
+    }
+  }
+  for (size_t id = 1; id < principals; id += principals / 97 + 1) {
+    if (store.get(static_cast<uint32_t>(id)).flags != table[id].flags) {
+      std::fprintf(stderr, "after updates, principal %zu has the wrong flags\n", id);
+      ok = false;
+    }
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+/*
+Popcount Benchmark
+Bitwise<>::countBits over 1 KB .. 1 GB buffers, every kernel in bit_kernels.hpp.
+
+Usage: popcount_bench [max_bytes]   (default 1 GB)
+
+Prints GB/s per kernel and size. Every kernel must return the same count as
+the others or the benchmark exits with an error. The byte-at-a-time kernels
+stop at 64 MB ("-" above that) - at 1 GB they would take minutes.
+*/
+
+#include "bench.hpp"
+#include "bit_kernels.hpp"
+#include "bitwise.hpp"
+#include "cpu_features.hpp"
+#include <cstdio>
+
+struct Kernel {
+  const char *name;
+  size_t (*fn)(std::span<const uint8_t>) noexcept;
+  bool available;
+  size_t max_bytes;
+};
+
+int main(int argc, char **argv) {
+  const size_t max_bytes = bench::maxSizeArg(argc, argv, size_t{1} << 30);
+  const size_t min_bytes_per_cell = size_t{64} << 20; // repeat small buffers
+  const size_t slow_limit = size_t{64} << 20;
+  const size_t no_limit = SIZE_MAX;
+
+  const Kernel kernels[] = {
+      {"bytewise", BitKernels::countBitsBytewise, true, slow_limit},
+      {"nibble LUT", BitKernels::countBitsNibbleLut, true, slow_limit},
+      {"words64", BitKernels::countBitsWords64, true, no_limit},
+      {"POPCNT", BitKernels::countBitsWords64Popcnt, CpuFeatures::hasPopcnt(), no_limit},
+      {"Harley-Seal", BitKernels::countBitsHarleySeal, CpuFeatures::hasAvx2(), no_limit},
+      {"countBits", Bitwise<>::countBits, true, no_limit},
+  };
+
+  std::printf("Bitwise<>::countBits(span) dispatches to: %s\n\n",
+              BitKernels::countBitsKernelName());
+  std::printf("%-8s", "size");
+  for (const Kernel &k : kernels) {
+    std::printf(" %12s", k.name);
+  }
+  std::printf("   (GB/s)\n");
+
+  std::vector<uint8_t> buffer = bench::randomBytes(max_bytes);
+  bool ok = true;
+
+  for (size_t size = 1024; size <= max_bytes; size *= 4) {
+    std::span<const uint8_t> bytes(buffer.data(), size);
+    char label[24];
+    std::printf("%-8s", bench::sizeLabel(size, label));
+
+    size_t expected = BitKernels::countBitsWords64(bytes);
+    for (const Kernel &k : kernels) {
+      if (!k.available || size > k.max_bytes) {
+        std::printf(" %12s", "-");
+        continue;
+      }
+      size_t result = 0;
+      uint64_t ns = bench::bestNs(size, min_bytes_per_cell, [&] {
+        result = k.fn(bytes);
+        bench::doNotOptimize(result);
+      });
+      if (result != expected) {
+        std::fprintf(stderr, "\n%s counted %zu bits, expected %zu\n", k.name, result, expected);
+        ok = false;
+      }
+      std::printf(" %12.2f", bench::gbPerSec(size, ns));
+      std::fflush(stdout);
+    }
+    std::printf("\n");
+    if (size > max_bytes / 4) {
+      break;
+    }
+  }
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
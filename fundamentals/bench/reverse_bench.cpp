@@ -0,0 +1,123 @@
+/*
+Bit Reversal Benchmark
+ByteOps::reverseBits over 1 KB .. 256 MB buffers, every kernel in bit_kernels.hpp,
+plus the single-value functions (byte loop, LUT, 16/32/64-bit words).
+
+Usage: reverse_bench [max_bytes]   (default 256 MB)
+
+Prints GB/s per kernel and size. Every kernel's output must match the
+constexpr loop byte for byte or the benchmark exits with an error.
+*/
+
+#include "bench.hpp"
+#include "bit_kernels.hpp"
+#include "bitwise.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+struct Kernel {
+  const char *name;
+  void (*fn)(std::span<const uint8_t>, std::span<uint8_t>) noexcept;
+  bool available;
+  size_t max_bytes;
+};
+
+// Throughput of a single-value function over a buffer of T words
+// (passed as a lambda so the call inlines)
+template <typename T, typename Fn>
+static void timeWords(const char *name, const std::vector<uint8_t> &buffer, Fn fn) {
+  const size_t count = buffer.size() / sizeof(T);
+  std::vector<T> words(count);
+  std::memcpy(words.data(), buffer.data(), count * sizeof(T));
+  uint64_t ns = bench::bestNs(buffer.size(), size_t{64} << 20, [&] {
+    T acc = 0;
+    for (size_t i = 0; i < count; i++) {
+      acc ^= fn(words[i]);
+    }
+    bench::doNotOptimize(acc);
+  });
+  std::printf("  %-16s %8.2f GB/s  %6.2f ns/value\n", name, bench::gbPerSec(buffer.size(), ns),
+              static_cast<double>(ns) / static_cast<double>(count));
+}
+
+int main(int argc, char **argv) {
+  const size_t max_bytes = bench::maxSizeArg(argc, argv, size_t{256} << 20);
+  const size_t min_bytes_per_cell = size_t{64} << 20;
+  const size_t slow_limit = size_t{64} << 20;
+  const size_t no_limit = SIZE_MAX;
+
+  const Kernel kernels[] = {
+      {"loop", BitKernels::reverseBitsLoop, true, slow_limit},
+      {"LUT", BitKernels::reverseBitsLut, true, no_limit},
+      {"words64", BitKernels::reverseBitsWords64, true, no_limit},
+      {"PSHUFB", BitKernels::reverseBitsPshufb, CpuFeatures::hasAvx2(), no_limit},
+      {"reverseBits", ByteOps::reverseBits, true, no_limit},
+  };
+
+  std::printf("ByteOps::reverseBits(span) dispatches to: %s\n\n",
+              BitKernels::reverseBitsKernelName());
+  std::printf("%-8s", "size");
+  for (const Kernel &k : kernels) {
+    std::printf(" %12s", k.name);
+  }
+  std::printf("   (GB/s)\n");
+
+  std::vector<uint8_t> src = bench::randomBytes(max_bytes);
+  std::vector<uint8_t> expected(max_bytes);
+  std::vector<uint8_t> dst(max_bytes);
+  BitKernels::reverseBitsLut(src, expected); // LUT == loop is a static_assert
+  bool ok = true;
+
+  for (size_t size = 1024; size <= max_bytes; size *= 4) {
+    std::span<const uint8_t> in(src.data(), size);
+    std::span<uint8_t> out(dst.data(), size);
+    char label[24];
+    std::printf("%-8s", bench::sizeLabel(size, label));
+
+    for (const Kernel &k : kernels) {
+      if (!k.available || size > k.max_bytes) {
+        std::printf(" %12s", "-");
+        continue;
+      }
+      std::memset(out.data(), 0, size);
+      uint64_t ns = bench::bestNs(size, min_bytes_per_cell, [&] {
+        k.fn(in, out);
+        bench::doNotOptimize(out[0]);
+      });
+      if (std::memcmp(out.data(), expected.data(), size) != 0) {
+        std::fprintf(stderr, "\n%s output differs from the constexpr loop\n", k.name);
+        ok = false;
+      }
+      std::printf(" %12.2f", bench::gbPerSec(size, ns));
+      std::fflush(stdout);
+    }
+    std::printf("\n");
+    if (size > max_bytes / 4) {
+      break;
+    }
+  }
+
+  // In place (src == dst) must work too: reverse twice gives the input back
+  const size_t round_trip_bytes = max_bytes < 4096 ? max_bytes : 4096;
+  std::vector<uint8_t> round_trip(src.begin(), src.begin() + round_trip_bytes);
+  ByteOps::reverseBits(round_trip);
+  ByteOps::reverseBits(round_trip);
+  if (!std::equal(round_trip.begin(), round_trip.end(), src.begin())) {
+    std::fprintf(stderr, "in-place reverseBits twice did not restore the input\n");
+    ok = false;
+  }
+
+  // Single values: one call per byte/word over a 4 MB buffer
+  const size_t word_bytes = max_bytes < (size_t{4} << 20) ? max_bytes : size_t{4} << 20;
+  std::vector<uint8_t> words(src.begin(), src.begin() + word_bytes);
+  std::printf("\nSingle-value functions over %zu KB:\n", words.size() >> 10);
+  timeWords<uint8_t>("reverseBits", words, [](uint8_t b) { return ByteOps::reverseBits(b); });
+  timeWords<uint8_t>("reverseBitsLut", words, [](uint8_t b) { return ByteOps::reverseBitsLut(b); });
+  timeWords<uint16_t>("reverseBits16", words, [](uint16_t w) { return ByteOps::reverseBits16(w); });
+  timeWords<uint32_t>("reverseBits32", words, [](uint32_t w) { return ByteOps::reverseBits32(w); });
+  timeWords<uint64_t>("reverseBits64", words, [](uint64_t w) { return ByteOps::reverseBits64(w); });
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,219 @@
+/*
+RGB Frame Benchmark
+dim, brighten, scale, blend and gamma over a 4K frame: one RGBColor call
+per pixel vs RGBFrame's scalar and AVX2 kernels, packed and planar, on one
+thread and on every core.
+
+Usage: rgb_frame_bench [pixels]   (default 3840 x 2160)
+
+Prints megapixels/s. Every variant must produce the same pixels as the
+per-pixel RGBColor version or the benchmark exits with an error.
+*/
+
+#include "bench.hpp"
+#include "cpu_features.hpp"
+#include "real_world.hpp"
+#include "rgb_frame.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+static constexpr uint16_t SCALE_FRACTION = 160; // 62.5%
+static constexpr uint16_t BLEND_ALPHA = 96;     // 37.5% of the overlay
+
+enum Op { DIM, BRIGHTEN, SCALE, BLEND, GAMMA, OP_COUNT };
+static const char *OP_NAMES[OP_COUNT] = {"dim", "brighten", "scale", "blend", "gamma"};
+
+// The per-pixel way: unpack with RGBColor, work per channel, repack
+static void perPixel(Op op, std::span<uint32_t> pixels, std::span<const uint32_t> overlay) {
+  for (size_t i = 0; i < pixels.size(); i++) {
+    const uint32_t p = pixels[i];
+    RGBColor c(static_cast<uint8_t>(p >> 16), static_cast<uint8_t>(p >> 8),
+               static_cast<uint8_t>(p));
+    switch (op) {
+    case DIM:
+      c.dim();
+      break;
+    case BRIGHTEN:
+      c.brighten();
+      break;
+    case SCALE:
+      c.setRed(static_cast<uint8_t>((c.getRed() * SCALE_FRACTION) >> 8));
+      c.setGreen(static_cast<uint8_t>((c.getGreen() * SCALE_FRACTION) >> 8));
+      c.setBlue(static_cast<uint8_t>((c.getBlue() * SCALE_FRACTION) >> 8));
+      break;
+    case BLEND: {
+      const RGBColor o(static_cast<uint8_t>(overlay[i] >> 16), static_cast<uint8_t>(overlay[i] >> 8),
+                       static_cast<uint8_t>(overlay[i]));
+      const unsigned keep = 256 - BLEND_ALPHA;
+      c.setRed(static_cast<uint8_t>((o.getRed() * BLEND_ALPHA + c.getRed() * keep) >> 8));
+      c.setGreen(static_cast<uint8_t>((o.getGreen() * BLEND_ALPHA + c.getGreen() * keep) >> 8));
+      c.setBlue(static_cast<uint8_t>((o.getBlue() * BLEND_ALPHA + c.getBlue() * keep) >> 8));
+      break;
+    }
+    default:
+      c.setRed(GAMMA_TABLE[c.getRed()]);
+      c.setGreen(GAMMA_TABLE[c.getGreen()]);
+      c.setBlue(GAMMA_TABLE[c.getBlue()]);
+      break;
+    }
+    pixels[i] = c.getValue();
+  }
+}
+
+static void runKernels(Op op, bool avx2, std::span<uint8_t> bytes, std::span<const uint8_t> overlay) {
+  switch (op) {
+  case DIM:
+    avx2 ? RGBKernels::dimAvx2(bytes) : RGBKernels::dimScalar(bytes);
+    break;
+  case BRIGHTEN:
+    avx2 ? RGBKernels::brightenAvx2(bytes) : RGBKernels::brightenScalar(bytes);
+    break;
+  case SCALE:
+    avx2 ? RGBKernels::scaleAvx2(bytes, SCALE_FRACTION)
+         : RGBKernels::scaleScalar(bytes, SCALE_FRACTION);
+    break;
+  case BLEND:
+    avx2 ? RGBKernels::blendAvx2(bytes, overlay, BLEND_ALPHA)
+         : RGBKernels::blendScalar(bytes, overlay, BLEND_ALPHA);
+    break;
+  default:
+    avx2 ? RGBKernels::gammaAvx2(bytes) : RGBKernels::gammaScalar(bytes);
+    break;
+  }
+}
+
+static void runFrame(Op op, RGBFrame &frame, const RGBFrame &overlay) {
+  switch (op) {
+  case DIM:
+    frame.dim();
+    break;
+  case BRIGHTEN:
+    frame.brighten();
+    break;
+  case SCALE:
+    frame.scale(SCALE_FRACTION);
+    break;
+  case BLEND:
+    frame.blend(overlay, BLEND_ALPHA);
+    break;
+  default:
+    frame.gamma();
+    break;
+  }
+}
+
+static bool samePixels(const RGBFrame &frame, std::span<const uint32_t> expected) {
+  for (size_t y = 0; y < frame.height(); y++) {
+    for (size_t x = 0; x < frame.width(); x++) {
+      if (frame.pixel(x, y) != expected[y * frame.width() + x]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const size_t requested = bench::maxSizeArg(argc, argv, size_t{3840} * 2160);
+  const size_t width = requested < 3840 ? (requested ? requested : 1) : 3840;
+  const size_t height = requested / width ? requested / width : 1;
+  const size_t pixels = width * height;
+  const size_t min_bytes = size_t{512} << 20;
+  const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  const bool has_avx2 = CpuFeatures::hasAvx2();
+  bool ok = true;
+
+  // Random source and overlay frames
+  RGBFrame source(width, height);
+  RGBFrame overlay(width, height);
+  bench::Rng rng;
+  for (size_t i = 0; i < pixels; i++) {
+    source.packed()[i] = static_cast<uint32_t>(rng.next()) & 0xFFFFFF;
+    overlay.packed()[i] = static_cast<uint32_t>(rng.next()) & 0xFFFFFF;
+  }
+  const RGBFrame source_planar = source.toPlanar();
+  const RGBFrame overlay_planar = overlay.toPlanar();
+
+  std::printf("%zu x %zu frame (%.1f MP), kernels: %s, %u core(s)\n\n", width, height,
+              static_cast<double>(pixels) / 1e6, RGBKernels::kernelName(), cores);
+  std::printf("%-9s %12s %12s %12s %12s %12s\n", "op", "RGBColor", "scalar", "AVX2",
+              "packed xN", "planar xN");
+
+  for (int o = 0; o < OP_COUNT; o++) {
+    const Op op = static_cast<Op>(o);
+    const size_t bytes = pixels * 4;
+    std::printf("%-9s", OP_NAMES[op]);
+
+    // Reference: one RGBColor per pixel. Timed runs keep working on the
+    // result (the frame drifts towards black or white), which only makes
+    // the branchy per-pixel code more predictable.
+    std::vector<uint32_t> expected(source.packed().begin(), source.packed().end());
+    perPixel(op, expected, overlay.packed());
+    {
+      std::vector<uint32_t> work = expected;
+      uint64_t ns = bench::bestNs(bytes, 0, [&] {
+        perPixel(op, work, overlay.packed());
+        bench::doNotOptimize(work[0]);
+      });
+      std::printf(" %12.1f", static_cast<double>(pixels) * 1e3 / static_cast<double>(ns));
+    }
+
+    for (int avx2 = 0; avx2 < 2; avx2++) {
+      if (avx2 && !has_avx2) {
+        std::printf(" %12s", "-");
+        continue;
+      }
+      RGBFrame frame = source;
+      runKernels(op, avx2, frame.channelBytes(), overlay.channelBytes());
+      if (!samePixels(frame, expected)) {
+        std::fprintf(stderr, "\n%s %s kernel differs from RGBColor\n", OP_NAMES[op],
+                     avx2 ? "AVX2" : "scalar");
+        ok = false;
+      }
+      uint64_t ns = bench::bestNs(bytes, min_bytes, [&] {
+        runKernels(op, avx2, frame.channelBytes(), overlay.channelBytes());
+        bench::doNotOptimize(frame.packed()[0]);
+      });
+      std::printf(" %12.1f", static_cast<double>(pixels) * 1e3 / static_cast<double>(ns));
+    }
+
+    // Whole-frame API (dispatched kernel) on every core, both layouts
+    const RGBFrame *sources[2] = {&source, &source_planar};
+    const RGBFrame *overlays[2] = {&overlay, &overlay_planar};
+    for (int planar = 0; planar < 2; planar++) {
+      RGBFrame frame = *sources[planar];
+      frame.setThreads(0);
+      runFrame(op, frame, *overlays[planar]);
+      if (!samePixels(frame, expected)) {
+        std::fprintf(stderr, "\n%s RGBFrame (%s) differs from RGBColor\n", OP_NAMES[op],
+                     planar ? "planar" : "packed");
+        ok = false;
+      }
+      uint64_t ns = bench::bestNs(frame.channelBytes().size(), min_bytes, [&] {
+        runFrame(op, frame, *overlays[planar]);
+        bench::doNotOptimize(frame.channelBytes()[0]);
+      });
+      std::printf(" %12.1f", static_cast<double>(pixels) * 1e3 / static_cast<double>(ns));
+    }
+    std::printf("   MP/s\n");
+    std::fflush(stdout);
+  }
+
+  // Layout round trip and thread-count independence
+  RGBFrame threaded = source;
+  threaded.setThreads(7);
+  threaded.gamma();
+  threaded.blend(overlay, BLEND_ALPHA);
+  RGBFrame single = source;
+  single.gamma();
+  single.blend(overlay, BLEND_ALPHA);
+  if (std::memcmp(threaded.packed().data(), single.packed().data(), pixels * 4) != 0 ||
+      !samePixels(source.toPlanar().toPacked(), source.packed())) {
+    std::fprintf(stderr, "thread split or layout round trip changed pixels\n");
+    ok = false;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
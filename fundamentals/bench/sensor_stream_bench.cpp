@@ -0,0 +1,228 @@
+/*
+SensorPacket Stream Benchmark
+1. Decode/encode 16M packets in memory: one SensorPacket at a time vs
+   SensorCodec's scalar and AVX2 batch kernels.
+2. Write a SensorLog file (default 1 GB), then map it and decode every
+   block - the gateway's "scan the whole history" path.
+
+Usage: sensor_stream_bench [file_bytes] [path]
+       (default 1 GB in the system temp directory; the file is removed)
+
+Prints packets/s. Every kernel must decode to the same columns and the
+scan must see every packet that was written, or the benchmark exits with
+an error. Reopen, torn-tail and failed-flush recovery are checked by
+tests/sensor_stream_test.cpp.
+*/
+
+#include "bench.hpp"
+#include "cpu_features.hpp"
+#include "sensor_stream.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using Layout = SensorCodec::Layout;
+
+static void printRate(const char *name, size_t packets, uint64_t ns) {
+  std::printf("  %-30s %8.1f M packets/s  %6.2f GB/s\n", name,
+              static_cast<double>(packets) * 1e3 / static_cast<double>(ns),
+              bench::gbPerSec(packets * sizeof(uint16_t), ns));
+}
+
+// Packets whose fields are all in range, so encode(decode(p)) == p
+static std::vector<uint16_t> randomPackets(size_t count, uint64_t seed) {
+  std::vector<uint16_t> packets(count);
+  bench::Rng rng(seed);
+  for (size_t i = 0; i < count; i++) {
+    packets[i] = static_cast<uint16_t>(rng.next());
+  }
+  return packets;
+}
+
+struct Columns {
+  std::vector<uint8_t> temps, humids, lights;
+  explicit Columns(size_t count) : temps(count), humids(count), lights(count) {}
+  Layout::Columns view() { return {temps, humids, lights}; }
+  Layout::ConstColumns constView() const { return {temps, humids, lights}; }
+  bool operator==(const Columns &) const = default;
+};
+
+static bool inMemory(size_t count) {
+  bool ok = true;
+  const size_t bytes = count * sizeof(uint16_t);
+  const size_t min_bytes = size_t{256} << 20;
+  const std::vector<uint16_t> packets = randomPackets(count, 1);
+
+  std::printf("In memory, %zu packets:\n", count);
+  Columns expected(count);
+  auto perPacket = [&] {
+    for (size_t i = 0; i < count; i++) {
+      const SensorPacket packet = SensorPacket::fromRaw(packets[i]);
+      expected.temps[i] = packet.getTemperature();
+      expected.humids[i] = packet.getHumidity();
+      expected.lights[i] = packet.getLight();
+    }
+  };
+  perPacket();
+  printRate("decode, getter per packet", count, bench::bestNs(bytes, min_bytes, [&] {
+              perPacket();
+              bench::doNotOptimize(expected.temps[0]);
+            }));
+
+  struct Decoder {
+    const char *name;
+    void (*fn)(std::span<const uint16_t>, const Layout::Columns &) noexcept;
+    bool available;
+  };
+  const Decoder decoders[] = {
+      {"decode, scalar (BitLayout)", SensorCodec::decodeScalar, true},
+      {"decode, AVX2", SensorCodec::decodeAvx2, CpuFeatures::hasAvx2()},
+      {"decode, dispatched", SensorCodec::decode, true},
+  };
+  for (const Decoder &d : decoders) {
+    if (!d.available) {
+      std::printf("  %-30s %19s\n", d.name, "-");
+      continue;
+    }
+    Columns out(count);
+    d.fn(packets, out.view());
+    if (!(out == expected)) {
+      std::fprintf(stderr, "%s differs from the SensorPacket getters\n", d.name);
+      ok = false;
+    }
+    printRate(d.name, count, bench::bestNs(bytes, min_bytes, [&] {
+                d.fn(packets, out.view());
+                bench::doNotOptimize(out.temps[0]);
+              }));
+  }
+
+  struct Encoder {
+    const char *name;
+    void (*fn)(const Layout::ConstColumns &, std::span<uint16_t>) noexcept;
+    bool available;
+  };
+  const Encoder encoders[] = {
+      {"encode, scalar (BitLayout)", SensorCodec::encodeScalar, true},
+      {"encode, AVX2", SensorCodec::encodeAvx2, CpuFeatures::hasAvx2()},
+  };
+  for (const Encoder &e : encoders) {
+    if (!e.available) {
+      std::printf("  %-30s %19s\n", e.name, "-");
+      continue;
+    }
+    std::vector<uint16_t> out(count);
+    e.fn(expected.constView(), out);
+    if (out != packets) {
+      std::fprintf(stderr, "%s does not reproduce the packets\n", e.name);
+      ok = false;
+    }
+    printRate(e.name, count, bench::bestNs(bytes, min_bytes, [&] {
+                e.fn(expected.constView(), out);
+                bench::doNotOptimize(out[0]);
+              }));
+  }
+  return ok;
+}
+
+// Write `file_bytes` of log, then scan it with the reader
+static bool fileScan(const std::string &path, size_t file_bytes) {
+  bool ok = true;
+  const size_t blocks = file_bytes / SensorLog::BLOCK_BYTES;
+  const size_t packets_total = blocks * SensorLog::PACKETS_PER_BLOCK;
+
+  // One chunk of packets, appended over and over with a changing timestamp
+  const std::vector<uint16_t> chunk = randomPackets(SensorLog::PACKETS_PER_BLOCK * 64, 2);
+  uint64_t chunk_temp_sum = 0;
+  for (uint16_t p : chunk) {
+    chunk_temp_sum += Layout::get<SensorPacket::TEMPERATURE>(p);
+  }
+
+  std::remove(path.c_str());
+  SensorLogWriter writer;
+  if (!writer.open(path.c_str())) {
+    std::perror(path.c_str());
+    return false;
+  }
+  uint64_t written = 0;
+  uint64_t expected_temp_sum = 0;
+  uint64_t t0 = bench::nowNs();
+  while (written < packets_total) {
+    size_t n = std::min<size_t>(chunk.size(), packets_total - written);
+    if (!writer.append(std::span<const uint16_t>(chunk.data(), n), written)) {
+      std::perror("append");
+      return false;
+    }
+    if (n == chunk.size()) {
+      expected_temp_sum += chunk_temp_sum;
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        expected_temp_sum += Layout::get<SensorPacket::TEMPERATURE>(chunk[i]);
+      }
+    }
+    written += n;
+  }
+  if (!writer.close()) {
+    std::perror("close");
+    return false;
+  }
+  uint64_t write_ns = bench::nowNs() - t0;
+
+  char label[24];
+  std::printf("\nSensorLog file, %s (%zu blocks of %u packets):\n",
+              bench::sizeLabel(file_bytes, label), blocks, SensorLog::PACKETS_PER_BLOCK);
+  printRate("append + write", packets_total, write_ns);
+
+  SensorLogReader reader;
+  if (!reader.open(path.c_str())) {
+    std::perror(path.c_str());
+    return false;
+  }
+  if (reader.blockCount() != blocks || reader.packetCount() != packets_total) {
+    std::fprintf(stderr, "reader sees %zu blocks / %llu packets, wrote %zu / %zu\n",
+                 reader.blockCount(), static_cast<unsigned long long>(reader.packetCount()),
+                 blocks, packets_total);
+    ok = false;
+  }
+
+  // Scan: decode every block in place into one block-sized set of columns
+  Columns columns(SensorLog::PACKETS_PER_BLOCK);
+  uint64_t temp_sum = 0;
+  auto scan = [&] {
+    temp_sum = 0;
+    reader.forEachBlock([&](const SensorLogReader::Block &block) {
+      SensorCodec::decode(block.packets, columns.view());
+      for (size_t i = 0; i < block.packets.size(); i++) {
+        temp_sum += columns.temps[i];
+      }
+    });
+  };
+  scan(); // also faults the mapping in
+  if (temp_sum != expected_temp_sum) {
+    std::fprintf(stderr, "scan temperature sum %llu, expected %llu\n",
+                 static_cast<unsigned long long>(temp_sum),
+                 static_cast<unsigned long long>(expected_temp_sum));
+    ok = false;
+  }
+  printRate("mmap scan + decode (warm)", packets_total,
+            bench::bestNs(file_bytes, 3 * file_bytes, [&] {
+              scan();
+              bench::doNotOptimize(temp_sum);
+            }));
+  reader.close();
+  std::remove(path.c_str());
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  const size_t file_bytes = bench::maxSizeArg(argc, argv, size_t{1} << 30);
+  const std::string path =
+      argc > 2 ? argv[2]
+               : (std::filesystem::temp_directory_path() / "sensor_stream_bench.spk").string();
+  std::printf("SensorCodec dispatches to: %s\n\n", SensorCodec::kernelName());
+
+  bool ok = inMemory(size_t{16} << 20);
+  ok = fileScan(path, file_bytes) && ok;
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+/*
+TCP Capture Benchmark
+Writes a large pcap of synthetic traffic (tests/pcap_fixtures.hpp), then
+classifies it: one TCPFlags per packet vs TCPFlagClassifier's extracted
+column, and the column kernels on their own.
+
+Usage: tcp_capture_bench [packets] [path]
+       (default 4M packets in the system temp directory; the file is removed)
+
+Prints packets/s. Correctness (every link type, byte order, torn files,
+scalar vs AVX2) is covered by tests/tcp_capture_test.cpp.
+*/
+
+#include "../tests/pcap_fixtures.hpp"
+#include "bench.hpp"
+#include "tcp_capture.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+using namespace pcap_fixtures;
+
+static void printRate(const char *name, size_t packets, uint64_t ns) {
+  std::printf("  %-36s %8.1f M packets/s\n", name,
+              static_cast<double>(packets) * 1e3 / static_cast<double>(ns));
+}
+
+int main(int argc, char **argv) {
+  const size_t packets = bench::maxSizeArg(argc, argv, 4'000'000);
+  const std::string dir = argc > 2 ? argv[2] : std::filesystem::temp_directory_path().string();
+  const std::string path = dir + "/tcp_capture_bench.pcap";
+
+  FixtureWriter writer(path, Pcap::LINK_ETHERNET, false, false);
+  if (!writer.file) {
+    std::perror(path.c_str());
+    return EXIT_FAILURE;
+  }
+  writeTraffic(writer, packets, 1);
+  if (!writer.close()) {
+    std::perror(path.c_str());
+    return EXIT_FAILURE;
+  }
+  const TCPFlagReport &written = writer.expected;
+
+  PcapReader reader;
+  if (!reader.open(path.c_str())) {
+    std::perror(path.c_str());
+    return EXIT_FAILURE;
+  }
+  const size_t file_bytes = static_cast<size_t>(std::filesystem::file_size(path));
+  std::printf("%zu packets, %.1f MB capture, %llu TCP segments, match kernel: %s\n\n", packets,
+              static_cast<double>(file_bytes) / (1 << 20),
+              static_cast<unsigned long long>(written.tcp_segments), TCPFlagKernels::kernelName());
+
+  // One TCPFlags per packet: parse, then ask each question separately
+  TCPFlagReport per_packet;
+  auto perPacket = [&] {
+    per_packet = {};
+    const uint32_t link = reader.linkType();
+    per_packet.records = reader.forEachRecord([&](const PcapReader::Record &record) {
+      const int flags = TCPFlagKernels::tcpFlags(record.data, link);
+      if (flags < 0) {
+        return;
+      }
+      TCPFlags tcp;
+      tcp.setFlag(static_cast<uint8_t>(flags));
+      per_packet.tcp_segments++;
+      per_packet.histogram[tcp.flags]++;
+      per_packet.patterns[0] += tcp.isSet(TCPFlags::SYN) && !tcp.isSet(TCPFlags::ACK);
+      per_packet.patterns[1] += tcp.isSYNACK();
+      per_packet.patterns[2] += tcp.isFINACK();
+      per_packet.patterns[3] += tcp.isSet(TCPFlags::FIN) && !tcp.isSet(TCPFlags::ACK);
+      per_packet.patterns[4] += tcp.isSet(TCPFlags::RST);
+    });
+  };
+  printRate("TCPFlags per packet (mmap)", packets, bench::bestNs(file_bytes, 4 * file_bytes, [&] {
+              perPacket();
+              bench::doNotOptimize(per_packet.records);
+            }));
+
+  TCPFlagClassifier classifier;
+  printRate("TCPFlagClassifier (mmap)", packets, bench::bestNs(file_bytes, 4 * file_bytes, [&] {
+              classifier.reset();
+              classifier.addCapture(reader);
+              bench::doNotOptimize(classifier.report().records);
+            }));
+
+  // The column part alone: extracted flags, scalar vs AVX2 matching
+  std::vector<uint8_t> column;
+  column.reserve(written.tcp_segments);
+  reader.forEachRecord([&](const PcapReader::Record &record) {
+    const int flags = TCPFlagKernels::tcpFlags(record.data, reader.linkType());
+    if (flags >= 0) {
+      column.push_back(static_cast<uint8_t>(flags));
+    }
+  });
+  std::vector<uint64_t> bits((column.size() + 63) / 64);
+  std::printf("\n  flags column only (%zu segments):\n", column.size());
+  printRate("histogram", column.size(), bench::bestNs(column.size(), size_t{1} << 30, [&] {
+              std::array<uint64_t, 256> bins{};
+              TCPFlagKernels::histogram(column, bins);
+              bench::doNotOptimize(bins);
+            }));
+  printRate("5 patterns, scalar", column.size(), bench::bestNs(column.size(), size_t{1} << 30, [&] {
+              for (const TCPFlagPattern &pattern : TCP_FLAG_PATTERNS) {
+                bench::doNotOptimize(TCPFlagKernels::matchScalar(column, pattern, bits));
+              }
+            }));
+  printRate("5 patterns, AVX2", column.size(), bench::bestNs(column.size(), size_t{1} << 30, [&] {
+              for (const TCPFlagPattern &pattern : TCP_FLAG_PATTERNS) {
+                bench::doNotOptimize(TCPFlagKernels::matchAvx2(column, pattern, bits));
+              }
+            }));
+
+  const TCPFlagReport &report = classifier.report();
+  std::printf("\n  %-14s %10s\n", "pattern", "segments");
+  for (size_t p = 0; p < TCP_FLAG_PATTERNS.size(); p++) {
+    std::printf("  %-14s %10llu\n", TCP_FLAG_PATTERNS[p].name,
+                static_cast<unsigned long long>(report.patterns[p]));
+  }
+
+  reader.close();
+  std::remove(path.c_str());
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,320 @@
+/*
+Virtual MCU Benchmark
+The same two sketches written three ways - Arduino calls, direct port
+manipulation, batched AVRTransactions - run on VirtualAVR: simulated
+cycles on a 16 MHz ATmega328P, and how fast the host simulates them.
+
+  shiftOut     bit-bang bytes MSB first, data pin 11 (PB3), clock pin 13 (PB5)
+  multiplex    4-digit 7-segment display: segments on pins 0..7 (PORTD),
+               digit enables on pins 8..11 (PB0..PB3)
+
+Usage: virtual_mcu_bench [bytes]   (default 1048576; multiplex runs bytes/4 frames)
+
+A traced prefix of every run is replayed from the register trace: the
+bytes must come back out on the clock's rising edges, and the display
+must light exactly the expected (digit, segments) sequence with no wrong
+segments on a lit digit. The cycle totals must match the cost table.
+Any mismatch exits with an error.
+*/
+
+#include "bench.hpp"
+#include "virtual_mcu.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+static constexpr uint8_t DATA_PIN = 11;
+static constexpr uint8_t CLOCK_PIN = 13;
+static constexpr uint8_t DATA = VirtualAVR::arduinoPin(DATA_PIN).mask;
+static constexpr uint8_t CLOCK = VirtualAVR::arduinoPin(CLOCK_PIN).mask;
+static constexpr uint8_t DIGITS = 0x0F; // PB0..PB3
+
+// Segments a..g on bits 0..6, common cathode
+static constexpr std::array<uint8_t, 16> SEGMENTS = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71,
+};
+
+static uint8_t digitPattern(size_t frame, unsigned digit) {
+  return SEGMENTS[(frame >> (4 * digit)) & 0xF];
+}
+
+// ===== SHIFTOUT =====
+
+static void shiftOutArduino(VirtualAVR &avr, std::span<const uint8_t> bytes) {
+  for (uint8_t byte : bytes) {
+    for (int bit = 7; bit >= 0; bit--) {
+      avr.digitalWrite(DATA_PIN, (byte >> bit) & 1);
+      avr.digitalWrite(CLOCK_PIN, true);
+      avr.digitalWrite(CLOCK_PIN, false);
+    }
+  }
+}
+
+static void shiftOutDirect(VirtualAVR &avr, std::span<const uint8_t> bytes) {
+  for (uint8_t byte : bytes) {
+    for (int bit = 7; bit >= 0; bit--) {
+      if ((byte >> bit) & 1) {
+        avr.setHigh(AVRPort::B, DATA);
+      } else {
+        avr.setLow(AVRPort::B, DATA);
+      }
+      avr.toggle(AVRPort::B, CLOCK); // PINB = CLOCK: rising edge
+      avr.toggle(AVRPort::B, CLOCK);
+    }
+  }
+}
+
+// DATA sampled on every rising edge of CLOCK in the PORTB trace
+static std::vector<uint8_t> shiftedBytes(const std::vector<AVRTraceEntry> &trace) {
+  std::vector<uint8_t> bytes;
+  unsigned bits = 0;
+  uint8_t current = 0;
+  for (const AVRTraceEntry &e : trace) {
+    if (e.port != AVRPort::B || e.reg != AVRRegister::PORT || (e.before & CLOCK) ||
+        !(e.after & CLOCK)) {
+      continue;
+    }
+    current = static_cast<uint8_t>((current << 1) | ((e.after & DATA) != 0));
+    if (++bits % 8 == 0) {
+      bytes.push_back(current);
+    }
+  }
+  return bytes;
+}
+
+// ===== MULTIPLEX =====
+
+static void multiplexArduino(VirtualAVR &avr, size_t frames) {
+  for (size_t f = 0; f < frames; f++) {
+    for (unsigned d = 0; d < 4; d++) {
+      for (uint8_t pin = 8; pin < 12; pin++) {
+        avr.digitalWrite(pin, false);
+      }
+      const uint8_t pattern = digitPattern(f, d);
+      for (uint8_t seg = 0; seg < 8; seg++) {
+        avr.digitalWrite(seg, (pattern >> seg) & 1);
+      }
+      avr.digitalWrite(static_cast<uint8_t>(8 + d), true);
+    }
+  }
+}
+
+static void multiplexDirect(VirtualAVR &avr, size_t frames) {
+  for (size_t f = 0; f < frames; f++) {
+    for (unsigned d = 0; d < 4; d++) {
+      avr.setLow(AVRPort::B, DIGITS); // blank first, or the old digit
+      avr.write(AVRPort::D, digitPattern(f, d)); // shows the new pattern
+      avr.setHigh(AVRPort::B, static_cast<uint8_t>(1 << d));
+    }
+  }
+}
+
+// No blanking needed: digit and segments switch on the same cycle
+static void multiplexBatched(VirtualAVR &avr, size_t frames) {
+  AVRTransaction next;
+  for (size_t f = 0; f < frames; f++) {
+    for (unsigned d = 0; d < 4; d++) {
+      next.clear();
+      next.setLow(AVRPort::B, DIGITS)
+          .setHigh(AVRPort::B, static_cast<uint8_t>(1 << d))
+          .write(AVRPort::D, digitPattern(f, d));
+      avr.apply(next);
+    }
+  }
+}
+
+struct DisplayReplay {
+  std::vector<std::pair<uint8_t, uint8_t>> lit; // (digit enables, segments), each new one
+  size_t ghosts = 0; // cycles where a lit digit showed segments that aren't its own
+};
+
+// Writes landing on the same cycle are one visible state
+static DisplayReplay replayDisplay(const std::vector<AVRTraceEntry> &trace, size_t frames) {
+  DisplayReplay replay;
+  uint8_t portb = 0;
+  uint8_t portd = 0;
+  size_t expected = 0; // index into the (frame, digit) sequence
+  for (size_t i = 0; i < trace.size(); i++) {
+    const AVRTraceEntry &e = trace[i];
+    if (e.reg == AVRRegister::PORT) {
+      (e.port == AVRPort::B ? portb : portd) = e.after;
+    }
+    if (i + 1 < trace.size() && trace[i + 1].cycle == e.cycle) {
+      continue;
+    }
+    const uint8_t digits = portb & DIGITS;
+    if (digits == 0) {
+      continue;
+    }
+    const std::pair<uint8_t, uint8_t> state{digits, portd};
+    if (!replay.lit.empty() && replay.lit.back() == state) {
+      continue;
+    }
+    const size_t f = expected / 4;
+    const unsigned d = expected % 4;
+    if (f >= frames || digits != (1 << d) || portd != digitPattern(f, d)) {
+      replay.ghosts++;
+    }
+    replay.lit.push_back(state);
+    expected++;
+  }
+  return replay;
+}
+
+// ===== RUNNER =====
+
+struct Style {
+  const char *name;
+  void (*setup)(VirtualAVR &);
+  void (*run)(VirtualAVR &, size_t units, std::span<const uint8_t> bytes);
+  uint64_t expected_cycles_per_unit; // from the cost table
+};
+
+struct Result {
+  uint64_t cycles = 0;
+  size_t changes = 0;
+  std::vector<AVRTraceEntry> trace;
+  double mops = 0;
+};
+
+static Result measure(const Style &style, size_t traced_units, size_t units,
+                      std::span<const uint8_t> bytes, size_t min_ops) {
+  Result result;
+  VirtualAVR avr;
+  style.setup(avr);
+  avr.setTracing(true);
+  avr.clearTrace();
+  const uint64_t c0 = avr.cycles();
+  style.run(avr, traced_units, bytes.first(std::min(traced_units, bytes.size())));
+  result.cycles = avr.cycles() - c0;
+  result.trace = avr.trace();
+  result.changes = result.trace.size();
+
+  avr.setTracing(false);
+  const uint64_t ops0 = avr.operations();
+  style.run(avr, units, bytes);
+  const uint64_t ops_per_run = avr.operations() - ops0;
+  const uint64_t ns = bench::bestNs(ops_per_run, min_ops, [&] { style.run(avr, units, bytes); });
+  result.mops = static_cast<double>(ops_per_run) * 1e3 / static_cast<double>(ns);
+  return result;
+}
+
+static void printRow(const Style &style, const Result &r, size_t traced_units) {
+  const double per = static_cast<double>(r.cycles) / static_cast<double>(traced_units);
+  std::printf("  %-14s %10.1f %12.2f %14.1f %12.1f\n", style.name, per,
+              per * 1e6 / VirtualAVR::CLOCK_HZ,
+              static_cast<double>(r.changes) / static_cast<double>(traced_units), r.mops);
+}
+
+static bool checkCycles(const Style &style, const Result &r, size_t traced_units) {
+  const uint64_t expected = style.expected_cycles_per_unit * traced_units;
+  if (r.cycles != expected) {
+    std::fprintf(stderr, "%s: %llu cycles, cost table says %llu\n", style.name,
+                 static_cast<unsigned long long>(r.cycles),
+                 static_cast<unsigned long long>(expected));
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const size_t bytes_count = bench::maxSizeArg(argc, argv, size_t{1} << 20);
+  const size_t frames = bytes_count / 4 ? bytes_count / 4 : 1;
+  const size_t min_ops = size_t{64} << 20;
+  const AVRCycleCosts costs;
+  bool ok = true;
+
+  const std::vector<uint8_t> bytes = bench::randomBytes(bytes_count, 50);
+
+  // ===== SHIFTOUT =====
+  const Style shift_styles[] = {
+      {"digitalWrite",
+       [](VirtualAVR &avr) {
+         avr.pinMode(DATA_PIN, PinMode::OUTPUT);
+         avr.pinMode(CLOCK_PIN, PinMode::OUTPUT);
+       },
+       [](VirtualAVR &avr, size_t, std::span<const uint8_t> b) { shiftOutArduino(avr, b); },
+       8 * 3 * uint64_t{costs.digital_write}},
+      {"direct port",
+       [](VirtualAVR &avr) { avr.setOutputs(AVRPort::B, DATA | CLOCK); },
+       [](VirtualAVR &avr, size_t, std::span<const uint8_t> b) { shiftOutDirect(avr, b); },
+       8 * (uint64_t{costs.sbi_cbi} + 2 * costs.out)},
+  };
+  const size_t traced_bytes = std::min<size_t>(bytes_count, 4096);
+
+  std::printf("shiftOut: %zu bytes MSB first, %u MHz\n", bytes_count, VirtualAVR::CLOCK_HZ / 1000000);
+  std::printf("  %-14s %10s %12s %14s %12s\n", "style", "cycles/B", "us/B", "changes/B",
+              "host Mops/s");
+  for (const Style &style : shift_styles) {
+    const Result r = measure(style, traced_bytes, bytes_count, bytes, min_ops);
+    printRow(style, r, traced_bytes);
+    ok &= checkCycles(style, r, traced_bytes);
+    const std::vector<uint8_t> out = shiftedBytes(r.trace);
+    if (out.size() != traced_bytes || !std::equal(out.begin(), out.end(), bytes.begin())) {
+      std::fprintf(stderr, "%s: %zu bytes shifted out don't match what was sent\n", style.name,
+                   out.size());
+      ok = false;
+    }
+  }
+
+  // ===== MULTIPLEX =====
+  auto setupDirect = [](VirtualAVR &avr) {
+    avr.setDirection(AVRPort::D, 0xFF);
+    avr.setOutputs(AVRPort::B, DIGITS);
+  };
+  const Style mux_styles[] = {
+      {"digitalWrite",
+       [](VirtualAVR &avr) {
+         for (uint8_t pin = 0; pin < 12; pin++) {
+           avr.pinMode(pin, PinMode::OUTPUT);
+         }
+       },
+       [](VirtualAVR &avr, size_t n, std::span<const uint8_t>) { multiplexArduino(avr, n); },
+       4 * 13 * uint64_t{costs.digital_write}},
+      {"direct port", setupDirect,
+       [](VirtualAVR &avr, size_t n, std::span<const uint8_t>) { multiplexDirect(avr, n); },
+       4 * (uint64_t{costs.in} + costs.alu + costs.out + costs.out + costs.sbi_cbi)},
+      {"transaction", setupDirect,
+       [](VirtualAVR &avr, size_t n, std::span<const uint8_t>) { multiplexBatched(avr, n); },
+       4 * (uint64_t{costs.atomic} + costs.in + 2 * costs.alu + costs.out + costs.out)},
+  };
+  const size_t traced_frames = std::min<size_t>(frames, 1024);
+
+  std::printf("\nmultiplex: %zu frames of 4 digits\n", frames);
+  std::printf("  %-14s %10s %12s %14s %12s\n", "style", "cycles/fr", "us/frame", "changes/frame",
+              "host Mops/s");
+  for (const Style &style : mux_styles) {
+    const Result r = measure(style, traced_frames, frames, {}, min_ops);
+    printRow(style, r, traced_frames);
+    ok &= checkCycles(style, r, traced_frames);
+    const DisplayReplay replay = replayDisplay(r.trace, traced_frames);
+    if (replay.ghosts || replay.lit.size() != 4 * traced_frames) {
+      std::fprintf(stderr, "%s: %zu lit states (want %zu), %zu showing the wrong segments\n",
+                   style.name, replay.lit.size(), 4 * traced_frames, replay.ghosts);
+      ok = false;
+    }
+  }
+
+  // ===== INPUTS =====
+  // A button on pin 2 (PD2) to ground: pull-up reads high until pressed
+  VirtualAVR avr;
+  avr.pinMode(2, PinMode::INPUT_PULLUP);
+  const bool idle = avr.digitalRead(2);
+  avr.drive(AVRPort::D, 1 << 2, 0);
+  const bool pressed = avr.digitalRead(2);
+  avr.release(AVRPort::D, 1 << 2);
+  const bool released = avr.digitalRead(2);
+  avr.pinMode(2, PinMode::OUTPUT); // an output ignores the outside level
+  avr.drive(AVRPort::D, 1 << 2, 0);
+  avr.digitalWrite(2, true);
+  const bool output = (avr.read(AVRPort::D) >> 2) & 1;
+  if (!idle || pressed || !released || !output || avr.digitalRead(20)) {
+    std::fprintf(stderr, "inputs: pull-up %d, pressed %d, released %d, output %d\n", idle,
+                 pressed, released, output);
+    ok = false;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
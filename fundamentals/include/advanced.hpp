@@ -4,6 +4,7 @@ Advanced C++ - Keyword Combinations
 
 #pragma once
 
+#include <concepts>
 #include <cstdint>
 
 // ===== CONSTEXPR VARIABLES =====
@@ -81,9 +82,9 @@ public:
   // USE CASE: Modify state but allow compile-time evaluation when possible
   constexpr void digitalWrite(uint8_t pin, bool value) noexcept {
     if (value) {
-      pins |= (1 << pin); // Set bit
+      pins |= (uint64_t{1} << pin); // Set bit (64-bit 1: plain 1 is an int)
     } else {
-      pins &= ~(1 << pin); // Clear bit
+      pins &= ~(uint64_t{1} << pin); // Clear bit
     }
   }
 
@@ -99,7 +100,7 @@ public:
 
   // const: Only reads member variables, doesn't modify
   constexpr bool isPinHigh(uint8_t pin) const noexcept {
-    return (pins & (1 << pin)) != 0;
+    return (pins & (uint64_t{1} << pin)) != 0;
   }
 
   // inline: Small getter functions - avoid function call overhead
@@ -230,31 +231,33 @@ MICROCONTROLLER TIPS:
 
 // ===== STATIC FUNCTIONS =====
 
+template <std::unsigned_integral T = uint8_t>
 class BitManipulation {
 public:
   // STATIC MEMBER FUNCTION
-  // - No object needed, call with BitManipulation::setBit(...)
+  // - No object needed, call with BitManipulation<>::setBit(...)
+  //   (BitManipulation<uint32_t>::setBit(...) for a 32-bit value)
   // - Can't access member variables (no 'this' pointer)
   // - USE CASE: Utility functions that don't need object state
-  static constexpr uint8_t setBit(uint8_t byte, uint8_t bit) noexcept {
-    return byte | (1 << bit);
+  static constexpr T setBit(T value, uint8_t bit) noexcept {
+    return value | static_cast<T>(T{1} << bit);
   }
 
-  static constexpr uint8_t clearBit(uint8_t byte, uint8_t bit) noexcept {
-    return byte & ~(1 << bit);
+  static constexpr T clearBit(T value, uint8_t bit) noexcept {
+    return value & static_cast<T>(~(T{1} << bit));
   }
 
-  static constexpr uint8_t toggleBit(uint8_t byte, uint8_t bit) noexcept {
-    return byte ^ (1 << bit);
+  static constexpr T toggleBit(T value, uint8_t bit) noexcept {
+    return value ^ static_cast<T>(T{1} << bit);
   }
 
-  static constexpr bool isBitSet(uint8_t byte, uint8_t bit) noexcept {
-    return (byte & (1 << bit)) != 0;
+  static constexpr bool isBitSet(T value, uint8_t bit) noexcept {
+    return (value & static_cast<T>(T{1} << bit)) != 0;
   }
 
   // STATIC + CONSTEXPR CONSTANT
-  static constexpr uint8_t ALL_BITS_SET = 0xFF;
-  static constexpr uint8_t NO_BITS_SET = 0x00;
+  static constexpr T ALL_BITS_SET = static_cast<T>(~T{0});
+  static constexpr T NO_BITS_SET = 0;
 };
 
 class Arduino {
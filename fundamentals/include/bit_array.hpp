@@ -0,0 +1,112 @@
+/*
+BitArray - Dynamic Bit Container
+Any number of bits packed into 64-bit words: set/clear/test one bit, or
+AND/OR/XOR/count whole arrays a word (or 256 bits with AVX2) at a time.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ===== BIT ARRAY =====
+// Like std::vector<bool>, but the words are exposed and the bulk operations
+// never touch bits one at a time:
+//
+//   bit i  →  words[i / 64], bit (i % 64)
+//
+//   set/clear/toggle/test   one shift + one AND/OR/XOR on a word
+//   count()                 BitKernels::countBits over the raw bytes
+//   findFirstSet(from)      skip zero words, then std::countr_zero
+//   &=, |=, ^=              BitKernels::applyWords (AVX2 when available)
+//
+// Bits past size() in the last word are always kept at 0, so count() and
+// findFirstSet() never see garbage and == can compare whole words.
+//
+// USE CASE: Status bitmaps, free-lists, sets of small integers
+// (sensor IDs, pixel masks) that are too big for one uint64_t.
+
+class BitArray {
+public:
+  static constexpr size_t WORD_BITS = 64;
+
+  // Returned by findFirstSet when no bit is set
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  BitArray() = default;
+  explicit BitArray(size_t bits, bool value = false);
+
+  size_t size() const noexcept { return bits; }
+  bool empty() const noexcept { return bits == 0; }
+
+  // Grow with 0 bits or shrink (dropped bits are gone)
+  void resize(size_t new_bits);
+
+  // ===== SINGLE BITS =====
+  // No bounds checks, like operator[] on a vector: index must be < size()
+  void set(size_t index) noexcept { words[index / WORD_BITS] |= mask(index); }
+  void clear(size_t index) noexcept { words[index / WORD_BITS] &= ~mask(index); }
+  void toggle(size_t index) noexcept { words[index / WORD_BITS] ^= mask(index); }
+
+  bool test(size_t index) const noexcept {
+    return (words[index / WORD_BITS] & mask(index)) != 0;
+  }
+
+  void assign(size_t index, bool value) noexcept {
+    value ? set(index) : clear(index);
+  }
+
+  // ===== WHOLE ARRAY =====
+  void setAll() noexcept;
+  void clearAll() noexcept;
+
+  // Number of 1 bits
+  size_t count() const noexcept;
+
+  // Index of the first 1 bit at or after `from`, or npos
+  size_t findFirstSet(size_t from = 0) const noexcept;
+
+  // Element-wise with another array of the same size, bits paired by
+  // index. A size mismatch asserts in debug builds; otherwise bits `other`
+  // doesn't have count as 0 and the rest of `other` is ignored.
+  BitArray &operator&=(const BitArray &other) noexcept;
+  BitArray &operator|=(const BitArray &other) noexcept;
+  BitArray &operator^=(const BitArray &other) noexcept;
+
+  // `return a &= b;` would return a reference and copy the whole array
+  // again; returning the parameter by name moves it out
+  friend BitArray operator&(BitArray a, const BitArray &b) noexcept {
+    a &= b;
+    return a;
+  }
+  friend BitArray operator|(BitArray a, const BitArray &b) noexcept {
+    a |= b;
+    return a;
+  }
+  friend BitArray operator^(BitArray a, const BitArray &b) noexcept {
+    a ^= b;
+    return a;
+  }
+
+  bool operator==(const BitArray &other) const noexcept = default;
+
+  // Raw storage, least significant bit of word 0 = bit 0
+  std::span<const uint64_t> data() const noexcept { return words; }
+
+private:
+  static constexpr uint64_t mask(size_t index) noexcept {
+    return uint64_t{1} << (index % WORD_BITS); // 64-bit 1: (1 << 40) would overflow an int
+  }
+
+  static constexpr size_t wordsFor(size_t bits) noexcept {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  // Zero the unused high bits of the last word
+  void trimTail() noexcept;
+
+  std::vector<uint64_t> words;
+  size_t bits = 0;
+};
@@ -0,0 +1,90 @@
+/*
+Bulk Bit Kernels
+The loops behind the buffer-level Bitwise functions and BitArray.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// ===== POPULATION COUNT OVER A BUFFER =====
+// countBits(span) picks one of these once, at first use:
+//
+//   AVR            nibbleLut   16-byte table, 2 lookups per byte
+//   x86 + AVX2     harleySeal  carry-save adders over 16 x 32-byte blocks,
+//                              one real popcount per 512 bytes (POPCNT
+//                              words under 64 bytes)
+//   x86 + POPCNT   words64Popcnt  one POPCNT instruction per 8 bytes
+//   anything else  words64     std::popcount on 8-byte words
+//
+// All of them return exactly the sum of Bitwise<>::countBits(byte) over every
+// byte. They are public so the benchmark can time each one directly.
+
+class BitKernels {
+public:
+  // Dispatching entry point behind Bitwise<T>::countBits(span) and BitArray::count()
+  static size_t countBits(std::span<const uint8_t> bytes) noexcept;
+
+  // One byte at a time with the constexpr Bitwise<>::countBits loop (baseline)
+  static size_t countBitsBytewise(std::span<const uint8_t> bytes) noexcept;
+
+  // Nibble lookup table - the AVR path (no hardware popcount, 8-bit ALU)
+  static size_t countBitsNibbleLut(std::span<const uint8_t> bytes) noexcept;
+
+  // std::popcount on unaligned 64-bit loads; portable
+  static size_t countBitsWords64(std::span<const uint8_t> bytes) noexcept;
+
+  // Same loop compiled for the POPCNT instruction
+  // (x86 only - elsewhere these two fall back to countBitsWords64)
+  static size_t countBitsWords64Popcnt(std::span<const uint8_t> bytes) noexcept;
+
+  // Harley-Seal with AVX2 nibble-shuffle popcount
+  static size_t countBitsHarleySeal(std::span<const uint8_t> bytes) noexcept;
+
+  // ===== BIT REVERSAL OF EVERY BYTE =====
+  // ByteOps::reverseBits(src, dst) dispatches like countBits:
+  //   AVR            reverseBitsLut     256-byte table (flash)
+  //   x86 + AVX2     reverseBitsPshufb  two 16-entry nibble tables, 32 bytes/step
+  //   anything else  reverseBitsWords64 mask-and-shift swaps on 8 bytes at once
+  // dst must hold src.size() bytes; src and dst may be the same buffer.
+
+  // One byte at a time with the constexpr ByteOps::reverseBits loop (baseline)
+  static void reverseBitsLoop(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept;
+
+  // ByteOps::reverseBitsLut per byte
+  static void reverseBitsLut(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept;
+
+  // Swap bits inside all 8 bytes of a 64-bit word in parallel; portable
+  static void reverseBitsWords64(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept;
+
+  // AVX2 PSHUFB nibble lookup (x86 only - elsewhere falls back to Words64)
+  static void reverseBitsPshufb(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept;
+
+  // ===== BOOLEAN OPS ON 64-BIT WORDS =====
+  // dst[i] = dst[i] op src[i] for every word - BitArray's &=, |= and ^=,
+  // and AndNot (dst & ~src) for set differences. applyWords dispatches:
+  //   x86 + AVX2     applyWordsAvx2  4 words (256 bits) per instruction
+  //   anything else  applyWords64    one word per step
+  // src must hold at least dst.size() words.
+  enum class WordOp : uint8_t { And, Or, Xor, AndNot };
+
+  static void applyWords(WordOp op, std::span<uint64_t> dst, std::span<const uint64_t> src) noexcept;
+
+  static void applyWords64(WordOp op, std::span<uint64_t> dst,
+                           std::span<const uint64_t> src) noexcept;
+
+  // AVX2 (x86 only - elsewhere falls back to applyWords64)
+  static void applyWordsAvx2(WordOp op, std::span<uint64_t> dst,
+                             std::span<const uint64_t> src) noexcept;
+
+  // Name of the kernel countBits(span) dispatches to
+  static const char *countBitsKernelName() noexcept;
+
+  // Name of the kernel ByteOps::reverseBits(span) dispatches to
+  static const char *reverseBitsKernelName() noexcept;
+
+  // Name of the kernel applyWords dispatches to
+  static const char *applyWordsKernelName() noexcept;
+};
@@ -0,0 +1,194 @@
+/*
+Compile-Time Bit Field Layouts
+Describe a packed word once - BitLayout<Field<5>, Field<5>, Field<6>> - and
+get shifts, masks, get/set and bulk pack/unpack generated from it.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// ===== FIELD =====
+// One field of a packed word, WIDTH bits wide. Fields are laid out from
+// bit 0 upward in the order they are listed.
+
+template <unsigned Width>
+struct Field {
+  static_assert(Width >= 1 && Width <= 64, "a field is 1..64 bits wide");
+  static constexpr unsigned WIDTH = Width;
+};
+
+// ===== BIT LAYOUT =====
+// Hand-written masks like (data & 0xFC1F) | (humid << 5) hide the layout
+// in magic numbers; one wrong digit corrupts a neighbouring field. Here the
+// layout is the type, and every mask and shift is computed from it:
+//
+//   using Sensor = BitLayout<Field<5>, Field<5>, Field<6>>;
+//
+//   bits:  15 ........ 10 | 9 ..... 5 | 4 ..... 0
+//          field 2 (6)    | field 1 (5) | field 0 (5)
+//
+//   Sensor::Storage            uint16_t (smallest word that holds 16 bits)
+//   Sensor::mask<1>()          0x03E0
+//   Sensor::get<1>(word)       (word >> 5) & 0x1F
+//   Sensor::set<1>(word, v)    (word & ~0x03E0) | ((v & 0x1F) << 5)
+//   Sensor::pack(t, h, l)      all three at once
+//
+// A field index past the end is a compile error, and set() drops value
+// bits that don't fit, like the masks it replaces (fits() tells you first).
+//
+// BULK: packAll/unpackAll convert between one packed word per record
+// (array of structs) and one plain array per field (structure of arrays).
+// Every shift and mask is a compile-time constant and the loops have no
+// branches, so at -O3 the compiler turns them into SIMD code on the host.
+
+template <typename... Fields>
+class BitLayout {
+public:
+  static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+  static constexpr unsigned TOTAL_BITS = (0u + ... + Fields::WIDTH);
+
+  static_assert(FIELD_COUNT > 0, "a layout needs at least one field");
+  static_assert(TOTAL_BITS <= 64, "fields must fit in a 64-bit word");
+
+private:
+  // Smallest unsigned type with at least `bits` bits
+  template <unsigned Bits>
+  using UintFor = std::conditional_t<
+      Bits <= 8, uint8_t,
+      std::conditional_t<Bits <= 16, uint16_t, std::conditional_t<Bits <= 32, uint32_t, uint64_t>>>;
+
+  static constexpr std::array<unsigned, FIELD_COUNT> WIDTHS = {Fields::WIDTH...};
+
+public:
+  // The packed word
+  using Storage = UintFor<TOTAL_BITS>;
+
+  // One unpacked field value (wide enough for the widest field)
+  using Value = UintFor<std::max({Fields::WIDTH...})>;
+
+  template <size_t I>
+  static constexpr unsigned width() noexcept {
+    static_assert(I < FIELD_COUNT, "field index out of range");
+    return WIDTHS[I];
+  }
+
+  // Position of the field's lowest bit
+  template <size_t I>
+  static constexpr unsigned shift() noexcept {
+    static_assert(I < FIELD_COUNT, "field index out of range");
+    unsigned sum = 0;
+    for (size_t i = 0; i < I; i++) {
+      sum += WIDTHS[i];
+    }
+    return sum;
+  }
+
+  // Field bits in place: mask<1>() of the sensor layout = 0x03E0
+  template <size_t I>
+  static constexpr Storage mask() noexcept {
+    return static_cast<Storage>(static_cast<Storage>(lowBits<I>()) << shift<I>());
+  }
+
+  // Does `value` fit in field I without losing bits? Takes a full 64-bit
+  // word, so a value too wide for Value is caught rather than truncated
+  // first (and a negative int converts to a huge value that never fits)
+  template <size_t I>
+  static constexpr bool fits(uint64_t value) noexcept {
+    return (value & ~uint64_t{lowBits<I>()}) == 0;
+  }
+
+  template <size_t I>
+  static constexpr Value get(Storage word) noexcept {
+    return static_cast<Value>((word >> shift<I>()) & lowBits<I>());
+  }
+
+  template <size_t I>
+  static constexpr Storage set(Storage word, Value value) noexcept {
+    return static_cast<Storage>((word & static_cast<Storage>(~mask<I>())) | place<I>(value));
+  }
+
+  // One value per field, in layout order
+  template <typename... Values>
+    requires(sizeof...(Values) == FIELD_COUNT)
+  static constexpr Storage pack(Values... values) noexcept {
+    return packOne(std::array<Value, FIELD_COUNT>{static_cast<Value>(values)...},
+                   std::make_index_sequence<FIELD_COUNT>());
+  }
+
+  // ===== BULK PACK / UNPACK =====
+  // columns[f][i] is field f of record i; words[i] is record i packed.
+  // The word count sets how many records are converted - every column
+  // must hold at least that many values.
+
+  using Columns = std::array<std::span<Value>, FIELD_COUNT>;
+  using ConstColumns = std::array<std::span<const Value>, FIELD_COUNT>;
+
+  static void packAll(const ConstColumns &columns, std::span<Storage> words) noexcept {
+    std::array<const Value *, FIELD_COUNT> in;
+    for (size_t f = 0; f < FIELD_COUNT; f++) {
+      in[f] = columns[f].data();
+    }
+    Storage *out = words.data();
+    const size_t count = words.size();
+    for (size_t i = 0; i < count; i++) {
+      out[i] = packColumns(in, i, std::make_index_sequence<FIELD_COUNT>());
+    }
+  }
+
+  static void unpackAll(std::span<const Storage> words, const Columns &columns) noexcept {
+    unpackColumns(words, columns, std::make_index_sequence<FIELD_COUNT>());
+  }
+
+private:
+  // `width` ones in the low bits (a 64-bit field can't use 1 << 64)
+  template <size_t I>
+  static constexpr Value lowBits() noexcept {
+    constexpr unsigned w = width<I>();
+    if constexpr (w >= 8 * sizeof(Value)) {
+      return static_cast<Value>(~Value{0});
+    } else {
+      return static_cast<Value>((Value{1} << w) - 1);
+    }
+  }
+
+  template <size_t I>
+  static constexpr Storage place(Value value) noexcept {
+    return static_cast<Storage>(static_cast<Storage>(value & lowBits<I>()) << shift<I>());
+  }
+
+  template <size_t... I>
+  static constexpr Storage packOne(const std::array<Value, FIELD_COUNT> &values,
+                                   std::index_sequence<I...>) noexcept {
+    return static_cast<Storage>((Storage{0} | ... | place<I>(values[I])));
+  }
+
+  template <size_t... I>
+  static Storage packColumns(const std::array<const Value *, FIELD_COUNT> &in, size_t i,
+                             std::index_sequence<I...>) noexcept {
+    return static_cast<Storage>((Storage{0} | ... | place<I>(in[I][i])));
+  }
+
+  // One pass per field: each loop reads the words and writes one column,
+  // which keeps the stores contiguous for the vectorizer
+  template <size_t... I>
+  static void unpackColumns(std::span<const Storage> words, const Columns &columns,
+                            std::index_sequence<I...>) noexcept {
+    (unpackColumn<I>(words, columns[I].data()), ...);
+  }
+
+  template <size_t I>
+  static void unpackColumn(std::span<const Storage> words, Value *__restrict out) noexcept {
+    const Storage *__restrict in = words.data();
+    const size_t count = words.size();
+    for (size_t i = 0; i < count; i++) {
+      out[i] = get<I>(in[i]);
+    }
+  }
+};
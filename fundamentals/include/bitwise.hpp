@@ -5,7 +5,14 @@ Essential for microcontrollers!
 
 #pragma once
 
+#include "bit_kernels.hpp"
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <span>
 
 // ===== BIT POSITIONS =====
 // Bit positions in a byte (0-7)
@@ -19,51 +26,64 @@ constexpr uint8_t BIT_6 = 6;
 constexpr uint8_t BIT_7 = 7;
 
 // ===== BIT MANIPULATION OPERATIONS =====
-
+// Works for every unsigned width: Bitwise<>::setBit(byte, 3) for a byte
+// register, Bitwise<uint32_t>::setBit(flags, 31) for a 32-bit one.
+// T defaults to uint8_t, so Bitwise<> is the classic 8-bit version.
+//
+// Every mask is built as T{1} << bit - never (1 << bit), which is an int
+// and overflows once bit reaches 31.
+
+template <std::unsigned_integral T = uint8_t>
 class Bitwise {
 public:
+  static constexpr uint8_t BITS = std::numeric_limits<T>::digits; // 8, 16, 32, 64
+
+  // CREATE a bitmask (single bit set)
+  // Example: bitMask(3) = 0b00001000
+  static constexpr T bitMask(uint8_t bit) noexcept { return static_cast<T>(T{1} << bit); }
+
   // SET a bit (make it 1)
   // Example: setBit(0b00000000, 3) = 0b00001000
   // USE CASE: Turn on a specific hardware pin or flag
-  static constexpr uint8_t setBit(uint8_t byte, uint8_t bit) noexcept {
-    return byte | (1 << bit);
-    //            ↑   ↑
-    //            |   Create mask: 1 shifted to position
+  static constexpr T setBit(T value, uint8_t bit) noexcept {
+    return value | bitMask(bit);
+    //            ↑     ↑
+    //            |     Create mask: 1 shifted to position
     //            OR with original (sets the bit)
   }
 
   // CLEAR a bit (make it 0)
   // Example: clearBit(0b11111111, 3) = 0b11110111
   // USE CASE: Turn off a specific hardware pin or flag
-  static constexpr uint8_t clearBit(uint8_t byte, uint8_t bit) noexcept {
-    return byte & ~(1 << bit);
-    //            ↑ ↑
-    //            | NOT inverts: ~(00001000) = 11110111
-    //            AND with original (clears the bit)
+  static constexpr T clearBit(T value, uint8_t bit) noexcept {
+    return value & static_cast<T>(~bitMask(bit));
+    //             ↑ ↑
+    //             | NOT inverts: ~(00001000) = 11110111
+    //             AND with original (clears the bit)
   }
 
   // TOGGLE a bit (flip it: 0→1 or 1→0)
   // Example: toggleBit(0b00001000, 3) = 0b00000000
   // USE CASE: Toggle LED state, flip flags
-  static constexpr uint8_t toggleBit(uint8_t byte, uint8_t bit) noexcept {
-    return byte ^ (1 << bit);
-    //            ↑
-    //            XOR flips the bit
+  static constexpr T toggleBit(T value, uint8_t bit) noexcept {
+    return value ^ bitMask(bit);
+    //           ↑
+    //           XOR flips the bit
   }
 
   // CHECK if bit is set (is it 1?)
   // Example: isBitSet(0b00001000, 3) = true
   // USE CASE: Read hardware pin state, check flags
-  static constexpr bool isBitSet(uint8_t byte, uint8_t bit) noexcept {
-    return (byte & (1 << bit)) != 0;
-    //             ↑
-    //             AND isolates the bit, check if non-zero
+  static constexpr bool isBitSet(T value, uint8_t bit) noexcept {
+    return (value & bitMask(bit)) != 0;
+    //            ↑
+    //            AND isolates the bit, check if non-zero
   }
 
   // GET bit value (0 or 1)
   // Example: getBit(0b00001000, 3) = 1
-  static constexpr uint8_t getBit(uint8_t byte, uint8_t bit) noexcept {
-    return (byte >> bit) & 1;
+  static constexpr T getBit(T value, uint8_t bit) noexcept {
+    return (value >> bit) & 1;
     //            ↑      ↑
     //            |      Mask to get only bit 0
     //            Shift bit to position 0
@@ -72,45 +92,58 @@ public:
   // SET multiple bits at once using a mask
   // Example: setBits(0b00000000, 0b00001111) = 0b00001111
   // USE CASE: Configure multiple pins at once
-  static constexpr uint8_t setBits(uint8_t byte, uint8_t mask) noexcept {
-    return byte | mask;
-  }
+  static constexpr T setBits(T value, T mask) noexcept { return value | mask; }
 
   // CLEAR multiple bits using a mask
   // Example: clearBits(0b11111111, 0b00001111) = 0b11110000
-  static constexpr uint8_t clearBits(uint8_t byte, uint8_t mask) noexcept {
-    return byte & ~mask;
+  static constexpr T clearBits(T value, T mask) noexcept {
+    return value & static_cast<T>(~mask);
   }
 
   // WRITE bit (set to specific value: 0 or 1)
   // Example: writeBit(0b00000000, 3, true) = 0b00001000
-  static constexpr uint8_t writeBit(uint8_t byte, uint8_t bit,
-                                    bool value) noexcept {
-    return value ? setBit(byte, bit) : clearBit(byte, bit);
+  static constexpr T writeBit(T value, uint8_t bit, bool on) noexcept {
+    return on ? setBit(value, bit) : clearBit(value, bit);
   }
 
-  // CREATE a bitmask (single bit set)
-  // Example: bitMask(3) = 0b00001000
-  static constexpr uint8_t bitMask(uint8_t bit) noexcept { return 1 << bit; }
-
   // EXTRACT bits from a range
-  // Example: extractBits(0b11010110, 2, 4) extracts bits 2-4
-  static constexpr uint8_t extractBits(uint8_t byte, uint8_t start,
-                                       uint8_t length) noexcept {
-    uint8_t mask = (1 << length) - 1; // Create mask of 'length' 1s
-    return (byte >> start) & mask;
+  // Example: extractBits(0b11010110, 2, 4) extracts bits 2-5
+  static constexpr T extractBits(T value, uint8_t start, uint8_t length) noexcept {
+    // Mask of 'length' 1s; a full-width length would shift by BITS (UB)
+    T mask = length >= BITS ? static_cast<T>(~T{0}) : static_cast<T>(bitMask(length) - 1);
+    return (value >> start) & mask;
   }
 
   // COUNT number of set bits (population count)
   // Example: countBits(0b00101101) = 4
-  static constexpr uint8_t countBits(uint8_t byte) noexcept {
+  static constexpr uint8_t countBits(T value) noexcept {
     uint8_t count = 0;
-    while (byte) {
-      count += byte & 1;
-      byte >>= 1;
+    while (value) {
+      count += value & 1;
+      value >>= 1;
     }
     return count;
   }
+
+  // COUNT set bits across a whole buffer
+  // Example: countBits(status_bitmap) = number of active flags
+  // USE CASE: Count enabled channels/errors in large status bitmaps
+  // Same result as calling countBits(byte) on every byte, but picks the
+  // fastest kernel for the CPU once at runtime (see bit_kernels.hpp)
+  static size_t countBits(std::span<const uint8_t> bytes) noexcept {
+    return BitKernels::countBits(bytes);
+  }
+
+  // ROTATE (circular shift) - bits that fall off one end come back on the other
+  // Example: Bitwise<>::rotateLeft(0b10110001, 2) = 0b11000110
+  // std::rotl/rotr handle any count (mod BITS) and compile to one instruction
+  static constexpr T rotateLeft(T value, int positions) noexcept {
+    return std::rotl(value, positions);
+  }
+
+  static constexpr T rotateRight(T value, int positions) noexcept {
+    return std::rotr(value, positions);
+  }
 };
 
 // ===== SHIFT OPERATIONS =====
@@ -135,20 +168,32 @@ public:
 
   // ROTATE LEFT (circular shift)
   // Bits that fall off the left come back on the right
-  static constexpr uint8_t rotateLeft(uint8_t byte,
-                                      uint8_t positions) noexcept {
-    positions %= 8; // Handle positions > 8
-    return (byte << positions) | (byte >> (8 - positions));
+  // A byte - also what plain int arguments convert to: rotateLeft(0xB1, 2)
+  static constexpr uint8_t rotateLeft(uint8_t byte, uint8_t positions) noexcept {
+    return Bitwise<uint8_t>::rotateLeft(byte, positions);
+  }
+
+  // Any other unsigned width: rotateLeft(uint32_t{...}, 7)
+  template <std::unsigned_integral T>
+  static constexpr T rotateLeft(T value, uint8_t positions) noexcept {
+    return Bitwise<T>::rotateLeft(value, positions);
   }
 
   // ROTATE RIGHT (circular shift)
-  static constexpr uint8_t rotateRight(uint8_t byte,
-                                       uint8_t positions) noexcept {
-    positions %= 8;
-    return (byte >> positions) | (byte << (8 - positions));
+  static constexpr uint8_t rotateRight(uint8_t byte, uint8_t positions) noexcept {
+    return Bitwise<uint8_t>::rotateRight(byte, positions);
+  }
+
+  template <std::unsigned_integral T>
+  static constexpr T rotateRight(T value, uint8_t positions) noexcept {
+    return Bitwise<T>::rotateRight(value, positions);
   }
 };
 
+static_assert(ShiftOps::rotateLeft(0xB1, 2) == 0xC6, "int arguments rotate as a byte");
+static_assert(ShiftOps::rotateRight(0xB1, 2) == 0x6C);
+static_assert(ShiftOps::rotateLeft(0x80000001u, 4) == 0x00000018u);
+
 // ===== BYTE OPERATIONS =====
 
 class ByteOps {
@@ -186,8 +231,58 @@ public:
     }
     return result;
   }
+
+  // REVERSE bits with a lookup table - one load instead of 8 iterations
+  // Example: reverseBitsLut(0b10110010) = 0b01001101
+  // Table is built at compile time from reverseBits() (defined below)
+  static constexpr uint8_t reverseBitsLut(uint8_t byte) noexcept;
+
+  // REVERSE all bits in a 16/32/64-bit word (bit 0 <-> bit N-1)
+  // Swap neighbours, then pairs, nibbles, bytes... log2(N) steps, no loop
+  // Example: reverseBits16(0x0001) = 0x8000
+  // USE CASE: LSB-first SPI / shift registers fed from MSB-first data
+  static constexpr uint16_t reverseBits16(uint16_t word) noexcept {
+    word = ((word >> 1) & 0x5555) | ((word & 0x5555) << 1);
+    word = ((word >> 2) & 0x3333) | ((word & 0x3333) << 2);
+    word = ((word >> 4) & 0x0F0F) | ((word & 0x0F0F) << 4);
+    return (word >> 8) | (word << 8);
+  }
+
+  static constexpr uint32_t reverseBits32(uint32_t word) noexcept {
+    word = ((word >> 1) & 0x55555555u) | ((word & 0x55555555u) << 1);
+    word = ((word >> 2) & 0x33333333u) | ((word & 0x33333333u) << 2);
+    word = ((word >> 4) & 0x0F0F0F0Fu) | ((word & 0x0F0F0F0Fu) << 4);
+    word = ((word >> 8) & 0x00FF00FFu) | ((word & 0x00FF00FFu) << 8);
+    return (word >> 16) | (word << 16);
+  }
+
+  static constexpr uint64_t reverseBits64(uint64_t word) noexcept {
+    return (static_cast<uint64_t>(reverseBits32(static_cast<uint32_t>(word))) << 32) |
+           reverseBits32(static_cast<uint32_t>(word >> 32));
+  }
+
+  // REVERSE the bits of every byte in a buffer (byte order is kept)
+  // Example: {0x01, 0x80} -> {0x80, 0x01}
+  // USE CASE: Prepare a whole frame for an LSB-first peripheral
+  // dst must be at least src.size() bytes; src and dst may be the same
+  // buffer. Picks the fastest kernel at runtime (see bit_kernels.hpp)
+  static void reverseBits(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept;
+  static void reverseBits(std::span<uint8_t> bytes) noexcept { reverseBits(bytes, bytes); }
 };
 
+// 256-entry bit-reversal table, generated at compile time
+inline constexpr std::array<uint8_t, 256> REVERSE_BITS_TABLE = [] {
+  std::array<uint8_t, 256> table{};
+  for (int i = 0; i < 256; i++) {
+    table[i] = ByteOps::reverseBits(static_cast<uint8_t>(i));
+  }
+  return table;
+}();
+
+constexpr uint8_t ByteOps::reverseBitsLut(uint8_t byte) noexcept {
+  return REVERSE_BITS_TABLE[byte];
+}
+
 // ===== MICROCONTROLLER-SPECIFIC =====
 
 // Simulate Arduino digital pin registers
@@ -201,29 +296,29 @@ public:
   // Set pin mode (INPUT=0, OUTPUT=1)
   constexpr void pinMode(uint8_t pin, bool output) noexcept {
     if (output) {
-      dirRegister = Bitwise::setBit(dirRegister, pin);
+      dirRegister = Bitwise<>::setBit(dirRegister, pin);
     } else {
-      dirRegister = Bitwise::clearBit(dirRegister, pin);
+      dirRegister = Bitwise<>::clearBit(dirRegister, pin);
     }
   }
 
   // Write digital value (LOW=0, HIGH=1)
   constexpr void digitalWrite(uint8_t pin, bool value) noexcept {
     if (value) {
-      portRegister = Bitwise::setBit(portRegister, pin);
+      portRegister = Bitwise<>::setBit(portRegister, pin);
     } else {
-      portRegister = Bitwise::clearBit(portRegister, pin);
+      portRegister = Bitwise<>::clearBit(portRegister, pin);
     }
   }
 
   // Read digital value
   constexpr bool digitalRead(uint8_t pin) const noexcept {
-    return Bitwise::isBitSet(pinRegister, pin);
+    return Bitwise<>::isBitSet(pinRegister, pin);
   }
 
   // Toggle pin
   constexpr void togglePin(uint8_t pin) noexcept {
-    portRegister = Bitwise::toggleBit(portRegister, pin);
+    portRegister = Bitwise<>::toggleBit(portRegister, pin);
   }
 
   // Get register values (for demonstration)
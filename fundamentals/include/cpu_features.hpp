@@ -0,0 +1,38 @@
+/*
+CPU Features
+What every SIMD kernel file shares: the x86 build switch, the runtime
+feature checks, and the once-per-process pick of a module's kernel table.
+*/
+
+#pragma once
+
+// x86 builds compile the [[gnu::target("avx2")]] kernels; dispatch still
+// checks the running CPU before calling one
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86 1
+#include <immintrin.h>
+#endif
+
+// ===== RUNTIME CHECKS =====
+
+class CpuFeatures {
+public:
+  // False on non-x86 targets
+  static bool hasPopcnt() noexcept;
+  static bool hasAvx2() noexcept;
+};
+
+// ===== KERNEL CHOICE =====
+// A module keeps its kernels in one table of function pointers plus a
+// `name` for kernelName() and the benches, and picks it in a function-local
+// static (thread-safe to initialize, so the CPU is checked once):
+//
+//   static const Choice &choice() noexcept {
+//     static const Choice table = pickKernels<Choice>({...AVX2...}, {...portable...});
+//     return table;
+//   }
+
+template <typename Table>
+Table pickKernels(const Table &avx2, const Table &portable, bool needs_popcnt = false) noexcept {
+  return CpuFeatures::hasAvx2() && (!needs_popcnt || CpuFeatures::hasPopcnt()) ? avx2 : portable;
+}
@@ -0,0 +1,167 @@
+/*
+LED Animation Engine
+LEDStrip's chase, scaled up: N addressable strips x M pixels, front/back
+frame buffers, time-based effects, and a WS2812 encoder that turns a frame
+into the SPI bytes that drive the strips.
+*/
+
+#pragma once
+
+#include "rgb_frame.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// ===== WS2812 OVER SPI =====
+// A WS2812 reads one bit per 1.25 us: a high pulse, short for 0 and long
+// for 1. Run SPI at 3 or 4 times the 800 kHz bit rate and each data bit
+// becomes a fixed group of SPI bits, so any SPI+DMA peripheral can drive
+// the strip without bit-banging:
+//
+//   ThreeBit  2.4 MHz   0 → 100    1 → 110      1 byte → 3 SPI bytes
+//   FourBit   3.2 MHz   0 → 1000   1 → 1110     1 byte → 4 SPI bytes
+//
+// Data goes out MSB first, G then R then B per pixel, first pixel first.
+// A low line for RESET_US latches the frame, so each strip's SPI buffer
+// ends in resetBytes() zero bytes.
+//
+// Dispatch, like BitKernels:
+//   x86 + AVX2     encodeAvx2    8 data bytes per step: FourBit tests each
+//                                bit with AND + compare, ThreeBit spreads
+//                                bits 3 apart with shifts and masks
+//   anything else  encodeScalar  table lookup (FourBit) / the same
+//                                shift-and-mask spread (ThreeBit)
+
+class WS2812 {
+public:
+  enum class Encoding : uint8_t { ThreeBit = 3, FourBit = 4 };
+
+  static constexpr uint32_t BIT_RATE_HZ = 800'000;
+  static constexpr uint32_t RESET_US = 280; // newer parts; older need 50
+
+  static constexpr unsigned spiBitsPerBit(Encoding encoding) {
+    return static_cast<unsigned>(encoding);
+  }
+  static constexpr uint32_t spiHz(Encoding encoding) {
+    return BIT_RATE_HZ * spiBitsPerBit(encoding);
+  }
+  static constexpr size_t resetBytes(Encoding encoding) {
+    return (size_t{RESET_US} * spiHz(encoding) / 1'000'000 + 7) / 8;
+  }
+  // SPI bytes for one strip of `pixels`, reset tail included
+  static constexpr size_t encodedBytes(size_t pixels, Encoding encoding) {
+    return pixels * 3 * spiBitsPerBit(encoding) + resetBytes(encoding);
+  }
+
+  // 0x00RRGGBB pixels → G,R,B bytes (grb.size() >= 3 * pixels.size())
+  static void toWireOrder(std::span<const uint32_t> pixels, std::span<uint8_t> grb) noexcept;
+
+  // Data bytes → SPI bytes (spi.size() >= data.size() * spiBitsPerBit)
+  static void encode(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                     Encoding encoding) noexcept;
+  static void encodeScalar(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                           Encoding encoding) noexcept;
+  // x86 only - elsewhere this falls back to the scalar version
+  static void encodeAvx2(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                         Encoding encoding) noexcept;
+
+  // SPI bytes → data bytes, one bit group at a time. False if a group is
+  // neither the 0 nor the 1 pattern (what a logic analyzer check wants).
+  static bool decode(std::span<const uint8_t> spi, std::span<uint8_t> data,
+                     Encoding encoding) noexcept;
+
+  // Name of the kernel encode() dispatches to
+  static const char *kernelName() noexcept;
+};
+
+// ===== EFFECTS =====
+// Every effect is a pure function of the time since the animation started,
+// never of the frame number: a 30 fps and a 144 fps controller show the
+// same picture at the same moment, and a dropped frame just skips ahead.
+//
+// Effects draw into a Packed RGBFrame, one row per strip.
+
+class LEDEffects {
+public:
+  // A lit head running along each strip at `pixels_per_sec`, fading out
+  // over `tail` pixels behind it. Strips start evenly staggered.
+  static void chase(RGBFrame &frame, uint64_t t_us, uint32_t rgb, uint32_t pixels_per_sec,
+                    uint32_t tail) noexcept;
+
+  // Whole frame going from -> to -> from, once every `period_us`
+  static void fade(RGBFrame &frame, uint64_t t_us, uint32_t from, uint32_t to,
+                   uint64_t period_us) noexcept;
+
+  // One full colour wheel along each strip, turning once every `period_us`
+  static void rainbow(RGBFrame &frame, uint64_t t_us, uint64_t period_us) noexcept;
+
+  // Colour wheel, hue 0..767: red → green → blue → red
+  static uint32_t wheel(uint32_t hue) noexcept;
+
+  // (b * alpha + a * (256 - alpha)) / 256 per channel, alpha 0..256
+  static uint32_t mix(uint32_t a, uint32_t b, uint32_t alpha) noexcept;
+};
+
+// ===== ENGINE =====
+// Double buffering, twice over. Effects draw into back() while front() is
+// the frame being encoded; present() swaps the two. encode() writes the
+// new front into the SPI buffer stripBits() does NOT currently return,
+// then flips to it - so DMA of the previous encode() may keep running
+// while the next frame is encoded. One transfer in flight: each encode()
+// reuses the buffer from two calls ago, so that DMA must have finished.
+//
+//   engine.render(now_us, [](RGBFrame &f, uint64_t t) { LEDEffects::rainbow(f, t, 2'000'000); });
+//   engine.encode();
+//   for each strip s: start DMA of engine.stripBits(s)
+
+class LEDEngine {
+public:
+  LEDEngine(size_t strips, size_t pixels_per_strip,
+            WS2812::Encoding encoding = WS2812::Encoding::FourBit);
+
+  size_t strips() const noexcept { return strip_count; }
+  size_t pixelsPerStrip() const noexcept { return strip_pixels; }
+  WS2812::Encoding encoding() const noexcept { return wire_encoding; }
+
+  RGBFrame &back() noexcept { return buffers[front_index ^ 1]; }
+  const RGBFrame &front() const noexcept { return buffers[front_index]; }
+
+  // Make the back buffer the one that gets encoded
+  void present() noexcept {
+    front_index ^= 1;
+    presented++;
+  }
+
+  // effect(back(), t_us), then present()
+  template <typename Effect>
+  void render(uint64_t t_us, Effect &&effect) {
+    std::forward<Effect>(effect)(back(), t_us);
+    present();
+  }
+
+  // front() → SPI bytes for every strip, into the idle SPI buffer
+  void encode() noexcept;
+
+  // One strip's SPI bytes from the latest encode(), reset tail included
+  std::span<const uint8_t> stripBits(size_t strip) const noexcept {
+    return {spi[spi_front].data() + strip * strip_bytes, strip_bytes};
+  }
+
+  uint64_t framesPresented() const noexcept { return presented; }
+
+private:
+  size_t strip_count;
+  size_t strip_pixels;
+  WS2812::Encoding wire_encoding;
+  size_t strip_bytes;
+  std::array<RGBFrame, 2> buffers;
+  unsigned front_index = 0;
+  uint64_t presented = 0;
+  std::vector<uint8_t> grb; // one strip in wire order
+  // Every strip, strip_bytes apart; spi[spi_front] is the one DMA sends
+  std::array<std::vector<uint8_t>, 2> spi;
+  unsigned spi_front = 0;
+};
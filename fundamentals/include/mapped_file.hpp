@@ -0,0 +1,37 @@
+/*
+Mapped File
+A whole file mapped read-only, for the readers that scan logs and captures
+in place instead of copying them into buffers.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// ===== READ-ONLY MAPPING =====
+// The bytes stay valid until close(). Without mmap (non-POSIX targets)
+// open() fails with ENOSYS.
+
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // False (errno set) if the file can't be opened or mapped; EINVAL if it
+  // holds fewer than min_bytes bytes or none at all. Hints sequential reads.
+  bool open(const char *path, size_t min_bytes = 0);
+  void close() noexcept;
+
+  bool isOpen() const noexcept { return base != nullptr; }
+  const uint8_t *data() const noexcept { return base; }
+  size_t size() const noexcept { return mapped_bytes; }
+  std::span<const uint8_t> bytes() const noexcept { return {base, mapped_bytes}; }
+
+private:
+  const uint8_t *base = nullptr;
+  size_t mapped_bytes = 0;
+};
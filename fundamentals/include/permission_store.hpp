@@ -0,0 +1,76 @@
+/*
+Permission Store
+Permissions for millions of principals, stored by column: one compressed
+bitmap of principal IDs per permission bit, so "who has WRITE but not
+ADMIN?" is a couple of bitmap operations instead of a scan.
+*/
+
+#pragma once
+
+#include "real_world.hpp"
+#include "roaring_bitmap.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ===== PERMISSION STORE =====
+// The same data as one Permissions byte per principal, turned sideways:
+//
+//   Permissions[id].flags bit b   ⇔   id ∈ holders(b)
+//
+//   per principal   get/set/grant/revoke   one add/remove per changed bit
+//   queries         query(all, none)       holders of every bit in `all`,
+//                                          minus holders of any bit in
+//                                          `none` - smallest bitmap first
+//                   queryAny(any, none)    holders of at least one bit
+//                   count*(...)            the same, as a number, with
+//                                          no result bitmap allocated
+//
+// Results are RoaringBitmaps: count them, iterate them in ID order or
+// keep combining them.
+
+class PermissionStore {
+public:
+  static constexpr unsigned FLAG_BITS = 8;
+
+  // ===== ONE PRINCIPAL =====
+  // Replace all of a principal's flags (adds the principal if new)
+  void set(uint32_t principal, uint8_t flags);
+  void grant(uint32_t principal, uint8_t permissions);
+  void revoke(uint32_t principal, uint8_t permissions);
+  // Forget the principal entirely
+  void remove(uint32_t principal);
+
+  bool contains(uint32_t principal) const noexcept { return members.contains(principal); }
+  // Permissions{} for unknown principals
+  Permissions get(uint32_t principal) const noexcept;
+
+  // ===== QUERIES =====
+  // Principals with every permission in `all` and none in `none`
+  // (all = 0: every known principal)
+  RoaringBitmap query(uint8_t all, uint8_t none = 0) const;
+  // Principals with at least one permission in `any` and none in `none`
+  RoaringBitmap queryAny(uint8_t any, uint8_t none = 0) const;
+
+  // Sizes of the same two results, counted chunk by chunk without
+  // building them (RoaringBitmap::countAll/countAny)
+  size_t count(uint8_t all, uint8_t none = 0) const noexcept;
+  size_t countAny(uint8_t any, uint8_t none = 0) const noexcept;
+
+  // ===== COLUMNS =====
+  const RoaringBitmap &principals() const noexcept { return members; }
+  // Holders of the single permission 1 << bit
+  const RoaringBitmap &holders(unsigned bit) const noexcept { return columns[bit]; }
+
+  size_t principalCount() const noexcept { return members.cardinality(); }
+  size_t bytes() const noexcept;
+
+private:
+  // Columns of the bits in `flags`, into `out`; returns how many
+  size_t columnsOf(uint8_t flags, const RoaringBitmap **out) const noexcept;
+  // The same, smallest first (the order query() and count() intersect in)
+  size_t columnsBySize(uint8_t flags, const RoaringBitmap **out) const noexcept;
+
+  RoaringBitmap members;
+  std::array<RoaringBitmap, FLAG_BITS> columns;
+};
@@ -5,7 +5,10 @@ Actual scenarios from embedded systems and microcontrollers
 
 #pragma once
 
+#include "bit_layout.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 // ===== SCENARIO 1: LED STRIP CONTROL =====
 // Control 8 LEDs with a single byte (save GPIO pins!)
@@ -138,36 +141,49 @@ public:
 // ===== SCENARIO 5: SENSOR DATA PACKING =====
 // Pack multiple sensor readings into minimal bytes (save memory/bandwidth)
 class SensorPacket {
-private:
+public:
   // Pack 3 sensors into 2 bytes instead of 6!
-  uint16_t data = 0;
   // Bits 0-4:   Temperature (0-31)  → 5 bits
   // Bits 5-9:   Humidity (0-31)     → 5 bits
   // Bits 10-15: Light (0-63)        → 6 bits
+  using Layout = BitLayout<Field<5>, Field<5>, Field<6>>;
+  enum FieldIndex : size_t { TEMPERATURE, HUMIDITY, LIGHT };
 
-public:
-  void setTemperature(uint8_t temp) {
-    temp &= 0x1F; // Mask to 5 bits (0-31)
-    data = (data & 0xFFE0) | temp;
-  }
+private:
+  uint16_t data = 0;
 
-  void setHumidity(uint8_t humid) {
-    humid &= 0x1F; // Mask to 5 bits
-    data = (data & 0xFC1F) | (humid << 5);
+public:
+  // Rebuild a packet received as its raw 2 bytes
+  static SensorPacket fromRaw(uint16_t raw) {
+    SensorPacket packet;
+    packet.data = raw;
+    return packet;
   }
 
-  void setLight(uint8_t light) {
-    light &= 0x3F; // Mask to 6 bits (0-63)
-    data = (data & 0x03FF) | (light << 10);
-  }
+  // Out-of-range values are masked to the field width (31 or 63 max)
+  void setTemperature(uint8_t temp) { data = Layout::set<TEMPERATURE>(data, temp); }
+  void setHumidity(uint8_t humid) { data = Layout::set<HUMIDITY>(data, humid); }
+  void setLight(uint8_t light) { data = Layout::set<LIGHT>(data, light); }
 
-  uint8_t getTemperature() const { return data & 0x1F; }
-  uint8_t getHumidity() const { return (data >> 5) & 0x1F; }
-  uint8_t getLight() const { return (data >> 10) & 0x3F; }
+  uint8_t getTemperature() const { return Layout::get<TEMPERATURE>(data); }
+  uint8_t getHumidity() const { return Layout::get<HUMIDITY>(data); }
+  uint8_t getLight() const { return Layout::get<LIGHT>(data); }
 
   uint16_t getRawData() const { return data; }
 };
 
+// The generated masks must match the ones this class used to spell out
+// by hand: data & 0xFFE0, & 0xFC1F, & 0x03FF
+static_assert(std::is_same_v<SensorPacket::Layout::Storage, uint16_t>);
+static_assert(SensorPacket::Layout::mask<SensorPacket::TEMPERATURE>() == 0x001F);
+static_assert(SensorPacket::Layout::mask<SensorPacket::HUMIDITY>() == 0x03E0);
+static_assert(SensorPacket::Layout::mask<SensorPacket::LIGHT>() == 0xFC00);
+static_assert(SensorPacket::Layout::pack(25, 18, 45) == (25 | (18 << 5) | (45 << 10)));
+static_assert(SensorPacket::Layout::set<SensorPacket::HUMIDITY>(0xFFFF, 0) == 0xFC1F);
+static_assert(SensorPacket::Layout::fits<SensorPacket::TEMPERATURE>(31));
+static_assert(!SensorPacket::Layout::fits<SensorPacket::TEMPERATURE>(32));
+static_assert(!SensorPacket::Layout::fits<SensorPacket::TEMPERATURE>(257)); // not wrapped to 1
+
 // ===== SCENARIO 6: GPIO PORT CONFIGURATION =====
 // Configure multiple pins at once (like real Arduino registers)
 class GPIOPort {
@@ -238,24 +254,30 @@ struct DeviceConfig {
   // Bit 5:   Stop bits (0=1 bit, 1=2 bits)
   // Bit 6:   Echo (0=off, 1=on)
   // Bit 7:   Flow control (0=off, 1=on)
-
-  void setBaudRate(uint8_t rate) {
-    data = (data & 0xF8) | (rate & 0x07); // Keep upper 5 bits, set lower 3
-  }
-  void setParity(uint8_t parity) {
-    data = (data & 0xE7) | ((parity & 0x03) << 3);
-  }
-  void setStopBits(bool two) { data = two ? (data | 0x20) : (data & ~0x20); }
-  void setEcho(bool on) { data = on ? (data | 0x40) : (data & ~0x40); }
-  void setFlowControl(bool on) { data = on ? (data | 0x80) : (data & ~0x80); }
-
-  uint8_t getBaudRate() const { return data & 0x07; }
-  uint8_t getParity() const { return (data >> 3) & 0x03; }
-  bool getStopBits() const { return (data & 0x20) != 0; }
-  bool getEcho() const { return (data & 0x40) != 0; }
-  bool getFlowControl() const { return (data & 0x80) != 0; }
+  using Layout = BitLayout<Field<3>, Field<2>, Field<1>, Field<1>, Field<1>>;
+  enum FieldIndex : size_t { BAUD_RATE, PARITY, STOP_BITS, ECHO, FLOW_CONTROL };
+
+  void setBaudRate(uint8_t rate) { data = Layout::set<BAUD_RATE>(data, rate); }
+  void setParity(uint8_t parity) { data = Layout::set<PARITY>(data, parity); }
+  void setStopBits(bool two) { data = Layout::set<STOP_BITS>(data, two); }
+  void setEcho(bool on) { data = Layout::set<ECHO>(data, on); }
+  void setFlowControl(bool on) { data = Layout::set<FLOW_CONTROL>(data, on); }
+
+  uint8_t getBaudRate() const { return Layout::get<BAUD_RATE>(data); }
+  uint8_t getParity() const { return Layout::get<PARITY>(data); }
+  bool getStopBits() const { return Layout::get<STOP_BITS>(data) != 0; }
+  bool getEcho() const { return Layout::get<ECHO>(data) != 0; }
+  bool getFlowControl() const { return Layout::get<FLOW_CONTROL>(data) != 0; }
 };
 
+// Same bits as the old hand-written 0x07 / 0x18 / 0x20 / 0x40 / 0x80
+static_assert(DeviceConfig::Layout::TOTAL_BITS == 8);
+static_assert(DeviceConfig::Layout::mask<DeviceConfig::BAUD_RATE>() == 0x07);
+static_assert(DeviceConfig::Layout::mask<DeviceConfig::PARITY>() == 0x18);
+static_assert(DeviceConfig::Layout::mask<DeviceConfig::STOP_BITS>() == 0x20);
+static_assert(DeviceConfig::Layout::mask<DeviceConfig::ECHO>() == 0x40);
+static_assert(DeviceConfig::Layout::mask<DeviceConfig::FLOW_CONTROL>() == 0x80);
+
 // Demo functions
 void real_world_demo();
 void led_strip_demo();
@@ -0,0 +1,180 @@
+/*
+RGB Frame Pipeline
+Whole-frame versions of RGBColor's dim()/brighten(), plus scale, blend and
+gamma - SIMD kernels over packed 0xRRGGBB or planar pixels, split across
+threads for large frames.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+// ===== GAMMA TABLE =====
+// LEDs are linear in PWM duty, eyes are not: half duty looks much brighter
+// than half. out = 255 * (in / 255)^2.2, rounded, built at compile time.
+// (std::pow isn't constexpr, so x^2.2 = x^2 * x^(1/5) with Newton's method
+// for the fifth root.)
+
+constexpr double gammaFifthRoot(double x) {
+  double y = 1.0; // x <= 1, so Newton converges from above
+  for (int i = 0; i < 64; i++) {
+    const double y2 = y * y;
+    y -= (y2 * y2 * y - x) / (5.0 * y2 * y2);
+  }
+  return y;
+}
+
+inline constexpr std::array<uint8_t, 256> GAMMA_TABLE = [] {
+  std::array<uint8_t, 256> table{};
+  for (int i = 1; i < 256; i++) {
+    const double x = i / 255.0;
+    table[i] = static_cast<uint8_t>(255.0 * x * x * gammaFifthRoot(x) + 0.5);
+  }
+  return table;
+}();
+
+static_assert(GAMMA_TABLE[0] == 0 && GAMMA_TABLE[255] == 255, "gamma keeps black and white");
+static_assert(GAMMA_TABLE[128] == 56, "(128/255)^2.2 * 255 = 55.98");
+
+// ===== BYTE KERNELS =====
+// Every operation works on each 8-bit channel on its own, so one kernel
+// serves both frame formats - it just sees a buffer of channel bytes.
+//
+//   dim         c >> 1                    (RGBColor::dim)
+//   brighten    min(2c, 255)              (RGBColor::brighten)
+//   scale       c * fraction / 256        fraction 0..256 (256 = unchanged)
+//   blend       (src*a + dst*(256-a)) / 256   alpha 0..256 (256 = all src)
+//   gamma       GAMMA_TABLE[c]
+//
+// Dispatch, like BitKernels:
+//   x86 + AVX2     *Avx2    32 channels per step; saturating adds for
+//                           brighten, 16-bit multiplies for scale/blend,
+//                           16 PSHUFB lookups for the gamma table
+//   anything else  *Scalar  plain loops (the compiler vectorizes most)
+
+class RGBKernels {
+public:
+  static void dim(std::span<uint8_t> bytes) noexcept;
+  static void brighten(std::span<uint8_t> bytes) noexcept;
+  static void scale(std::span<uint8_t> bytes, uint16_t fraction) noexcept;
+  static void blend(std::span<uint8_t> dst, std::span<const uint8_t> src, uint16_t alpha) noexcept;
+  static void gamma(std::span<uint8_t> bytes) noexcept;
+
+  static void dimScalar(std::span<uint8_t> bytes) noexcept;
+  static void brightenScalar(std::span<uint8_t> bytes) noexcept;
+  static void scaleScalar(std::span<uint8_t> bytes, uint16_t fraction) noexcept;
+  static void blendScalar(std::span<uint8_t> dst, std::span<const uint8_t> src,
+                          uint16_t alpha) noexcept;
+  static void gammaScalar(std::span<uint8_t> bytes) noexcept;
+
+  // x86 only - elsewhere these fall back to the scalar versions
+  static void dimAvx2(std::span<uint8_t> bytes) noexcept;
+  static void brightenAvx2(std::span<uint8_t> bytes) noexcept;
+  static void scaleAvx2(std::span<uint8_t> bytes, uint16_t fraction) noexcept;
+  static void blendAvx2(std::span<uint8_t> dst, std::span<const uint8_t> src,
+                        uint16_t alpha) noexcept;
+  static void gammaAvx2(std::span<uint8_t> bytes) noexcept;
+
+  // Name of the kernel set the dispatching functions use
+  static const char *kernelName() noexcept;
+};
+
+// ===== FRAME =====
+// width x height pixels in one of two layouts:
+//
+//   Packed   one uint32_t 0x00RRGGBB per pixel - what RGBColor::getValue()
+//            returns, and what most display drivers want
+//   Planar   all reds, then all greens, then all blues - what LED drivers
+//            that shift out one channel at a time want
+//
+// The pad byte of a packed pixel is always 0 and every kernel keeps it 0.
+//
+// THREADS: frames of at least PARALLEL_MIN_BYTES are split into one
+// contiguous slice per thread (setThreads, default 1 = no threads).
+// Each slice is a separate run of the same kernel, so results are
+// identical for any thread count.
+
+class RGBFrame {
+public:
+  enum class Format : uint8_t { Packed, Planar };
+  enum Channel : uint8_t { RED, GREEN, BLUE };
+
+  static constexpr size_t PARALLEL_MIN_BYTES = size_t{256} << 10;
+
+  RGBFrame(size_t width, size_t height, Format format = Format::Packed);
+
+  size_t width() const noexcept { return frame_width; }
+  size_t height() const noexcept { return frame_height; }
+  size_t pixelCount() const noexcept { return frame_width * frame_height; }
+  Format format() const noexcept { return frame_format; }
+
+  // Single pixels as 0xRRGGBB, in either format
+  uint32_t pixel(size_t x, size_t y) const noexcept;
+  void setPixel(size_t x, size_t y, uint32_t rgb) noexcept;
+  void fill(uint32_t rgb) noexcept;
+
+  // Raw access: packed() only for Packed frames, plane() only for Planar
+  std::span<uint32_t> packed() noexcept { return {words.data(), pixelCount()}; }
+  std::span<const uint32_t> packed() const noexcept { return {words.data(), pixelCount()}; }
+  std::span<uint8_t> plane(Channel channel) noexcept;
+  std::span<const uint8_t> plane(Channel channel) const noexcept;
+
+  // Every channel byte the kernels touch (4 per pixel packed, 3 planar)
+  std::span<uint8_t> channelBytes() noexcept;
+  std::span<const uint8_t> channelBytes() const noexcept;
+
+  // Same pixels in the other layout
+  RGBFrame toPlanar() const;
+  RGBFrame toPacked() const;
+
+  // 0 = one thread per hardware core
+  void setThreads(unsigned threads) noexcept;
+  unsigned threads() const noexcept { return thread_count; }
+
+  // ===== WHOLE-FRAME OPERATIONS =====
+  void dim() noexcept;
+  void brighten() noexcept;
+  void scale(uint16_t fraction) noexcept;
+  void gamma() noexcept;
+
+  // Blend `src` over this frame. Both must have the same size and format;
+  // a mismatch asserts, and leaves the frame unchanged in release builds.
+  void blend(const RGBFrame &src, uint16_t alpha) noexcept;
+
+private:
+  // std::allocator on 64-byte boundaries, so forSlices' 64-byte slice
+  // boundaries are cache line boundaries too
+  template <typename T>
+  struct CacheLineAllocator {
+    using value_type = T;
+    static constexpr std::align_val_t ALIGNMENT{64};
+
+    CacheLineAllocator() noexcept = default;
+    template <typename U>
+    CacheLineAllocator(const CacheLineAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T), ALIGNMENT)); }
+    void deallocate(T *p, size_t) noexcept { ::operator delete(p, ALIGNMENT); }
+
+    friend bool operator==(const CacheLineAllocator &, const CacheLineAllocator &) noexcept {
+      return true;
+    }
+  };
+
+  // Run fn(begin, end) over [0, bytes) - in slices on threads if large
+  template <typename Fn>
+  void forSlices(size_t bytes, Fn fn) const noexcept;
+
+  size_t frame_width;
+  size_t frame_height;
+  Format frame_format;
+  unsigned thread_count = 1;
+  // uint32_t so packed pixels are real uint32_t objects; planar frames
+  // use the same storage as bytes
+  std::vector<uint32_t, CacheLineAllocator<uint32_t>> words;
+};
@@ -0,0 +1,162 @@
+/*
+RoaringBitmap - Compressed Set of 32-bit IDs
+A BitArray for IDs spread over the whole uint32_t range: dense stretches
+are stored as bits, sparse ones as sorted lists, so a set of 100 IDs costs
+bytes and a set of 10M IDs costs about a bit per ID.
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// ===== ROARING BITMAP =====
+// IDs are split 16 | 16: the high half picks a chunk, the low half is the
+// position inside it. Each non-empty chunk has one container:
+//
+//   Array    sorted uint16_t list     up to ARRAY_MAX values (<= 8 KB)
+//   Bitmap   1024 x uint64_t = 8 KB   more than ARRAY_MAX values
+//
+// 4096 values is where a sorted list gets as big as the bitmap, so a
+// container is never bigger than 8 KB and always uses the smaller form.
+// Every operation leaves each container in that form (canonical), so two
+// sets are equal exactly when their containers are.
+//
+//   &, |, -   (- is ANDNOT: in a, not in b) chunk by chunk, kinds mixed:
+//             bitmap/bitmap   BitKernels::applyWords (AVX2 when available)
+//             array/bitmap    test each listed value against the bits
+//             array/array     merge of two sorted lists
+//   count     per-container counts kept up to date - cardinality() is O(chunks);
+//             countAll/countAny size an AND/ANDNOT/OR without building it
+//   iterate   in ascending order; forEach() walks bitmap words with
+//             std::countr_zero, the iterator does the same one step at a time
+//
+// The roaring format also has run-length containers; they are left out
+// here - a bitmap already costs only 8 KB per 65536 IDs.
+
+class RoaringBitmap {
+public:
+  static constexpr size_t ARRAY_MAX = 4096;
+  static constexpr size_t CHUNK_WORDS = 65536 / 64;
+
+  RoaringBitmap() = default;
+
+  // ===== SINGLE IDS =====
+  void add(uint32_t id);
+  void remove(uint32_t id);
+  bool contains(uint32_t id) const noexcept;
+
+  // ===== WHOLE SET =====
+  size_t cardinality() const noexcept;
+  bool empty() const noexcept { return keys.empty(); }
+  void clear() noexcept;
+
+  RoaringBitmap &operator&=(const RoaringBitmap &other);
+  RoaringBitmap &operator|=(const RoaringBitmap &other);
+  RoaringBitmap &operator-=(const RoaringBitmap &other);
+
+  friend RoaringBitmap operator&(RoaringBitmap a, const RoaringBitmap &b) { return a &= b; }
+  friend RoaringBitmap operator|(RoaringBitmap a, const RoaringBitmap &b) { return a |= b; }
+  friend RoaringBitmap operator-(RoaringBitmap a, const RoaringBitmap &b) { return a -= b; }
+
+  bool operator==(const RoaringBitmap &other) const = default;
+
+  // ===== COUNT-ONLY =====
+  // |all[0] & all[1] & ... - none[0] - none[1] - ...| and the same with the
+  // union of `any`, without building the result: each chunk is combined
+  // in a buffer on the stack and counted, nothing is allocated. countAll
+  // visits only the chunks of all[0], so put the smallest set first.
+  static size_t countAll(std::span<const RoaringBitmap *const> all,
+                         std::span<const RoaringBitmap *const> none = {}) noexcept;
+  static size_t countAny(std::span<const RoaringBitmap *const> any,
+                         std::span<const RoaringBitmap *const> none = {}) noexcept;
+
+  // ===== ITERATION =====
+  // fn(id) for every ID, ascending
+  template <typename Fn>
+  void forEach(Fn fn) const {
+    for (size_t c = 0; c < keys.size(); c++) {
+      const uint32_t high = uint32_t{keys[c]} << 16;
+      const Container &container = containers[c];
+      if (container.isBitmap()) {
+        for (size_t w = 0; w < CHUNK_WORDS; w++) {
+          for (uint64_t word = container.words[w]; word; word &= word - 1) {
+            fn(high | static_cast<uint32_t>(w * 64 + std::countr_zero(word)));
+          }
+        }
+      } else {
+        for (uint16_t low : container.values) {
+          fn(high | low);
+        }
+      }
+    }
+  }
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const uint32_t *;
+    using reference = uint32_t;
+
+    const_iterator() = default;
+
+    uint32_t operator*() const noexcept { return current; }
+    const_iterator &operator++() noexcept {
+      next();
+      return *this;
+    }
+    const_iterator operator++(int) noexcept {
+      const_iterator before = *this;
+      next();
+      return before;
+    }
+    bool operator==(const const_iterator &other) const noexcept {
+      return container == other.container && current == other.current;
+    }
+
+  private:
+    friend class RoaringBitmap;
+    const_iterator(const RoaringBitmap *owner, size_t container) noexcept;
+    void enter(size_t index) noexcept;
+    void next() noexcept;
+
+    const RoaringBitmap *owner = nullptr;
+    size_t container = 0;
+    size_t position = 0; // next array index, or current bitmap word
+    uint64_t word = 0;   // bits of the current bitmap word not yet visited
+    uint32_t current = 0;
+  };
+
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, keys.size()}; }
+
+  // ===== MEMORY =====
+  size_t containerCount() const noexcept { return keys.size(); }
+  size_t bitmapContainerCount() const noexcept;
+  // Bytes of heap and object storage in use (not counting allocator slack)
+  size_t bytes() const noexcept;
+
+private:
+  struct Container {
+    std::vector<uint16_t> values; // Array: sorted low halves
+    std::vector<uint64_t> words;  // Bitmap: CHUNK_WORDS words
+    uint32_t count = 0;
+
+    bool isBitmap() const noexcept { return !words.empty(); }
+    bool operator==(const Container &other) const = default;
+  };
+
+  // Index of the container for `key`, or keys.size()
+  size_t find(uint16_t key) const noexcept;
+
+  std::vector<uint16_t> keys; // ascending
+  std::vector<Container> containers;
+
+  friend struct RoaringContainerOps;
+};
@@ -0,0 +1,180 @@
+/*
+SensorPacket Streams
+Batch encode/decode of packed SensorPacket words, and an append-only log
+file of them that can be memory-mapped and scanned without copying.
+*/
+
+#pragma once
+
+#include "mapped_file.hpp"
+#include "real_world.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ===== BATCH CODEC =====
+// A gateway receives SensorPacket words back to back. Decoding them one
+// getter at a time costs three shift/mask/store sequences per packet;
+// decode() does the same work 32 packets per step:
+//
+//   packets  uint16_t[n]  →  temperatures[n], humidities[n], lights[n]
+//
+//   x86 + AVX2     decodeAvx2/encodeAvx2  16-bit shifts + masks, then
+//                                         packus to bytes (32 per store)
+//   anything else  decodeScalar/...       SensorPacket::Layout::unpackAll/
+//                                         packAll (compiler-vectorized)
+//
+// Column layout is SensorPacket::Layout's: {temperature, humidity, light}.
+// The packet count sets the batch size; each column must hold that many.
+
+class SensorCodec {
+public:
+  using Layout = SensorPacket::Layout;
+
+  static void decode(std::span<const uint16_t> packets, const Layout::Columns &columns) noexcept;
+  static void encode(const Layout::ConstColumns &columns, std::span<uint16_t> packets) noexcept;
+
+  static void decodeScalar(std::span<const uint16_t> packets,
+                           const Layout::Columns &columns) noexcept;
+  static void encodeScalar(const Layout::ConstColumns &columns,
+                           std::span<uint16_t> packets) noexcept;
+
+  // x86 only - elsewhere these fall back to the scalar versions
+  static void decodeAvx2(std::span<const uint16_t> packets,
+                         const Layout::Columns &columns) noexcept;
+  static void encodeAvx2(const Layout::ConstColumns &columns,
+                         std::span<uint16_t> packets) noexcept;
+
+  // Name of the kernel pair decode/encode dispatch to
+  static const char *kernelName() noexcept;
+};
+
+// ===== LOG FILE FORMAT =====
+// Append-only, fixed-size blocks, little-endian (the byte order of every
+// target this code runs on):
+//
+//   offset 0      SensorLogHeader (64 bytes)
+//   offset 64     block 0:  SensorLogBlockHeader (16 bytes)
+//                           packets[PACKETS_PER_BLOCK] (uint16_t)
+//   offset 64+B   block 1 ...                         B = BLOCK_BYTES
+//
+// Every block is the same size, so block i starts at 64 + i * B and the
+// whole history maps straight into memory: the reader hands out spans
+// that point into the mapping, nothing is copied or parsed.
+//
+// A block with fewer than PACKETS_PER_BLOCK packets (written by flush())
+// keeps its full size; `count` says how many are real. Blocks carry their
+// sequence number, so a torn write at the end is detected and ignored.
+// Needs POSIX open/write/mmap; elsewhere only the codec is available and
+// the writer and reader fail to open with ENOSYS.
+
+struct SensorLogHeader {
+  char magic[8];                 // "SPKTLOG"
+  uint16_t version;              // SensorLog::VERSION
+  uint16_t header_bytes;         // sizeof(SensorLogHeader)
+  uint32_t block_bytes;          // SensorLog::BLOCK_BYTES
+  uint32_t packets_per_block;    // SensorLog::PACKETS_PER_BLOCK
+  uint8_t field_widths[4];       // 5, 5, 6, 0 - the SensorPacket layout
+  uint8_t reserved[40];
+};
+
+struct SensorLogBlockHeader {
+  uint32_t count;    // packets used in this block
+  uint32_t sequence; // 0, 1, 2, ... - equals the block's index
+  uint64_t first_ms; // timestamp of the first packet
+};
+
+static_assert(sizeof(SensorLogHeader) == 64, "header layout is part of the file format");
+static_assert(sizeof(SensorLogBlockHeader) == 16, "block header is part of the file format");
+
+class SensorLog {
+public:
+  static constexpr uint16_t VERSION = 1;
+  static constexpr uint32_t BLOCK_BYTES = 8192;
+  static constexpr uint32_t PACKETS_PER_BLOCK =
+      (BLOCK_BYTES - sizeof(SensorLogBlockHeader)) / sizeof(uint16_t); // 4088
+
+  // Header a new file starts with
+  static SensorLogHeader makeHeader() noexcept;
+
+  // Same format, version and packet layout as this build?
+  static bool headerValid(const SensorLogHeader &header) noexcept;
+};
+
+// ===== WRITER =====
+// Buffers one block in memory and appends it when full. Functions return
+// false on an I/O error (errno says why). A write that fails halfway is
+// cut back off the file and the block stays buffered, so a later flush()
+// retries it in place; if the file can't be cut back, the writer fails
+// every further write (hasFailed()) and the next open() drops the torn
+// block.
+
+class SensorLogWriter {
+public:
+  SensorLogWriter() = default;
+  ~SensorLogWriter();
+  SensorLogWriter(const SensorLogWriter &) = delete;
+  SensorLogWriter &operator=(const SensorLogWriter &) = delete;
+
+  // Create the file, or reopen it and continue after its last whole block
+  // (a torn block left by a crash is cut off first)
+  bool open(const char *path);
+
+  // `now_ms` is recorded as the block's first_ms when it starts a block
+  bool append(uint16_t packet, uint64_t now_ms);
+  bool append(std::span<const uint16_t> packets, uint64_t now_ms);
+
+  // Write the current partial block; the next append starts a new one
+  bool flush();
+
+  // flush() and close the file
+  bool close();
+
+  bool isOpen() const noexcept { return fd >= 0; }
+  uint32_t blocksWritten() const noexcept { return next_sequence; }
+  bool hasFailed() const noexcept { return failed; }
+
+private:
+  SensorLogBlockHeader &blockHeader() noexcept;
+  uint16_t *blockPackets() noexcept;
+
+  int fd = -1;
+  uint32_t next_sequence = 0;
+  bool failed = false; // torn bytes at the end of the file
+  std::vector<uint8_t> block; // BLOCK_BYTES, header + packets
+};
+
+// ===== READER =====
+// Maps the whole file read-only. Blocks are views into the mapping and
+// stay valid until close().
+
+class SensorLogReader {
+public:
+  struct Block {
+    uint32_t sequence;
+    uint64_t first_ms;
+    std::span<const uint16_t> packets;
+  };
+
+  // False if the file can't be mapped or its header doesn't match this build
+  bool open(const char *path);
+  void close() noexcept;
+
+  // Whole blocks, minus a tail block that was never completely written
+  size_t blockCount() const noexcept { return blocks; }
+  Block block(size_t index) const noexcept;
+
+  uint64_t packetCount() const noexcept;
+
+  template <typename Fn>
+  void forEachBlock(Fn fn) const {
+    for (size_t i = 0; i < blocks; i++) {
+      fn(block(i));
+    }
+  }
+
+private:
+  MappedFile file;
+  size_t blocks = 0;
+};
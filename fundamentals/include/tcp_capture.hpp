@@ -0,0 +1,232 @@
+/*
+TCP Capture Classifier
+TCPFlags over recorded traffic: map a pcap file, pull the flags byte out
+of every TCP segment in place, and count flag combinations and
+handshake/teardown patterns a whole column of flags at a time.
+*/
+
+#pragma once
+
+#include "mapped_file.hpp"
+#include "real_world.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+// ===== PCAP FILE FORMAT =====
+// Classic libpcap format (not pcapng), written in the byte order of the
+// machine that captured it - the magic number says which:
+//
+//   offset 0    PcapFileHeader (24 bytes)
+//   offset 24   PcapRecordHeader (16 bytes), captured_len bytes of packet
+//               PcapRecordHeader, packet, ...   (no padding, no index)
+//
+// MAGIC_MICRO / MAGIC_NANO: timestamps in microseconds / nanoseconds.
+// Either one byte-swapped means every header field is byte-swapped.
+
+struct PcapFileHeader {
+  uint32_t magic;
+  uint16_t version_major; // 2
+  uint16_t version_minor; // 4
+  int32_t thiszone;       // 0 in practice
+  uint32_t sigfigs;       // 0 in practice
+  uint32_t snaplen;       // longest packet prefix that was kept
+  uint32_t link_type;     // what the packet bytes start with
+};
+
+struct PcapRecordHeader {
+  uint32_t ts_sec;
+  uint32_t ts_frac;      // microseconds or nanoseconds
+  uint32_t captured_len; // bytes that follow in the file
+  uint32_t original_len; // length on the wire
+};
+
+static_assert(sizeof(PcapFileHeader) == 24, "header layout is part of the file format");
+static_assert(sizeof(PcapRecordHeader) == 16, "record header is part of the file format");
+
+class Pcap {
+public:
+  static constexpr uint32_t MAGIC_MICRO = 0xA1B2C3D4;
+  static constexpr uint32_t MAGIC_NANO = 0xA1B23C4D;
+
+  // Link types this code can find TCP headers in
+  static constexpr uint32_t LINK_ETHERNET = 1;    // Ethernet II, 802.1Q/802.1ad tags
+  static constexpr uint32_t LINK_RAW = 101;       // bare IPv4 or IPv6
+  static constexpr uint32_t LINK_LINUX_SLL = 113; // "any" interface captures
+  static constexpr uint32_t LINK_IPV4 = 228;
+  static constexpr uint32_t LINK_IPV6 = 229;
+
+  // Header for a new capture in this machine's byte order
+  static PcapFileHeader makeHeader(uint32_t link_type, uint32_t snaplen = 65535,
+                                   bool nanoseconds = false) noexcept;
+
+  // For captures written in the other byte order (compilers turn these
+  // into a single bswap/rev)
+  static constexpr uint16_t byteSwap16(uint16_t value) noexcept {
+    return static_cast<uint16_t>((value << 8) | (value >> 8));
+  }
+  static constexpr uint32_t byteSwap32(uint32_t value) noexcept {
+    return (value << 24) | ((value << 8) & 0x00FF0000) | ((value >> 8) & 0x0000FF00) |
+           (value >> 24);
+  }
+};
+
+// ===== READER =====
+// Maps the whole file read-only; records are views into the mapping and
+// stay valid until close(). Walking the records is sequential by nature
+// (each header gives the next one's offset), so forEachRecord is a plain
+// loop - no packet is copied.
+// Needs POSIX mmap: elsewhere open() fails with ENOSYS, and only the flag
+// kernels and TCPFlagClassifier::addFlags() are usable.
+
+class PcapReader {
+public:
+  struct Record {
+    uint32_t ts_sec;
+    uint32_t ts_frac;
+    uint32_t original_len;
+    std::span<const uint8_t> data; // captured bytes, in the mapping
+  };
+
+  // False (errno = EINVAL for an unknown format) if it can't be used
+  bool open(const char *path);
+  void close() noexcept;
+
+  bool isOpen() const noexcept { return file.isOpen(); }
+  uint32_t linkType() const noexcept { return header.link_type; }
+  uint32_t snaplen() const noexcept { return header.snaplen; }
+  bool nanosecondTimestamps() const noexcept { return nanoseconds; }
+  bool byteSwapped() const noexcept { return swapped; }
+
+  // fn(record) for every whole record; a record cut off by the end of the
+  // file (capture killed mid-write) is skipped and sets truncated()
+  template <typename Fn>
+  size_t forEachRecord(Fn fn) const {
+    size_t count = 0;
+    size_t offset = sizeof(PcapFileHeader);
+    truncated_tail = false;
+    const uint8_t *base = file.data();
+    const size_t mapped_bytes = file.size();
+    while (offset + sizeof(PcapRecordHeader) <= mapped_bytes) {
+      PcapRecordHeader rec;
+      std::memcpy(&rec, base + offset, sizeof(rec)); // records aren't aligned
+      const uint32_t captured = hostOrder(rec.captured_len);
+      offset += sizeof(PcapRecordHeader);
+      if (captured > mapped_bytes - offset) {
+        truncated_tail = true;
+        return count;
+      }
+      fn(Record{hostOrder(rec.ts_sec), hostOrder(rec.ts_frac), hostOrder(rec.original_len),
+                {base + offset, captured}});
+      offset += captured;
+      count++;
+    }
+    truncated_tail = offset != mapped_bytes;
+    return count;
+  }
+
+  // Did the last forEachRecord stop at a partial record?
+  bool truncated() const noexcept { return truncated_tail; }
+
+private:
+  uint32_t hostOrder(uint32_t value) const noexcept {
+    return swapped ? Pcap::byteSwap32(value) : value;
+  }
+
+  MappedFile file;
+  PcapFileHeader header{};
+  bool swapped = false;
+  bool nanoseconds = false;
+  mutable bool truncated_tail = false;
+};
+
+// ===== FLAG PATTERNS =====
+// A pattern matches a flags byte when (flags & mask) == value. The first
+// three are TCPFlags' own checks; SYN vs SYN-ACK is what splits opening a
+// connection from accepting one.
+
+struct TCPFlagPattern {
+  const char *name;
+  uint8_t mask;
+  uint8_t value;
+
+  constexpr bool matches(uint8_t flags) const noexcept { return (flags & mask) == value; }
+};
+
+inline constexpr std::array<TCPFlagPattern, 5> TCP_FLAG_PATTERNS = {{
+    {"SYN", TCPFlags::SYN | TCPFlags::ACK, TCPFlags::SYN},                      // handshake 1
+    {"SYN-ACK", TCPFlags::SYN | TCPFlags::ACK, TCPFlags::SYN | TCPFlags::ACK},  // handshake 2
+    {"FIN-ACK", TCPFlags::FIN | TCPFlags::ACK, TCPFlags::FIN | TCPFlags::ACK},  // teardown
+    {"FIN (no ACK)", TCPFlags::FIN | TCPFlags::ACK, TCPFlags::FIN},             // scans
+    {"RST", TCPFlags::RST, TCPFlags::RST},                                      // abort
+}};
+
+// ===== KERNELS =====
+//
+//   tcpFlags     one frame: link header → IPv4/IPv6 → TCP byte 13, or -1
+//                (not TCP, not the first fragment, or cut short by snaplen)
+//   histogram    bins[flags]++ over a column, 4 interleaved bin sets so
+//                repeats of one value don't wait on each other
+//   match        one bit per packet for a pattern, plus the count.
+//                Dispatch, like BitKernels:
+//                  x86 + AVX2     matchAvx2    AND + compare 32 flags at a
+//                                              time, movemask to bits
+//                  anything else  matchScalar  one flag per step
+
+class TCPFlagKernels {
+public:
+  static int tcpFlags(std::span<const uint8_t> frame, uint32_t link_type) noexcept;
+
+  // Adds to bins (does not clear them)
+  static void histogram(std::span<const uint8_t> flags, std::array<uint64_t, 256> &bins) noexcept;
+
+  // bits[i / 64] bit (i % 64) = pattern matches flags[i]; bits needs
+  // (flags.size() + 63) / 64 words. Returns the number of matches.
+  static size_t match(std::span<const uint8_t> flags, const TCPFlagPattern &pattern,
+                      std::span<uint64_t> bits) noexcept;
+  static size_t matchScalar(std::span<const uint8_t> flags, const TCPFlagPattern &pattern,
+                            std::span<uint64_t> bits) noexcept;
+  // x86 only - elsewhere this falls back to the scalar version
+  static size_t matchAvx2(std::span<const uint8_t> flags, const TCPFlagPattern &pattern,
+                          std::span<uint64_t> bits) noexcept;
+
+  // Name of the kernel match() dispatches to
+  static const char *kernelName() noexcept;
+};
+
+// ===== CLASSIFIER =====
+// Extracts flags into a CHUNK-sized column, then histograms and matches
+// the column - the per-packet work is one header walk and one byte store,
+// everything else runs over contiguous bytes.
+
+struct TCPFlagReport {
+  uint64_t records = 0;      // packets in the capture
+  uint64_t tcp_segments = 0; // packets with a TCP flags byte
+  std::array<uint64_t, 256> histogram{};
+  std::array<uint64_t, TCP_FLAG_PATTERNS.size()> patterns{};
+
+  bool operator==(const TCPFlagReport &) const = default;
+};
+
+class TCPFlagClassifier {
+public:
+  static constexpr size_t CHUNK = 64 * 1024;
+
+  TCPFlagClassifier();
+
+  // Every record of an open capture
+  void addCapture(const PcapReader &reader);
+  // A column of flags bytes that came from somewhere else
+  void addFlags(std::span<const uint8_t> flags);
+
+  const TCPFlagReport &report() const noexcept { return totals; }
+  void reset() noexcept { totals = {}; }
+
+private:
+  TCPFlagReport totals;
+  std::vector<uint8_t> column;
+  std::vector<uint64_t> match_bits;
+};
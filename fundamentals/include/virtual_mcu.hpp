@@ -0,0 +1,282 @@
+/*
+Virtual AVR I/O
+One host-side model of an ATmega328P's GPIO registers - what GPIOPort,
+DigitalPin and MicroController each sketch a different way - that also
+counts cycles and records every register change, so digitalWrite-style
+code and direct port manipulation can be compared before flashing.
+*/
+
+#pragma once
+
+#include "advanced.hpp"
+#include "basics.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===== PORTS AND PINS =====
+// Three 8-bit ports, three registers each:
+//
+//   DDRx   direction, 1 = output
+//   PORTx  level driven by an output, pull-up enable for an input
+//   PINx   what the pins read; writing 1s to it toggles those PORTx bits
+//
+// Arduino Uno pin numbers map onto them:
+//   0..7 → PORTD bit 0..7   8..13 → PORTB bit 0..5   14..19 (A0..A5) → PORTC bit 0..5
+//
+// PINx isn't stored: it follows from DDRx, PORTx and whatever the host
+// drives onto the input pins.
+
+enum class AVRPort : uint8_t { B, C, D };
+enum class AVRRegister : uint8_t { DDR, PORT };
+
+struct AVRPin {
+  AVRPort port;
+  uint8_t mask; // the pin's bit; 0 for a pin number the board doesn't have
+
+  constexpr bool valid() const noexcept { return mask != 0; }
+};
+
+// ===== CYCLE COSTS =====
+// Direct port code compiles to single instructions (counted with their
+// constants already in registers). The Arduino calls are approximate
+// averages for the AVR core's digitalWrite/digitalRead/pinMode at -Os:
+// pin → port lookups in flash, the PWM timer check, SREG save + cli.
+// Change them to model another core or compiler.
+
+struct AVRCycleCosts {
+  uint32_t in = 1;      // IN: read a whole register
+  uint32_t out = 1;     // OUT: write a whole register (or PINx, to toggle)
+  uint32_t sbi_cbi = 2; // SBI/CBI: set or clear one bit in place
+  uint32_t alu = 1;     // ORI/ANDI/EOR on a working register
+  uint32_t atomic = 3;  // IN SREG, CLI ... OUT SREG around a transaction
+  uint32_t digital_write = 56;
+  uint32_t digital_read = 52;
+  uint32_t pin_mode = 60;
+};
+
+// ===== TRACE =====
+
+struct AVRTraceEntry {
+  uint64_t cycle; // cycle count when the write completed
+  AVRPort port;
+  AVRRegister reg;
+  uint8_t before;
+  uint8_t after;
+
+  bool operator==(const AVRTraceEntry &) const = default;
+};
+
+// Registers in the model: DDRB, PORTB, DDRC, PORTC, DDRD, PORTD
+constexpr size_t avrRegisterIndex(AVRPort port, AVRRegister reg) noexcept {
+  return static_cast<size_t>(port) * 2 + static_cast<size_t>(reg);
+}
+
+// ===== TRANSACTIONS =====
+// Port writes queued up and applied by VirtualAVR::apply() as one atomic
+// step: interrupts off, each touched register read once (unless the batch
+// overwrites it first), every change folded into a working register,
+// written once, interrupts back on. All of it lands on the same cycle, so
+// nothing in between is ever visible on the pins.
+
+class AVRTransaction {
+public:
+  AVRTransaction &write(AVRPort port, uint8_t value) { return push(port, AVRRegister::PORT, Kind::Write, value); }
+  AVRTransaction &setHigh(AVRPort port, uint8_t mask) { return push(port, AVRRegister::PORT, Kind::Set, mask); }
+  AVRTransaction &setLow(AVRPort port, uint8_t mask) { return push(port, AVRRegister::PORT, Kind::Clear, mask); }
+  AVRTransaction &toggle(AVRPort port, uint8_t mask) { return push(port, AVRRegister::PORT, Kind::Toggle, mask); }
+  AVRTransaction &setDirection(AVRPort port, uint8_t value) { return push(port, AVRRegister::DDR, Kind::Write, value); }
+  AVRTransaction &setOutputs(AVRPort port, uint8_t mask) { return push(port, AVRRegister::DDR, Kind::Set, mask); }
+  AVRTransaction &setInputs(AVRPort port, uint8_t mask) { return push(port, AVRRegister::DDR, Kind::Clear, mask); }
+
+  // Arduino pin numbers; a pin the board doesn't have is ignored
+  AVRTransaction &digitalWrite(uint8_t pin, bool value);
+  AVRTransaction &pinMode(uint8_t pin, PinMode mode);
+
+  size_t size() const noexcept { return ops.size(); }
+  bool empty() const noexcept { return ops.empty(); }
+  void clear() noexcept { ops.clear(); }
+
+private:
+  friend class VirtualAVR;
+
+  enum class Kind : uint8_t { Write, Set, Clear, Toggle };
+
+  struct Op {
+    uint8_t reg; // avrRegisterIndex()
+    Kind kind;
+    uint8_t mask;
+  };
+
+  AVRTransaction &push(AVRPort port, AVRRegister reg, Kind kind, uint8_t mask) {
+    ops.push_back({static_cast<uint8_t>(avrRegisterIndex(port, reg)), kind, mask});
+    return *this;
+  }
+
+  std::vector<Op> ops;
+};
+
+// ===== VIRTUAL MCU =====
+// Every operation adds its cost to cycles() and counts as one of
+// operations() (a transaction counts each queued op). With tracing on,
+// every DDRx/PORTx write that changes the register appends an entry.
+//
+//   direct port manipulation   write/setHigh/setLow/toggle/read,
+//                              setDirection/setOutputs/setInputs
+//   Arduino calls              pinMode/digitalWrite/digitalRead
+//   batched                    apply(AVRTransaction)
+//   host side (free)           drive/release input pins, inspect registers
+
+class VirtualAVR {
+public:
+  static constexpr size_t PORTS = 3;
+  static constexpr size_t REGISTERS = PORTS * 2;
+  static constexpr uint32_t CLOCK_HZ = MicroController::DEFAULT_CLOCK;
+
+  explicit VirtualAVR(const AVRCycleCosts &costs = {}) noexcept : costs(costs) {}
+
+  static constexpr AVRPin arduinoPin(uint8_t pin) noexcept {
+    if (pin < 8) {
+      return {AVRPort::D, static_cast<uint8_t>(1 << pin)};
+    }
+    if (pin < 14) {
+      return {AVRPort::B, static_cast<uint8_t>(1 << (pin - 8))};
+    }
+    if (pin < 20) {
+      return {AVRPort::C, static_cast<uint8_t>(1 << (pin - 14))};
+    }
+    return {AVRPort::B, 0};
+  }
+
+  // ----- Direct port manipulation (GPIOPort's operations) -----
+
+  // PORTx = value
+  void write(AVRPort port, uint8_t value) {
+    charge(costs.out);
+    store(avrRegisterIndex(port, AVRRegister::PORT), value);
+  }
+
+  // PORTx |= mask: SBI for one bit, IN/ORI/OUT for more
+  void setHigh(AVRPort port, uint8_t mask) {
+    const size_t r = avrRegisterIndex(port, AVRRegister::PORT);
+    charge(bitCost(mask));
+    store(r, regs[r] | mask);
+  }
+
+  // PORTx &= ~mask: CBI for one bit, IN/ANDI/OUT for more
+  void setLow(AVRPort port, uint8_t mask) {
+    const size_t r = avrRegisterIndex(port, AVRRegister::PORT);
+    charge(bitCost(mask));
+    store(r, regs[r] & ~mask);
+  }
+
+  // PINx = mask: the hardware flips those PORTx bits, one OUT
+  void toggle(AVRPort port, uint8_t mask) {
+    const size_t r = avrRegisterIndex(port, AVRRegister::PORT);
+    charge(costs.out);
+    store(r, regs[r] ^ mask);
+  }
+
+  // DDRx = value
+  void setDirection(AVRPort port, uint8_t value) {
+    charge(costs.out);
+    store(avrRegisterIndex(port, AVRRegister::DDR), value);
+  }
+
+  void setOutputs(AVRPort port, uint8_t mask) {
+    const size_t r = avrRegisterIndex(port, AVRRegister::DDR);
+    charge(bitCost(mask));
+    store(r, regs[r] | mask);
+  }
+
+  void setInputs(AVRPort port, uint8_t mask) {
+    const size_t r = avrRegisterIndex(port, AVRRegister::DDR);
+    charge(bitCost(mask));
+    store(r, regs[r] & ~mask);
+  }
+
+  // PINx, one IN
+  uint8_t read(AVRPort port) {
+    charge(costs.in);
+    return pinRegister(port);
+  }
+
+  // ----- Arduino calls (DigitalPin's operations, Uno pin numbers) -----
+  // Charged even for a pin the board doesn't have (the core still does
+  // the lookup); those return false and change nothing.
+
+  bool pinMode(uint8_t pin, PinMode mode);
+  bool digitalWrite(uint8_t pin, bool value);
+  bool digitalRead(uint8_t pin);
+
+  // ----- Batched -----
+
+  void apply(const AVRTransaction &transaction);
+
+  // ----- Host side: no cycles, no operations -----
+
+  // What the outside world puts on input pins (mask bits; outputs ignore it)
+  void drive(AVRPort port, uint8_t mask, uint8_t levels) noexcept {
+    const size_t p = static_cast<size_t>(port);
+    driven[p] |= mask;
+    levels_in[p] = static_cast<uint8_t>((levels_in[p] & ~mask) | (levels & mask));
+  }
+  // Undriven inputs read their pull-up: high if PORTx has the bit set
+  void release(AVRPort port, uint8_t mask) noexcept { driven[static_cast<size_t>(port)] &= ~mask; }
+
+  uint8_t portRegister(AVRPort port) const noexcept { return regs[avrRegisterIndex(port, AVRRegister::PORT)]; }
+  uint8_t ddrRegister(AVRPort port) const noexcept { return regs[avrRegisterIndex(port, AVRRegister::DDR)]; }
+  uint8_t pinRegister(AVRPort port) const noexcept {
+    const size_t p = static_cast<size_t>(port);
+    const uint8_t ddr = ddrRegister(port);
+    const uint8_t external = static_cast<uint8_t>(driven[p] & ~ddr);
+    return static_cast<uint8_t>((portRegister(port) & ~external) | (levels_in[p] & external));
+  }
+
+  uint64_t cycles() const noexcept { return cycle_count; }
+  uint64_t operations() const noexcept { return operation_count; }
+  double microseconds() const noexcept { return static_cast<double>(cycle_count) * 1e6 / CLOCK_HZ; }
+  const AVRCycleCosts &cycleCosts() const noexcept { return costs; }
+
+  void setTracing(bool on) noexcept { tracing = on; }
+  bool isTracing() const noexcept { return tracing; }
+  const std::vector<AVRTraceEntry> &trace() const noexcept { return entries; }
+  void clearTrace() noexcept { entries.clear(); }
+
+  // Registers, inputs, counters and trace back to power-on (tracing and
+  // cycle costs are kept)
+  void reset() noexcept;
+
+private:
+  uint32_t bitCost(uint8_t mask) const noexcept {
+    if (mask == 0) {
+      return 0;
+    }
+    return std::has_single_bit(mask) ? costs.sbi_cbi : costs.in + costs.alu + costs.out;
+  }
+
+  void charge(uint32_t cycles) noexcept {
+    cycle_count += cycles;
+    operation_count++;
+  }
+
+  void store(size_t r, uint8_t value) {
+    if (tracing && regs[r] != value) {
+      record(r, value);
+    }
+    regs[r] = value;
+  }
+
+  void record(size_t r, uint8_t value);
+
+  AVRCycleCosts costs;
+  std::array<uint8_t, REGISTERS> regs{};
+  std::array<uint8_t, PORTS> driven{};
+  std::array<uint8_t, PORTS> levels_in{};
+  uint64_t cycle_count = 0;
+  uint64_t operation_count = 0;
+  bool tracing = false;
+  std::vector<AVRTraceEntry> entries;
+};
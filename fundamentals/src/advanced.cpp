@@ -127,23 +127,23 @@ void static_functions_demo() {
   uint8_t byte = 0b00000000;
   std::cout << "Initial: " << std::bitset<8>(byte) << std::endl;
 
-  byte = BitManipulation::setBit(byte, 3); // Set bit 3
+  byte = BitManipulation<>::setBit(byte, 3); // Set bit 3
   std::cout << "After setBit(3): " << std::bitset<8>(byte) << std::endl;
 
-  byte = BitManipulation::setBit(byte, 7); // Set bit 7
+  byte = BitManipulation<>::setBit(byte, 7); // Set bit 7
   std::cout << "After setBit(7): " << std::bitset<8>(byte) << std::endl;
 
-  byte = BitManipulation::clearBit(byte, 3); // Clear bit 3
+  byte = BitManipulation<>::clearBit(byte, 3); // Clear bit 3
   std::cout << "After clearBit(3): " << std::bitset<8>(byte) << std::endl;
 
-  byte = BitManipulation::toggleBit(byte, 7); // Toggle bit 7
+  byte = BitManipulation<>::toggleBit(byte, 7); // Toggle bit 7
   std::cout << "After toggleBit(7): " << std::bitset<8>(byte) << std::endl;
 
-  bool isSet = BitManipulation::isBitSet(byte, 7);
+  bool isSet = BitManipulation<>::isBitSet(byte, 7);
   std::cout << "Is bit 7 set? " << (isSet ? "YES" : "NO") << std::endl;
 
   // Access static constants
-  std::cout << "ALL_BITS_SET: " << std::bitset<8>(BitManipulation::ALL_BITS_SET)
+  std::cout << "ALL_BITS_SET: " << std::bitset<8>(BitManipulation<>::ALL_BITS_SET)
             << std::endl;
 
   // ===== ARDUINO STATIC UTILITIES =====
@@ -0,0 +1,86 @@
+#include "bit_array.hpp"
+#include "bit_kernels.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+BitArray::BitArray(size_t num_bits, bool value)
+    : words(wordsFor(num_bits), value ? ~uint64_t{0} : 0), bits(num_bits) {
+  trimTail();
+}
+
+void BitArray::resize(size_t new_bits) {
+  // trimTail() keeps the bits past size() at 0, so growing inside the
+  // last word already reads as 0
+  words.resize(wordsFor(new_bits), 0);
+  bits = new_bits;
+  trimTail();
+}
+
+void BitArray::setAll() noexcept {
+  std::fill(words.begin(), words.end(), ~uint64_t{0});
+  trimTail();
+}
+
+void BitArray::clearAll() noexcept { std::fill(words.begin(), words.end(), 0); }
+
+size_t BitArray::count() const noexcept {
+  // Tail bits are 0, so counting whole words is exact
+  return BitKernels::countBits({reinterpret_cast<const uint8_t *>(words.data()),
+                                words.size() * sizeof(uint64_t)});
+}
+
+size_t BitArray::findFirstSet(size_t from) const noexcept {
+  if (from >= bits) {
+    return npos;
+  }
+  size_t w = from / WORD_BITS;
+  // Drop the bits below `from` in the first word
+  uint64_t word = words[w] & (~uint64_t{0} << (from % WORD_BITS));
+  while (word == 0) {
+    if (++w == words.size()) {
+      return npos;
+    }
+    word = words[w];
+  }
+  return w * WORD_BITS + static_cast<size_t>(std::countr_zero(word));
+}
+
+// Sizes should match (asserted in debug builds). If they don't, only the
+// words both arrays have are combined: bits `other` lacks count as 0 and
+// its bits past this array's size are dropped - never a read past its end.
+static void combineWords(BitKernels::WordOp op, std::vector<uint64_t> &dst,
+                         const std::vector<uint64_t> &src) noexcept {
+  const size_t shared = std::min(dst.size(), src.size());
+  BitKernels::applyWords(op, std::span(dst).first(shared), std::span(src).first(shared));
+  if (op == BitKernels::WordOp::And) {
+    std::fill(dst.begin() + static_cast<ptrdiff_t>(shared), dst.end(), 0);
+  }
+}
+
+BitArray &BitArray::operator&=(const BitArray &other) noexcept {
+  assert(size() == other.size() && "BitArray &= needs arrays of the same size");
+  combineWords(BitKernels::WordOp::And, words, other.words);
+  return *this;
+}
+
+BitArray &BitArray::operator|=(const BitArray &other) noexcept {
+  assert(size() == other.size() && "BitArray |= needs arrays of the same size");
+  combineWords(BitKernels::WordOp::Or, words, other.words);
+  trimTail();
+  return *this;
+}
+
+BitArray &BitArray::operator^=(const BitArray &other) noexcept {
+  assert(size() == other.size() && "BitArray ^= needs arrays of the same size");
+  combineWords(BitKernels::WordOp::Xor, words, other.words);
+  trimTail();
+  return *this;
+}
+
+void BitArray::trimTail() noexcept {
+  const size_t used = bits % WORD_BITS;
+  if (used != 0) {
+    words.back() &= (uint64_t{1} << used) - 1;
+  }
+}
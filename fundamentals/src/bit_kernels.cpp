@@ -0,0 +1,436 @@
+#include "bit_kernels.hpp"
+#include "advanced.hpp"
+#include "bitwise.hpp"
+#include "cpu_features.hpp"
+#include <bit>
+#include <cstring>
+
+// ===== HELPERS =====
+
+// Unaligned 8-byte load (memcpy compiles to a single mov)
+static inline uint64_t load64(const uint8_t *p) noexcept {
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Unaligned 8-byte store
+static inline void store64(uint8_t *p, uint64_t word) noexcept {
+  std::memcpy(p, &word, sizeof(word));
+}
+
+// Shared body of the word kernels. always_inline so each caller below is
+// compiled with its own target flags (plain vs POPCNT)
+[[gnu::always_inline]] static inline size_t
+countWords64(const uint8_t *data, size_t size) noexcept {
+  size_t count = 0;
+  size_t i = 0;
+  // 4 independent words per iteration - keeps several popcounts in flight
+  for (; i + 32 <= size; i += 32) {
+    count += std::popcount(load64(data + i)) + std::popcount(load64(data + i + 8)) +
+             std::popcount(load64(data + i + 16)) +
+             std::popcount(load64(data + i + 24));
+  }
+  for (; i + 8 <= size; i += 8) {
+    count += std::popcount(load64(data + i));
+  }
+  for (; i < size; i++) {
+    count += std::popcount(data[i]);
+  }
+  return count;
+}
+
+// ===== PORTABLE KERNELS =====
+
+size_t BitKernels::countBitsBytewise(std::span<const uint8_t> bytes) noexcept {
+  size_t count = 0;
+  for (uint8_t byte : bytes) {
+    count += Bitwise<>::countBits(byte);
+  }
+  return count;
+}
+
+size_t BitKernels::countBitsNibbleLut(std::span<const uint8_t> bytes) noexcept {
+  // Set bits in 0x0..0xF - 16 bytes, fits in flash/PROGMEM on AVR
+  static constexpr uint8_t NIBBLE_BITS[16] = {0, 1, 1, 2, 1, 2, 2, 3,
+                                              1, 2, 2, 3, 2, 3, 3, 4};
+  size_t count = 0;
+  for (uint8_t byte : bytes) {
+    count += NIBBLE_BITS[byte & 0x0F] + NIBBLE_BITS[byte >> 4];
+  }
+  return count;
+}
+
+size_t BitKernels::countBitsWords64(std::span<const uint8_t> bytes) noexcept {
+  return countWords64(bytes.data(), bytes.size());
+}
+
+void BitKernels::reverseBitsLoop(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept {
+  for (size_t i = 0; i < src.size(); i++) {
+    dst[i] = ByteOps::reverseBits(src[i]);
+  }
+}
+
+void BitKernels::reverseBitsLut(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept {
+  for (size_t i = 0; i < src.size(); i++) {
+    dst[i] = ByteOps::reverseBitsLut(src[i]);
+  }
+}
+
+// Same swaps as ByteOps::reverseBits16/32, minus the final byte swap -
+// that keeps all 8 bytes of the word in place, each one reversed
+void BitKernels::reverseBitsWords64(std::span<const uint8_t> src,
+                                    std::span<uint8_t> dst) noexcept {
+  const size_t size = src.size();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t w = load64(src.data() + i);
+    w = ((w >> 1) & 0x5555555555555555ull) | ((w & 0x5555555555555555ull) << 1);
+    w = ((w >> 2) & 0x3333333333333333ull) | ((w & 0x3333333333333333ull) << 2);
+    w = ((w >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((w & 0x0F0F0F0F0F0F0F0Full) << 4);
+    store64(dst.data() + i, w);
+  }
+  for (; i < size; i++) {
+    dst[i] = ByteOps::reverseBitsLut(src[i]);
+  }
+}
+
+// One word of a boolean op; Op is a template argument so each kernel
+// below gets its own tight loop instead of a branch per word
+using WordOp = BitKernels::WordOp;
+
+template <WordOp Op>
+static constexpr uint64_t applyOne(uint64_t a, uint64_t b) noexcept {
+  if constexpr (Op == WordOp::And) {
+    return a & b;
+  } else if constexpr (Op == WordOp::Or) {
+    return a | b;
+  } else if constexpr (Op == WordOp::Xor) {
+    return a ^ b;
+  } else {
+    return a & ~b;
+  }
+}
+
+template <WordOp Op>
+[[gnu::always_inline]] static inline void applyEach(uint64_t *dst, const uint64_t *src,
+                                                    size_t count) noexcept {
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = applyOne<Op>(dst[i], src[i]);
+  }
+}
+
+void BitKernels::applyWords64(WordOp op, std::span<uint64_t> dst,
+                              std::span<const uint64_t> src) noexcept {
+  switch (op) {
+  case WordOp::And:
+    applyEach<WordOp::And>(dst.data(), src.data(), dst.size());
+    break;
+  case WordOp::Or:
+    applyEach<WordOp::Or>(dst.data(), src.data(), dst.size());
+    break;
+  case WordOp::Xor:
+    applyEach<WordOp::Xor>(dst.data(), src.data(), dst.size());
+    break;
+  case WordOp::AndNot:
+    applyEach<WordOp::AndNot>(dst.data(), src.data(), dst.size());
+    break;
+  }
+}
+
+// ===== x86 KERNELS =====
+
+#ifdef CPU_X86
+
+[[gnu::target("popcnt")]] size_t
+BitKernels::countBitsWords64Popcnt(std::span<const uint8_t> bytes) noexcept {
+  return countWords64(bytes.data(), bytes.size());
+}
+
+// Popcount of each 64-bit lane: look up both nibbles of every byte with
+// PSHUFB, then add the byte counts horizontally with SAD against zero
+[[gnu::target("avx2")]] static inline __m256i popcount256(__m256i v) noexcept {
+  const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                       0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0F);
+  __m256i lo = _mm256_and_si256(v, low_mask);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+  return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+// Carry-save adder: a + b + c = 2*high + low, bit by bit
+[[gnu::target("avx2")]] static inline void csa(__m256i &high, __m256i &low, __m256i a, __m256i b,
+                                               __m256i c) noexcept {
+  __m256i u = _mm256_xor_si256(a, b);
+  high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+  low = _mm256_xor_si256(u, c);
+}
+
+[[gnu::target("avx2")]] static inline __m256i load256(const uint8_t *p) noexcept {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+// Harley-Seal: 16 vectors are folded through a tree of carry-save adders
+// into ones/twos/fours/eights counters; only the "sixteens" output is
+// popcounted per block, so the expensive step runs once per 512 bytes.
+[[gnu::target("avx2")]] size_t
+BitKernels::countBitsHarleySeal(std::span<const uint8_t> bytes) noexcept {
+  const uint8_t *data = bytes.data();
+  const size_t size = bytes.size();
+  // Short of two vectors, folding the five leftover counters below costs
+  // more than popcounting the words one at a time
+  if (size < 64) {
+    return countBitsWords64Popcnt(bytes);
+  }
+  __m256i total = _mm256_setzero_si256();
+  __m256i ones = _mm256_setzero_si256();
+  __m256i twos = _mm256_setzero_si256();
+  __m256i fours = _mm256_setzero_si256();
+  __m256i eights = _mm256_setzero_si256();
+  __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+
+  size_t i = 0;
+  for (; i + 512 <= size; i += 512) {
+    const uint8_t *p = data + i;
+    csa(twos_a, ones, ones, load256(p + 0 * 32), load256(p + 1 * 32));
+    csa(twos_b, ones, ones, load256(p + 2 * 32), load256(p + 3 * 32));
+    csa(fours_a, twos, twos, twos_a, twos_b);
+    csa(twos_a, ones, ones, load256(p + 4 * 32), load256(p + 5 * 32));
+    csa(twos_b, ones, ones, load256(p + 6 * 32), load256(p + 7 * 32));
+    csa(fours_b, twos, twos, twos_a, twos_b);
+    csa(eights_a, fours, fours, fours_a, fours_b);
+    csa(twos_a, ones, ones, load256(p + 8 * 32), load256(p + 9 * 32));
+    csa(twos_b, ones, ones, load256(p + 10 * 32), load256(p + 11 * 32));
+    csa(fours_a, twos, twos, twos_a, twos_b);
+    csa(twos_a, ones, ones, load256(p + 12 * 32), load256(p + 13 * 32));
+    csa(twos_b, ones, ones, load256(p + 14 * 32), load256(p + 15 * 32));
+    csa(fours_b, twos, twos, twos_a, twos_b);
+    csa(eights_b, fours, fours, fours_a, fours_b);
+    csa(sixteens, eights, eights, eights_a, eights_b);
+    total = _mm256_add_epi64(total, popcount256(sixteens));
+  }
+
+  // Weight each leftover counter by its place value
+  total = _mm256_slli_epi64(total, 4);
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(eights), 3));
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(fours), 2));
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+  total = _mm256_add_epi64(total, popcount256(ones));
+
+  for (; i + 32 <= size; i += 32) {
+    total = _mm256_add_epi64(total, popcount256(load256(data + i)));
+  }
+
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), total);
+  size_t count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  return count + countBitsWords64Popcnt(bytes.subspan(i));
+}
+
+// Reverse each nibble with a 16-entry PSHUFB table and swap the two
+// nibbles in the same step: the low nibble's reversal goes high and vice
+// versa. 32 bytes per iteration, 2 shuffles + 4 logic ops.
+[[gnu::target("avx2")]] void BitKernels::reverseBitsPshufb(std::span<const uint8_t> src,
+                                                           std::span<uint8_t> dst) noexcept {
+  // Reversed nibble in the low half of a byte, and the same shifted high
+  // (values are <= 0x0F, so a 16-bit shift can't carry between bytes)
+  const __m256i rev_lo = _mm256_setr_epi8(0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5,
+                                          0xD, 0x3, 0xB, 0x7, 0xF, 0x0, 0x8, 0x4, 0xC, 0x2, 0xA,
+                                          0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+  const __m256i rev_hi = _mm256_slli_epi16(rev_lo, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0F);
+  const size_t size = src.size();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i v = load256(src.data() + i);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(rev_hi, lo), _mm256_shuffle_epi8(rev_lo, hi));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst.data() + i), r);
+  }
+  reverseBitsWords64(src.subspan(i), dst.subspan(i));
+}
+
+template <WordOp Op>
+[[gnu::target("avx2"), gnu::always_inline]] static inline __m256i apply256(__m256i a,
+                                                                         __m256i b) noexcept {
+  if constexpr (Op == WordOp::And) {
+    return _mm256_and_si256(a, b);
+  } else if constexpr (Op == WordOp::Or) {
+    return _mm256_or_si256(a, b);
+  } else if constexpr (Op == WordOp::Xor) {
+    return _mm256_xor_si256(a, b);
+  } else {
+    return _mm256_andnot_si256(b, a); // ~b & a
+  }
+}
+
+// 4 words per instruction, two vectors per iteration; the tail (< 8 words)
+// is done one word at a time
+template <WordOp Op>
+[[gnu::target("avx2"), gnu::always_inline]] static inline void
+applyEachAvx2(uint64_t *dst, const uint64_t *src, size_t count) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    auto *d = reinterpret_cast<__m256i *>(dst + i);
+    const auto *s = reinterpret_cast<const __m256i *>(src + i);
+    __m256i a = apply256<Op>(_mm256_loadu_si256(d), _mm256_loadu_si256(s));
+    __m256i b = apply256<Op>(_mm256_loadu_si256(d + 1), _mm256_loadu_si256(s + 1));
+    _mm256_storeu_si256(d, a);
+    _mm256_storeu_si256(d + 1, b);
+  }
+  applyEach<Op>(dst + i, src + i, count - i);
+}
+
+[[gnu::target("avx2")]] void BitKernels::applyWordsAvx2(WordOp op, std::span<uint64_t> dst,
+                                                        std::span<const uint64_t> src) noexcept {
+  switch (op) {
+  case WordOp::And:
+    applyEachAvx2<WordOp::And>(dst.data(), src.data(), dst.size());
+    break;
+  case WordOp::Or:
+    applyEachAvx2<WordOp::Or>(dst.data(), src.data(), dst.size());
+    break;
+  case WordOp::Xor:
+    applyEachAvx2<WordOp::Xor>(dst.data(), src.data(), dst.size());
+    break;
+  case WordOp::AndNot:
+    applyEachAvx2<WordOp::AndNot>(dst.data(), src.data(), dst.size());
+    break;
+  }
+}
+
+#else
+
+size_t BitKernels::countBitsWords64Popcnt(std::span<const uint8_t> bytes) noexcept {
+  return countBitsWords64(bytes);
+}
+
+size_t BitKernels::countBitsHarleySeal(std::span<const uint8_t> bytes) noexcept {
+  return countBitsWords64(bytes);
+}
+
+void BitKernels::reverseBitsPshufb(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept {
+  reverseBitsWords64(src, dst);
+}
+
+void BitKernels::applyWordsAvx2(WordOp op, std::span<uint64_t> dst,
+                                std::span<const uint64_t> src) noexcept {
+  applyWords64(op, dst, src);
+}
+
+#endif // CPU_X86
+
+// ===== DISPATCH =====
+
+using CountBitsKernel = size_t (*)(std::span<const uint8_t>) noexcept;
+
+struct CountBitsChoice {
+  CountBitsKernel kernel;
+  const char *name;
+};
+
+// Decided once; a function-local static is thread-safe to initialize
+static const CountBitsChoice &countBitsChoice() noexcept {
+  static const CountBitsChoice choice = []() noexcept -> CountBitsChoice {
+#if defined(__AVR__)
+    return {BitKernels::countBitsNibbleLut, "nibble LUT"};
+#else
+    if (CpuFeatures::hasAvx2()) {
+      return {BitKernels::countBitsHarleySeal, "Harley-Seal AVX2"};
+    }
+    if (CpuFeatures::hasPopcnt()) {
+      return {BitKernels::countBitsWords64Popcnt, "64-bit POPCNT"};
+    }
+    return {BitKernels::countBitsWords64, "64-bit std::popcount"};
+#endif
+  }();
+  return choice;
+}
+
+const char *BitKernels::countBitsKernelName() noexcept { return countBitsChoice().name; }
+
+size_t BitKernels::countBits(std::span<const uint8_t> bytes) noexcept {
+  return countBitsChoice().kernel(bytes);
+}
+
+using ReverseBitsKernel = void (*)(std::span<const uint8_t>, std::span<uint8_t>) noexcept;
+
+struct ReverseBitsChoice {
+  ReverseBitsKernel kernel;
+  const char *name;
+};
+
+static const ReverseBitsChoice &reverseBitsChoice() noexcept {
+#if defined(__AVR__)
+  static const ReverseBitsChoice choice{BitKernels::reverseBitsLut, "256-entry LUT"};
+#else
+  static const ReverseBitsChoice choice = pickKernels<ReverseBitsChoice>(
+      {BitKernels::reverseBitsPshufb, "PSHUFB nibble LUT (AVX2)"},
+      {BitKernels::reverseBitsWords64, "64-bit swaps"});
+#endif
+  return choice;
+}
+
+const char *BitKernels::reverseBitsKernelName() noexcept { return reverseBitsChoice().name; }
+
+void ByteOps::reverseBits(std::span<const uint8_t> src, std::span<uint8_t> dst) noexcept {
+  if (src.size() < 32) {
+    BitKernels::reverseBitsLut(src, dst);
+    return;
+  }
+  reverseBitsChoice().kernel(src, dst);
+}
+
+using ApplyWordsKernel = void (*)(WordOp, std::span<uint64_t>, std::span<const uint64_t>) noexcept;
+
+struct ApplyWordsChoice {
+  ApplyWordsKernel kernel;
+  const char *name;
+};
+
+static const ApplyWordsChoice &applyWordsChoice() noexcept {
+  static const ApplyWordsChoice choice = pickKernels<ApplyWordsChoice>(
+      {BitKernels::applyWordsAvx2, "AVX2 256-bit"}, {BitKernels::applyWords64, "64-bit words"});
+  return choice;
+}
+
+const char *BitKernels::applyWordsKernelName() noexcept { return applyWordsChoice().name; }
+
+void BitKernels::applyWords(WordOp op, std::span<uint64_t> dst,
+                            std::span<const uint64_t> src) noexcept {
+  if (dst.size() < 8) {
+    applyWords64(op, dst, src);
+    return;
+  }
+  applyWordsChoice().kernel(op, dst, src);
+}
+
+// ===== COMPILE-TIME CHECKS =====
+// Every fast path must give the same answer as the original constexpr loops
+
+static constexpr bool reverseBitsAgree() noexcept {
+  for (int i = 0; i < 256; i++) {
+    const uint8_t byte = static_cast<uint8_t>(i);
+    const uint8_t expected = ByteOps::reverseBits(byte);
+    if (reverseBits(byte) != expected || ByteOps::reverseBitsLut(byte) != expected ||
+        ByteOps::reverseBits16(byte) != (expected << 8) ||
+        ByteOps::reverseBits32(byte) != (static_cast<uint32_t>(expected) << 24) ||
+        ByteOps::reverseBits64(byte) != (static_cast<uint64_t>(expected) << 56)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(reverseBitsAgree(), "reverseBits variants disagree with the constexpr loop");
+static_assert(ByteOps::reverseBits32(0x12345678u) ==
+                  (static_cast<uint32_t>(ByteOps::reverseBits(0x78)) << 24 |
+                   static_cast<uint32_t>(ByteOps::reverseBits(0x56)) << 16 |
+                   static_cast<uint32_t>(ByteOps::reverseBits(0x34)) << 8 |
+                   ByteOps::reverseBits(0x12)),
+              "reverseBits32 must reverse byte order and the bits in each byte");
+static_assert(ByteOps::reverseBits64(ByteOps::reverseBits64(0x0123456789ABCDEFull)) ==
+                  0x0123456789ABCDEFull,
+              "reversing twice is the identity");
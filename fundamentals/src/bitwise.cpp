@@ -1,4 +1,6 @@
 #include "bitwise.hpp"
+#include "bit_array.hpp"
+#include "bit_kernels.hpp"
 #include <bitset>
 #include <iomanip>
 #include <iostream>
@@ -69,23 +71,23 @@ void bitwise_advanced_demo() {
   std::cout << "\n--- Setting Bits ---" << std::endl;
   printBinary("Start:        ", byte);
 
-  byte = Bitwise::setBit(byte, 3);
+  byte = Bitwise<>::setBit(byte, 3);
   printBinary("Set bit 3:    ", byte);
 
-  byte = Bitwise::setBit(byte, 7);
+  byte = Bitwise<>::setBit(byte, 7);
   printBinary("Set bit 7:    ", byte);
 
-  byte = Bitwise::setBit(byte, 0);
+  byte = Bitwise<>::setBit(byte, 0);
   printBinary("Set bit 0:    ", byte);
 
   // ===== CLEARING BITS =====
   std::cout << "\n--- Clearing Bits ---" << std::endl;
   printBinary("Current:      ", byte);
 
-  byte = Bitwise::clearBit(byte, 3);
+  byte = Bitwise<>::clearBit(byte, 3);
   printBinary("Clear bit 3:  ", byte);
 
-  byte = Bitwise::clearBit(byte, 0);
+  byte = Bitwise<>::clearBit(byte, 0);
   printBinary("Clear bit 0:  ", byte);
 
   // ===== TOGGLING BITS =====
@@ -93,28 +95,28 @@ void bitwise_advanced_demo() {
   byte = 0b10101010;
   printBinary("Start:        ", byte);
 
-  byte = Bitwise::toggleBit(byte, 0);
+  byte = Bitwise<>::toggleBit(byte, 0);
   printBinary("Toggle bit 0: ", byte);
 
-  byte = Bitwise::toggleBit(byte, 7);
+  byte = Bitwise<>::toggleBit(byte, 7);
   printBinary("Toggle bit 7: ", byte);
 
   // ===== CHECKING BITS =====
   std::cout << "\n--- Checking Bits ---" << std::endl;
   byte = 0b10001000;
   printBinary("Value:        ", byte);
-  std::cout << "Bit 3 is: " << (Bitwise::isBitSet(byte, 3) ? "SET" : "CLEAR")
+  std::cout << "Bit 3 is: " << (Bitwise<>::isBitSet(byte, 3) ? "SET" : "CLEAR")
             << std::endl;
-  std::cout << "Bit 7 is: " << (Bitwise::isBitSet(byte, 7) ? "SET" : "CLEAR")
+  std::cout << "Bit 7 is: " << (Bitwise<>::isBitSet(byte, 7) ? "SET" : "CLEAR")
             << std::endl;
-  std::cout << "Bit 0 is: " << (Bitwise::isBitSet(byte, 0) ? "SET" : "CLEAR")
+  std::cout << "Bit 0 is: " << (Bitwise<>::isBitSet(byte, 0) ? "SET" : "CLEAR")
             << std::endl;
 
   // ===== EXTRACTING BITS =====
   std::cout << "\n--- Extracting Bit Ranges ---" << std::endl;
   byte = 0b11010110;
   printBinary("Value:        ", byte);
-  uint8_t extracted = Bitwise::extractBits(byte, 2, 4);
+  uint8_t extracted = Bitwise<>::extractBits(byte, 2, 4);
   std::cout << "Bits 2-5:     " << std::bitset<4>(extracted)
             << " (decimal: " << static_cast<int>(extracted) << ")" << std::endl;
 
@@ -122,7 +124,16 @@ void bitwise_advanced_demo() {
   std::cout << "\n--- Counting Set Bits ---" << std::endl;
   byte = 0b10101101;
   printBinary("Value:        ", byte);
-  std::cout << "Number of 1s: " << static_cast<int>(Bitwise::countBits(byte))
+  std::cout << "Number of 1s: " << static_cast<int>(Bitwise<>::countBits(byte))
+            << std::endl;
+
+  // Same question for a whole buffer - 64 bits (or 512 bytes) at a time
+  uint8_t status_bitmap[1024];
+  for (size_t i = 0; i < sizeof(status_bitmap); i++) {
+    status_bitmap[i] = static_cast<uint8_t>(i * 37);
+  }
+  std::cout << "Flags set in a 1 KB bitmap: " << Bitwise<>::countBits(status_bitmap)
+            << " (kernel: " << BitKernels::countBitsKernelName() << ")"
             << std::endl;
 
   // ===== ROTATION =====
@@ -132,12 +143,52 @@ void bitwise_advanced_demo() {
   printBinary("Rotate left:  ", ShiftOps::rotateLeft(byte, 2));
   printBinary("Rotate right: ", ShiftOps::rotateRight(byte, 2));
 
+  // ===== WIDER REGISTERS =====
+  // Same operations on 16/32/64-bit values - bit 31 and up need a T-sized 1
+  std::cout << "\n--- Wider Registers: Bitwise<uint32_t>, Bitwise<uint64_t> ---" << std::endl;
+  uint32_t reg32 = Bitwise<uint32_t>::setBit(0, 31);
+  std::cout << "setBit(0, 31) as uint32_t: 0x" << std::hex << reg32 << std::dec << std::endl;
+  uint64_t reg64 = Bitwise<uint64_t>::setBit(0, 40);
+  std::cout << "Bit 40 set in uint64_t?    "
+            << (Bitwise<uint64_t>::isBitSet(reg64, 40) ? "YES" : "NO") << std::endl;
+  std::cout << "rotateLeft(0x80000001, 4): 0x" << std::hex
+            << Bitwise<uint32_t>::rotateLeft(0x80000001u, 4) << std::dec << std::endl;
+
+  // ===== BIT ARRAYS =====
+  // More flags than fit in any integer: 1000 channels, 64 per word
+  std::cout << "\n--- BitArray (1000 channels) ---" << std::endl;
+  BitArray enabled(1000);
+  BitArray faulted(1000);
+  for (size_t ch = 0; ch < 1000; ch += 3) {
+    enabled.set(ch);
+  }
+  faulted.set(300);
+  faulted.set(301);
+  faulted.set(999);
+  std::cout << "Enabled channels:          " << enabled.count() << std::endl;
+  BitArray enabled_and_faulted = enabled & faulted;
+  std::cout << "Enabled AND faulted:       " << enabled_and_faulted.count()
+            << " (first: " << enabled_and_faulted.findFirstSet() << ")" << std::endl;
+  std::cout << "First enabled after 500:   " << enabled.findFirstSet(500)
+            << " (kernel: " << BitKernels::applyWordsKernelName() << ")" << std::endl;
+
   // ===== BYTE OPERATIONS =====
   std::cout << "\n--- Byte Operations ---" << std::endl;
   byte = 0xAB;
   printBinary("Original:     ", byte);
   printBinary("Swap nibbles: ", ByteOps::swapNibbles(byte));
   printBinary("Reverse bits: ", ByteOps::reverseBits(byte));
+  printBinary("Reverse (LUT):", ByteOps::reverseBitsLut(byte));
+  std::cout << "Reverse 16-bit 0x0001: 0x" << std::hex << ByteOps::reverseBits16(0x0001)
+            << std::dec << std::endl;
+
+  // Whole frame for an LSB-first shift register, reversed in place
+  uint8_t frame[64] = {0x01, 0x80, 0xAB};
+  ByteOps::reverseBits(frame);
+  std::cout << "Frame reversed in place: 0x" << std::hex << static_cast<int>(frame[0])
+            << " 0x" << static_cast<int>(frame[1]) << " 0x" << static_cast<int>(frame[2])
+            << std::dec << " (kernel: " << BitKernels::reverseBitsKernelName() << ")"
+            << std::endl;
 
   uint16_t word = 0xABCD;
   std::cout << "\nWord: 0x" << std::hex << word << std::dec << std::endl;
@@ -190,15 +241,15 @@ void bitwise_microcontroller_demo() {
   constexpr uint8_t FLAG_BUSY = 2;
   constexpr uint8_t FLAG_COMPLETE = 3;
 
-  status = Bitwise::setBit(status, FLAG_READY);
-  status = Bitwise::setBit(status, FLAG_COMPLETE);
+  status = Bitwise<>::setBit(status, FLAG_READY);
+  status = Bitwise<>::setBit(status, FLAG_COMPLETE);
   printBinary("Status:       ", status);
-  std::cout << "  Ready? " << (Bitwise::isBitSet(status, FLAG_READY) ? "YES" : "NO")
+  std::cout << "  Ready? " << (Bitwise<>::isBitSet(status, FLAG_READY) ? "YES" : "NO")
             << std::endl;
-  std::cout << "  Error? " << (Bitwise::isBitSet(status, FLAG_ERROR) ? "YES" : "NO")
+  std::cout << "  Error? " << (Bitwise<>::isBitSet(status, FLAG_ERROR) ? "YES" : "NO")
             << std::endl;
   std::cout << "  Complete? "
-            << (Bitwise::isBitSet(status, FLAG_COMPLETE) ? "YES" : "NO")
+            << (Bitwise<>::isBitSet(status, FLAG_COMPLETE) ? "YES" : "NO")
             << std::endl;
 
   // Example 2: PWM duty cycle
@@ -226,11 +277,11 @@ void bitwise_microcontroller_demo() {
   sensors |= ((humid & 0b111) << 5); // Bits 5-7
 
   printBinary("Packed data:  ", sensors);
-  std::cout << "Temperature: " << static_cast<int>(Bitwise::extractBits(sensors, 0, 2))
+  std::cout << "Temperature: " << static_cast<int>(Bitwise<>::extractBits(sensors, 0, 2))
             << std::endl;
-  std::cout << "Light:       " << static_cast<int>(Bitwise::extractBits(sensors, 2, 3))
+  std::cout << "Light:       " << static_cast<int>(Bitwise<>::extractBits(sensors, 2, 3))
             << std::endl;
-  std::cout << "Humidity:    " << static_cast<int>(Bitwise::extractBits(sensors, 5, 3))
+  std::cout << "Humidity:    " << static_cast<int>(Bitwise<>::extractBits(sensors, 5, 3))
             << std::endl;
 
   // Example 4: Bitmask for multiple pins
@@ -239,9 +290,9 @@ void bitwise_microcontroller_demo() {
   uint8_t ledMask = 0b00111000; // Pins 3, 4, 5
 
   printBinary("Start:        ", pins);
-  pins = Bitwise::setBits(pins, ledMask);
+  pins = Bitwise<>::setBits(pins, ledMask);
   printBinary("LEDs ON:      ", pins);
-  pins = Bitwise::clearBits(pins, ledMask);
+  pins = Bitwise<>::clearBits(pins, ledMask);
   printBinary("LEDs OFF:     ", pins);
 
   std::cout << "\n=== KEY TAKEAWAYS ===" << std::endl;
@@ -0,0 +1,15 @@
+#include "cpu_features.hpp"
+
+#ifdef CPU_X86
+
+bool CpuFeatures::hasPopcnt() noexcept { return __builtin_cpu_supports("popcnt"); }
+
+bool CpuFeatures::hasAvx2() noexcept { return __builtin_cpu_supports("avx2"); }
+
+#else
+
+bool CpuFeatures::hasPopcnt() noexcept { return false; }
+
+bool CpuFeatures::hasAvx2() noexcept { return false; }
+
+#endif // CPU_X86
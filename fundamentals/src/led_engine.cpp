@@ -0,0 +1,291 @@
+#include "led_engine.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+#include <cstring>
+
+using Encoding = WS2812::Encoding;
+
+// ===== PORTABLE ENCODER =====
+
+// ThreeBit: data bit i lands in the middle of SPI group i, bit 3i + 1 of
+// a 24-bit word (MSB first). Spread the 8 bits 3 apart in three steps
+// (8 → 4+4 → 2+2+2+2 → 1 each), then OR in the fixed 1..0 of every group.
+static constexpr uint32_t THREE_BIT_FRAME = 0x924924; // 100 100 100 ...
+
+static constexpr uint32_t spreadThree(uint32_t x) {
+  x = (x | (x << 8)) & 0x00F00F;
+  x = (x | (x << 4)) & 0x0C30C3;
+  x = (x | (x << 2)) & 0x249249;
+  return THREE_BIT_FRAME | (x << 1);
+}
+
+static_assert(spreadThree(0x00) == 0x924924, "all zeros: 100 x 8");
+static_assert(spreadThree(0xFF) == 0xDB6DB6, "all ones: 110 x 8");
+static_assert(spreadThree(0x80) == 0xD24924, "MSB goes first");
+
+// FourBit: each SPI byte carries two data bits, 0 → 1000 and 1 → 1110,
+// so the 4 output bytes of a data byte come from a 256 x 4 table
+static constexpr std::array<std::array<uint8_t, 4>, 256> FOUR_BIT_TABLE = [] {
+  constexpr uint8_t PAIR[4] = {0x88, 0x8E, 0xE8, 0xEE}; // 00 01 10 11
+  std::array<std::array<uint8_t, 4>, 256> table{};
+  for (int b = 0; b < 256; b++) {
+    for (int k = 0; k < 4; k++) {
+      table[b][k] = PAIR[(b >> (6 - 2 * k)) & 3];
+    }
+  }
+  return table;
+}();
+
+void WS2812::toWireOrder(std::span<const uint32_t> pixels, std::span<uint8_t> grb) noexcept {
+  for (size_t i = 0; i < pixels.size(); i++) {
+    const uint32_t p = pixels[i];
+    grb[3 * i] = static_cast<uint8_t>(p >> 8);
+    grb[3 * i + 1] = static_cast<uint8_t>(p >> 16);
+    grb[3 * i + 2] = static_cast<uint8_t>(p);
+  }
+}
+
+void WS2812::encodeScalar(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                          Encoding encoding) noexcept {
+  uint8_t *out = spi.data();
+  if (encoding == Encoding::FourBit) {
+    for (uint8_t b : data) {
+      std::memcpy(out, FOUR_BIT_TABLE[b].data(), 4);
+      out += 4;
+    }
+    return;
+  }
+  for (uint8_t b : data) {
+    const uint32_t bits = spreadThree(b);
+    out[0] = static_cast<uint8_t>(bits >> 16);
+    out[1] = static_cast<uint8_t>(bits >> 8);
+    out[2] = static_cast<uint8_t>(bits);
+    out += 3;
+  }
+}
+
+// ===== x86 ENCODER =====
+
+#ifdef CPU_X86
+
+// FourBit: copy each of 8 data bytes into 4 output bytes, then output
+// byte k tests data bits 7-2k and 6-2k with AND + compare-equal and turns
+// each hit into the middle 11 of its 1110 group.
+[[gnu::target("avx2")]] static void encodeFourAvx2(const uint8_t *data, size_t size,
+                                                   uint8_t *out) noexcept {
+  const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, //
+                                          4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+  const __m256i high_bit = _mm256_set1_epi32(0x02082080); // 0x80 0x20 0x08 0x02
+  const __m256i low_bit = _mm256_set1_epi32(0x01041040);  // 0x40 0x10 0x04 0x01
+  const __m256i high_on = _mm256_set1_epi8(0x60);
+  const __m256i low_on = _mm256_set1_epi8(0x06);
+  const __m256i frame = _mm256_set1_epi8(static_cast<char>(0x88));
+  for (size_t i = 0; i < size; i += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + i, 8);
+    const __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi64x(static_cast<long long>(chunk)), spread);
+    const __m256i h = _mm256_cmpeq_epi8(_mm256_and_si256(v, high_bit), high_bit);
+    const __m256i l = _mm256_cmpeq_epi8(_mm256_and_si256(v, low_bit), low_bit);
+    const __m256i bits = _mm256_or_si256(
+        frame, _mm256_or_si256(_mm256_and_si256(h, high_on), _mm256_and_si256(l, low_on)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 4 * i), bits);
+  }
+}
+
+// ThreeBit: widen 8 data bytes to 32-bit lanes, spreadThree() in every
+// lane, then keep the low 3 bytes of each lane in big-endian order. The
+// 24 result bytes are squeezed to the front with a cross-lane permute and
+// written as one 32-byte store - the last 8 bytes are scratch, which is
+// why the caller keeps 8 bytes of headroom.
+[[gnu::target("avx2")]] static void encodeThreeAvx2(const uint8_t *data, size_t size,
+                                                    uint8_t *out) noexcept {
+  const __m256i m8 = _mm256_set1_epi32(0x00F00F);
+  const __m256i m4 = _mm256_set1_epi32(0x0C30C3);
+  const __m256i m2 = _mm256_set1_epi32(0x249249);
+  const __m256i frame = _mm256_set1_epi32(THREE_BIT_FRAME);
+  const __m256i big_endian = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, //
+                                              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i squeeze = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+  for (size_t i = 0; i < size; i += 8) {
+    __m256i x = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(data + i)));
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 8)), m8);
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 4)), m4);
+    x = _mm256_and_si256(_mm256_or_si256(x, _mm256_slli_epi32(x, 2)), m2);
+    x = _mm256_or_si256(frame, _mm256_slli_epi32(x, 1));
+    x = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(x, big_endian), squeeze);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 3 * i), x);
+  }
+}
+
+void WS2812::encodeAvx2(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                        Encoding encoding) noexcept {
+  size_t whole = data.size() & ~size_t{7};
+  if (encoding == Encoding::FourBit) {
+    encodeFourAvx2(data.data(), whole, spi.data());
+  } else {
+    // Room for the scratch tail of the last store
+    while (whole && 3 * whole + 8 > spi.size()) {
+      whole -= 8;
+    }
+    encodeThreeAvx2(data.data(), whole, spi.data());
+  }
+  encodeScalar(data.subspan(whole), spi.subspan(whole * spiBitsPerBit(encoding)), encoding);
+}
+
+#else
+
+void WS2812::encodeAvx2(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                        Encoding encoding) noexcept {
+  encodeScalar(data, spi, encoding);
+}
+
+#endif // CPU_X86
+
+// ===== DISPATCH =====
+
+struct WS2812KernelChoice {
+  void (*encode)(std::span<const uint8_t>, std::span<uint8_t>, Encoding) noexcept;
+  const char *name;
+};
+
+static const WS2812KernelChoice &kernelChoice() noexcept {
+  static const WS2812KernelChoice choice = pickKernels<WS2812KernelChoice>(
+      {WS2812::encodeAvx2, "AVX2"}, {WS2812::encodeScalar, "scalar"});
+  return choice;
+}
+
+const char *WS2812::kernelName() noexcept { return kernelChoice().name; }
+
+void WS2812::encode(std::span<const uint8_t> data, std::span<uint8_t> spi,
+                    Encoding encoding) noexcept {
+  kernelChoice().encode(data, spi, encoding);
+}
+
+// ===== DECODER =====
+
+bool WS2812::decode(std::span<const uint8_t> spi, std::span<uint8_t> data,
+                    Encoding encoding) noexcept {
+  const unsigned group = spiBitsPerBit(encoding);
+  const unsigned zero = encoding == Encoding::FourBit ? 0b1000 : 0b100;
+  const unsigned one = encoding == Encoding::FourBit ? 0b1110 : 0b110;
+  if (spi.size() * 8 < data.size() * 8 * group) {
+    return false;
+  }
+  size_t pos = 0; // SPI bit position, MSB of spi[0] first
+  for (uint8_t &b : data) {
+    unsigned value = 0;
+    for (int bit = 0; bit < 8; bit++) {
+      unsigned symbol = 0;
+      for (unsigned k = 0; k < group; k++, pos++) {
+        symbol = (symbol << 1) | ((spi[pos >> 3] >> (7 - (pos & 7))) & 1);
+      }
+      if (symbol != zero && symbol != one) {
+        return false;
+      }
+      value = (value << 1) | (symbol == one);
+    }
+    b = static_cast<uint8_t>(value);
+  }
+  return true;
+}
+
+// ===== EFFECTS =====
+
+uint32_t LEDEffects::mix(uint32_t a, uint32_t b, uint32_t alpha) noexcept {
+  alpha = std::min<uint32_t>(alpha, 256);
+  uint32_t out = 0;
+  for (int shift = 0; shift < 24; shift += 8) {
+    const uint32_t ca = (a >> shift) & 0xFF;
+    const uint32_t cb = (b >> shift) & 0xFF;
+    out |= ((cb * alpha + ca * (256 - alpha)) >> 8) << shift;
+  }
+  return out;
+}
+
+uint32_t LEDEffects::wheel(uint32_t hue) noexcept {
+  hue %= 768;
+  const uint32_t up = hue & 0xFF;
+  const uint32_t down = 255 - up;
+  switch (hue >> 8) {
+  case 0:
+    return (down << 16) | (up << 8); // red → green
+  case 1:
+    return (down << 8) | up; // green → blue
+  default:
+    return (up << 16) | down; // blue → red
+  }
+}
+
+void LEDEffects::chase(RGBFrame &frame, uint64_t t_us, uint32_t rgb, uint32_t pixels_per_sec,
+                       uint32_t tail) noexcept {
+  const size_t length = frame.width();
+  const size_t strips = frame.height();
+  if (length == 0) {
+    return;
+  }
+  // Positions in 1/256 pixel, so slow chases still move smoothly
+  const uint64_t lap = uint64_t{length} * 256;
+  const uint64_t head = t_us * pixels_per_sec / 1'000'000 * 256 +
+                        (t_us * pixels_per_sec % 1'000'000) * 256 / 1'000'000;
+  const uint64_t tail_length = uint64_t{tail} * 256;
+  std::span<uint32_t> pixels = frame.packed();
+  for (size_t s = 0; s < strips; s++) {
+    // d = how far pixel x is behind the head, walking down the strip
+    uint64_t d = (head + s * lap / strips) % lap;
+    uint32_t *row = pixels.data() + s * length;
+    for (size_t x = 0; x < length; x++) {
+      row[x] = d < tail_length ? mix(0, rgb, static_cast<uint32_t>(256 - d / tail)) : 0;
+      d = d >= 256 ? d - 256 : d + lap - 256;
+    }
+  }
+}
+
+void LEDEffects::fade(RGBFrame &frame, uint64_t t_us, uint32_t from, uint32_t to,
+                      uint64_t period_us) noexcept {
+  if (period_us == 0) {
+    frame.fill(from);
+    return;
+  }
+  // Triangle wave: alpha 0 → 256 → 0 over one period
+  const uint64_t phase = (t_us % period_us) * 512 / period_us;
+  const uint32_t alpha = static_cast<uint32_t>(phase <= 256 ? phase : 512 - phase);
+  frame.fill(mix(from, to, alpha));
+}
+
+void LEDEffects::rainbow(RGBFrame &frame, uint64_t t_us, uint64_t period_us) noexcept {
+  const size_t length = frame.width();
+  if (length == 0) {
+    return;
+  }
+  const uint64_t turn = period_us ? (t_us % period_us) * 768 / period_us : 0;
+  std::span<uint32_t> pixels = frame.packed();
+  for (size_t x = 0; x < length; x++) {
+    pixels[x] = wheel(static_cast<uint32_t>(x * 768 / length + turn));
+  }
+  // Every strip shows the same wheel
+  for (size_t s = 1; s < frame.height(); s++) {
+    std::copy_n(pixels.begin(), length, pixels.begin() + s * length);
+  }
+}
+
+// ===== ENGINE =====
+
+LEDEngine::LEDEngine(size_t strips, size_t pixels_per_strip, Encoding encoding)
+    : strip_count(strips), strip_pixels(pixels_per_strip), wire_encoding(encoding),
+      strip_bytes(WS2812::encodedBytes(pixels_per_strip, encoding)),
+      buffers{RGBFrame(pixels_per_strip, strips), RGBFrame(pixels_per_strip, strips)},
+      grb(3 * pixels_per_strip),
+      spi{std::vector<uint8_t>(strips * strip_bytes, 0),
+          std::vector<uint8_t>(strips * strip_bytes, 0)} {}
+
+void LEDEngine::encode() noexcept {
+  const size_t data_bytes = grb.size() * WS2812::spiBitsPerBit(wire_encoding);
+  std::span<const uint32_t> pixels = front().packed();
+  std::span<uint8_t> idle(spi[spi_front ^ 1]); // never the one DMA is sending
+  for (size_t s = 0; s < strip_count; s++) {
+    WS2812::toWireOrder(pixels.subspan(s * strip_pixels, strip_pixels), grb);
+    // Only the data part: the reset tail stays zero
+    WS2812::encode(grb, idle.subspan(s * strip_bytes, data_bytes), wire_encoding);
+  }
+  spi_front ^= 1;
+}
@@ -0,0 +1,55 @@
+#include "mapped_file.hpp"
+#include <cerrno>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define MAPPED_FILE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(MAPPED_FILE_POSIX)
+
+bool MappedFile::open(const char *path, size_t min_bytes) {
+  close();
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0 || static_cast<size_t>(st.st_size) < min_bytes) {
+    ::close(fd);
+    errno = EINVAL;
+    return false;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping keeps the file open
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  ::madvise(mapping, size, MADV_SEQUENTIAL);
+  base = static_cast<const uint8_t *>(mapping);
+  mapped_bytes = size;
+  return true;
+}
+
+void MappedFile::close() noexcept {
+  if (base) {
+    ::munmap(const_cast<uint8_t *>(base), mapped_bytes);
+  }
+  base = nullptr;
+  mapped_bytes = 0;
+}
+
+#else // !MAPPED_FILE_POSIX
+
+bool MappedFile::open(const char *, size_t) {
+  errno = ENOSYS;
+  return false;
+}
+
+void MappedFile::close() noexcept {}
+
+#endif // MAPPED_FILE_POSIX
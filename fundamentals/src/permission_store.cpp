@@ -0,0 +1,136 @@
+#include "permission_store.hpp"
+
+// ===== ONE PRINCIPAL =====
+
+void PermissionStore::set(uint32_t principal, uint8_t flags) {
+  members.add(principal);
+  for (unsigned bit = 0; bit < FLAG_BITS; bit++) {
+    if ((flags >> bit) & 1) {
+      columns[bit].add(principal);
+    } else {
+      columns[bit].remove(principal);
+    }
+  }
+}
+
+void PermissionStore::grant(uint32_t principal, uint8_t permissions) {
+  members.add(principal);
+  for (unsigned bit = 0; bit < FLAG_BITS; bit++) {
+    if ((permissions >> bit) & 1) {
+      columns[bit].add(principal);
+    }
+  }
+}
+
+void PermissionStore::revoke(uint32_t principal, uint8_t permissions) {
+  for (unsigned bit = 0; bit < FLAG_BITS; bit++) {
+    if ((permissions >> bit) & 1) {
+      columns[bit].remove(principal);
+    }
+  }
+}
+
+void PermissionStore::remove(uint32_t principal) {
+  revoke(principal, 0xFF);
+  members.remove(principal);
+}
+
+Permissions PermissionStore::get(uint32_t principal) const noexcept {
+  Permissions permissions;
+  for (unsigned bit = 0; bit < FLAG_BITS; bit++) {
+    if (columns[bit].contains(principal)) {
+      permissions.grant(static_cast<uint8_t>(1 << bit));
+    }
+  }
+  return permissions;
+}
+
+// ===== QUERIES =====
+
+size_t PermissionStore::columnsOf(uint8_t flags, const RoaringBitmap **out) const noexcept {
+  size_t n = 0;
+  for (unsigned bit = 0; bit < FLAG_BITS; bit++) {
+    if ((flags >> bit) & 1) {
+      out[n++] = &columns[bit];
+    }
+  }
+  return n;
+}
+
+// Start from the smallest required column: every AND after that can only
+// shrink it, so the later steps touch less
+size_t PermissionStore::columnsBySize(uint8_t flags, const RoaringBitmap **out) const noexcept {
+  const size_t n = columnsOf(flags, out);
+  // Insertion sort by cardinality - at most 8 entries
+  for (size_t i = 1; i < n; i++) {
+    const RoaringBitmap *column = out[i];
+    const size_t size = column->cardinality();
+    size_t j = i;
+    for (; j > 0 && out[j - 1]->cardinality() > size; j--) {
+      out[j] = out[j - 1];
+    }
+    out[j] = column;
+  }
+  return n;
+}
+
+RoaringBitmap PermissionStore::query(uint8_t all, uint8_t none) const {
+  if (all & none) {
+    return {};
+  }
+  const RoaringBitmap *required[FLAG_BITS];
+  const size_t required_count = columnsBySize(all, required);
+  RoaringBitmap result = required_count ? *required[0] : members;
+  for (size_t i = 1; i < required_count && !result.empty(); i++) {
+    result &= *required[i];
+  }
+  for (unsigned bit = 0; bit < FLAG_BITS && !result.empty(); bit++) {
+    if ((none >> bit) & 1) {
+      result -= columns[bit];
+    }
+  }
+  return result;
+}
+
+RoaringBitmap PermissionStore::queryAny(uint8_t any, uint8_t none) const {
+  RoaringBitmap result;
+  for (unsigned bit = 0; bit < FLAG_BITS; bit++) {
+    if (((any & ~none) >> bit) & 1) {
+      result |= columns[bit];
+    }
+  }
+  for (unsigned bit = 0; bit < FLAG_BITS && !result.empty(); bit++) {
+    if ((none >> bit) & 1) {
+      result -= columns[bit];
+    }
+  }
+  return result;
+}
+
+size_t PermissionStore::count(uint8_t all, uint8_t none) const noexcept {
+  if (all & none) {
+    return 0;
+  }
+  const RoaringBitmap *required[FLAG_BITS];
+  const RoaringBitmap *excluded[FLAG_BITS];
+  size_t required_count = columnsBySize(all, required);
+  if (required_count == 0) {
+    required[required_count++] = &members;
+  }
+  return RoaringBitmap::countAll({required, required_count}, {excluded, columnsOf(none, excluded)});
+}
+
+size_t PermissionStore::countAny(uint8_t any, uint8_t none) const noexcept {
+  const RoaringBitmap *wanted[FLAG_BITS];
+  const RoaringBitmap *excluded[FLAG_BITS];
+  const size_t wanted_count = columnsOf(static_cast<uint8_t>(any & ~none), wanted);
+  return RoaringBitmap::countAny({wanted, wanted_count}, {excluded, columnsOf(none, excluded)});
+}
+
+size_t PermissionStore::bytes() const noexcept {
+  size_t total = members.bytes();
+  for (const RoaringBitmap &column : columns) {
+    total += column.bytes();
+  }
+  return total;
+}
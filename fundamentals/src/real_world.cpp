@@ -1,4 +1,9 @@
 #include "real_world.hpp"
+#include "led_engine.hpp"
+#include "permission_store.hpp"
+#include "rgb_frame.hpp"
+#include "tcp_capture.hpp"
+#include "virtual_mcu.hpp"
 #include <bitset>
 #include <iostream>
 
@@ -40,6 +45,24 @@ void led_strip_demo() {
     strip.shiftLeft();
   }
 
+  // Addressable strips: 24 bits of colour per LED instead of 1 on/off bit,
+  // sent as WS2812 pulses (1 → 1110, 0 → 1000 at 4 SPI bits per bit)
+  LEDEngine engine(2, 8);
+  engine.render(0, [](RGBFrame &frame, uint64_t t_us) {
+    LEDEffects::chase(frame, t_us, 0xFF0000, 8, 3);
+  });
+  engine.encode();
+  std::cout << "\nAddressable chase, strip 0: ";
+  for (size_t x = 0; x < engine.pixelsPerStrip(); x++) {
+    std::cout << (engine.front().pixel(x, 0) ? '*' : '.');
+  }
+  std::cout << "\nFirst LED's G, R bytes on the wire: " << std::hex;
+  for (size_t i = 0; i < 8; i++) {
+    std::cout << "0x" << (int)engine.stripBits(0)[i] << " ";
+  }
+  std::cout << std::dec << "(" << engine.stripBits(0).size() << " SPI bytes per strip)"
+            << std::endl;
+
   std::cout << "\n💡 WHY USEFUL: Send 1 byte instead of 8 separate GPIO "
                "operations!"
             << std::endl;
@@ -84,6 +107,16 @@ void permissions_demo() {
   std::cout << "Revoke DELETE:             " << std::bitset<8>(user.flags)
             << std::endl;
 
+  // Many principals: one bitmap per permission instead of one byte per user
+  PermissionStore store;
+  for (uint32_t id = 0; id < 100000; id++) {
+    store.grant(id, Permissions::READ | (id % 3 == 0 ? Permissions::WRITE : 0) |
+                        (id % 1000 == 0 ? Permissions::ADMIN : 0));
+  }
+  std::cout << "\n100000 users: WRITE but not ADMIN = "
+            << store.count(Permissions::WRITE, Permissions::ADMIN) << " (store: "
+            << store.bytes() / 1024 << " KB)" << std::endl;
+
   std::cout << "\n💡 REAL USE: File systems (rwx), databases, APIs, game "
                "abilities"
             << std::endl;
@@ -123,6 +156,19 @@ void network_demo() {
   std::cout << "FIN-ACK packet:     " << std::bitset<6>(closing.flags)
             << " (closing connection)" << std::endl;
 
+  // A whole capture's worth of flags bytes, classified as one column
+  const uint8_t conversation[] = {TCPFlags::SYN, TCPFlags::SYN | TCPFlags::ACK, TCPFlags::ACK,
+                                  TCPFlags::PSH | TCPFlags::ACK, TCPFlags::ACK,
+                                  TCPFlags::FIN | TCPFlags::ACK, TCPFlags::ACK,
+                                  TCPFlags::FIN | TCPFlags::ACK, TCPFlags::ACK};
+  TCPFlagClassifier classifier;
+  classifier.addFlags(conversation);
+  std::cout << "\nOne conversation, classified (" << TCPFlagKernels::kernelName() << "):";
+  for (size_t p = 0; p < TCP_FLAG_PATTERNS.size(); p++) {
+    std::cout << " " << TCP_FLAG_PATTERNS[p].name << "=" << classifier.report().patterns[p];
+  }
+  std::cout << std::endl;
+
   std::cout << "\n💡 REAL USE: Every TCP packet you send uses this!"
             << std::endl;
 }
@@ -159,6 +205,14 @@ void color_demo() {
   std::cout << "  RGB(" << (int)color.getRed() << ", " << (int)color.getGreen()
             << ", " << (int)color.getBlue() << ")" << std::endl;
 
+  // A whole LED wall at once: same operations, 32 channels per instruction
+  RGBFrame wall(64, 32);
+  wall.fill(RGBColor(255, 100, 50).getValue());
+  wall.dim();
+  wall.gamma();
+  std::cout << "\n64x32 LED wall, dim + gamma (" << RGBKernels::kernelName()
+            << "): 0x" << std::hex << wall.pixel(0, 0) << std::dec << std::endl;
+
   std::cout << "\n💡 REAL USE: LED strips (WS2812B), displays, graphics"
             << std::endl;
 }
@@ -195,6 +249,21 @@ void sensor_packing_demo() {
             << std::endl;
   std::cout << "  Light: bits 10-15 = " << (int)packet.getLight() << std::endl;
 
+  // A whole log at once: one array per sensor in, one word per reading out
+  using Layout = SensorPacket::Layout;
+  const uint8_t temps[4] = {25, 26, 26, 27};
+  const uint8_t humids[4] = {18, 18, 19, 20};
+  const uint8_t lights[4] = {45, 40, 33, 12};
+  uint16_t packed[4];
+  Layout::packAll({temps, humids, lights}, packed);
+  std::cout << "\nBatch of 4 packed with Layout::packAll:";
+  for (uint16_t word : packed) {
+    std::cout << " 0x" << std::hex << word << std::dec;
+  }
+  std::cout << std::endl;
+  std::cout << "  (same as SensorPacket: "
+            << (packed[0] == packet.getRawData() ? "YES" : "NO") << ")" << std::endl;
+
   std::cout << "\n💡 SAVINGS: 2 bytes instead of 6 = 67% reduction!"
             << std::endl;
   std::cout << "💡 REAL USE: LoRa, BLE, RF transmissions (every byte costs "
@@ -237,6 +306,31 @@ void gpio_demo() {
             << std::endl;
   std::cout << "💡 REAL CODE: PORTB |= (1 << PB5);  // Arduino pin 13"
             << std::endl;
+
+  // Same blink, counted in cycles on a virtual ATmega328P
+  std::cout << "\nBlink pin 13 on VirtualAVR (16 MHz):" << std::endl;
+  VirtualAVR arduino;
+  arduino.pinMode(13, PinMode::OUTPUT);
+  const uint64_t setup = arduino.cycles();
+  arduino.digitalWrite(13, true);
+  arduino.digitalWrite(13, false);
+  std::cout << "  digitalWrite() x2:      " << arduino.cycles() - setup << " cycles"
+            << std::endl;
+
+  VirtualAVR direct;
+  direct.setTracing(true);
+  direct.setOutputs(AVRPort::B, 1 << 5);
+  const uint64_t direct_setup = direct.cycles();
+  direct.setHigh(AVRPort::B, 1 << 5); // SBI PORTB, 5
+  direct.toggle(AVRPort::B, 1 << 5);  // PINB = 1 << 5
+  std::cout << "  SBI + PINB toggle:      " << direct.cycles() - direct_setup << " cycles"
+            << std::endl;
+  for (const AVRTraceEntry &e : direct.trace()) {
+    std::cout << "    cycle " << e.cycle << ": "
+              << (e.reg == AVRRegister::DDR ? "DDRB  " : "PORTB ")
+              << std::bitset<8>(e.before) << " -> " << std::bitset<8>(e.after)
+              << std::endl;
+  }
 }
 
 void status_flags_demo() {
@@ -0,0 +1,373 @@
+#include "rgb_frame.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+// ===== PORTABLE KERNELS =====
+
+void RGBKernels::dimScalar(std::span<uint8_t> bytes) noexcept {
+  for (uint8_t &c : bytes) {
+    c = static_cast<uint8_t>(c >> 1);
+  }
+}
+
+void RGBKernels::brightenScalar(std::span<uint8_t> bytes) noexcept {
+  for (uint8_t &c : bytes) {
+    c = static_cast<uint8_t>(std::min(c << 1, 255));
+  }
+}
+
+void RGBKernels::scaleScalar(std::span<uint8_t> bytes, uint16_t fraction) noexcept {
+  if (fraction >= 256) {
+    return;
+  }
+  for (uint8_t &c : bytes) {
+    c = static_cast<uint8_t>((c * fraction) >> 8);
+  }
+}
+
+void RGBKernels::blendScalar(std::span<uint8_t> dst, std::span<const uint8_t> src,
+                             uint16_t alpha) noexcept {
+  alpha = std::min<uint16_t>(alpha, 256);
+  const unsigned keep = 256 - alpha;
+  for (size_t i = 0; i < dst.size(); i++) {
+    dst[i] = static_cast<uint8_t>((src[i] * alpha + dst[i] * keep) >> 8);
+  }
+}
+
+void RGBKernels::gammaScalar(std::span<uint8_t> bytes) noexcept {
+  for (uint8_t &c : bytes) {
+    c = GAMMA_TABLE[c];
+  }
+}
+
+// ===== x86 KERNELS =====
+
+#ifdef CPU_X86
+
+[[gnu::target("avx2")]] static inline __m256i load256(const uint8_t *p) noexcept {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+[[gnu::target("avx2")]] static inline void store256(uint8_t *p, __m256i v) noexcept {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+// There is no 8-bit shift: shift 16-bit lanes and clear the bit that
+// crossed over from the neighbouring byte (the 0x7F7F7F mask of RGBColor::dim)
+[[gnu::target("avx2")]] void RGBKernels::dimAvx2(std::span<uint8_t> bytes) noexcept {
+  const __m256i keep = _mm256_set1_epi8(0x7F);
+  const size_t size = bytes.size();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    store256(bytes.data() + i, _mm256_and_si256(_mm256_srli_epi16(load256(bytes.data() + i), 1), keep));
+  }
+  dimScalar(bytes.subspan(i));
+}
+
+// c + c with unsigned saturation - the clamp without branches
+[[gnu::target("avx2")]] void RGBKernels::brightenAvx2(std::span<uint8_t> bytes) noexcept {
+  const size_t size = bytes.size();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i c = load256(bytes.data() + i);
+    store256(bytes.data() + i, _mm256_adds_epu8(c, c));
+  }
+  brightenScalar(bytes.subspan(i));
+}
+
+// Widen to 16 bits (c * fraction <= 255 * 255 fits), multiply, keep the
+// high byte, pack back. unpack and pack both work per 128-bit lane, so
+// the byte order comes back unchanged.
+[[gnu::target("avx2")]] void RGBKernels::scaleAvx2(std::span<uint8_t> bytes,
+                                                   uint16_t fraction) noexcept {
+  if (fraction >= 256) {
+    return;
+  }
+  const __m256i f = _mm256_set1_epi16(static_cast<short>(fraction));
+  const __m256i zero = _mm256_setzero_si256();
+  const size_t size = bytes.size();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i c = load256(bytes.data() + i);
+    const __m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero), f), 8);
+    const __m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero), f), 8);
+    store256(bytes.data() + i, _mm256_packus_epi16(lo, hi));
+  }
+  scaleScalar(bytes.subspan(i), fraction);
+}
+
+// src*a + dst*(256-a) <= 255 * 256, so the sum fits in 16 bits
+[[gnu::target("avx2")]] void RGBKernels::blendAvx2(std::span<uint8_t> dst,
+                                                   std::span<const uint8_t> src,
+                                                   uint16_t alpha) noexcept {
+  alpha = std::min<uint16_t>(alpha, 256);
+  const __m256i a = _mm256_set1_epi16(static_cast<short>(alpha));
+  const __m256i keep = _mm256_set1_epi16(static_cast<short>(256 - alpha));
+  const __m256i zero = _mm256_setzero_si256();
+  const size_t size = dst.size();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i d = load256(dst.data() + i);
+    const __m256i s = load256(src.data() + i);
+    const __m256i lo = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), a),
+                         _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), keep)),
+        8);
+    const __m256i hi = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), a),
+                         _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), keep)),
+        8);
+    store256(dst.data() + i, _mm256_packus_epi16(lo, hi));
+  }
+  blendScalar(dst.subspan(i), src.subspan(i), alpha);
+}
+
+// 256-entry lookup as 16 PSHUFB lookups of 16 entries each. For table h,
+// index = (c - 16h) saturating-added to 0x70: in range it lands in
+// 0x70..0x7F (low nibble = entry), out of range it has bit 7 set and
+// PSHUFB returns 0, so ORing all 16 results leaves exactly one hit.
+[[gnu::target("avx2")]] void RGBKernels::gammaAvx2(std::span<uint8_t> bytes) noexcept {
+  __m256i tables[16];
+  for (int h = 0; h < 16; h++) {
+    tables[h] = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(GAMMA_TABLE.data() + 16 * h)));
+  }
+  const __m256i bias = _mm256_set1_epi8(0x70);
+  const __m256i step = _mm256_set1_epi8(16);
+  const size_t size = bytes.size();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i c = load256(bytes.data() + i);
+    __m256i out = _mm256_setzero_si256();
+    for (int h = 0; h < 16; h++) {
+      out = _mm256_or_si256(out, _mm256_shuffle_epi8(tables[h], _mm256_adds_epu8(c, bias)));
+      c = _mm256_sub_epi8(c, step);
+    }
+    store256(bytes.data() + i, out);
+  }
+  gammaScalar(bytes.subspan(i));
+}
+
+#else
+
+void RGBKernels::dimAvx2(std::span<uint8_t> bytes) noexcept { dimScalar(bytes); }
+
+void RGBKernels::brightenAvx2(std::span<uint8_t> bytes) noexcept { brightenScalar(bytes); }
+
+void RGBKernels::scaleAvx2(std::span<uint8_t> bytes, uint16_t fraction) noexcept {
+  scaleScalar(bytes, fraction);
+}
+
+void RGBKernels::blendAvx2(std::span<uint8_t> dst, std::span<const uint8_t> src,
+                           uint16_t alpha) noexcept {
+  blendScalar(dst, src, alpha);
+}
+
+void RGBKernels::gammaAvx2(std::span<uint8_t> bytes) noexcept { gammaScalar(bytes); }
+
+#endif // CPU_X86
+
+// ===== DISPATCH =====
+
+struct RGBKernelChoice {
+  void (*dim)(std::span<uint8_t>) noexcept;
+  void (*brighten)(std::span<uint8_t>) noexcept;
+  void (*scale)(std::span<uint8_t>, uint16_t) noexcept;
+  void (*blend)(std::span<uint8_t>, std::span<const uint8_t>, uint16_t) noexcept;
+  void (*gamma)(std::span<uint8_t>) noexcept;
+  const char *name;
+};
+
+static const RGBKernelChoice &kernelChoice() noexcept {
+  static const RGBKernelChoice choice = pickKernels<RGBKernelChoice>(
+      {RGBKernels::dimAvx2, RGBKernels::brightenAvx2, RGBKernels::scaleAvx2,
+       RGBKernels::blendAvx2, RGBKernels::gammaAvx2, "AVX2"},
+      {RGBKernels::dimScalar, RGBKernels::brightenScalar, RGBKernels::scaleScalar,
+       RGBKernels::blendScalar, RGBKernels::gammaScalar, "scalar"});
+  return choice;
+}
+
+const char *RGBKernels::kernelName() noexcept { return kernelChoice().name; }
+
+void RGBKernels::dim(std::span<uint8_t> bytes) noexcept { kernelChoice().dim(bytes); }
+
+void RGBKernels::brighten(std::span<uint8_t> bytes) noexcept { kernelChoice().brighten(bytes); }
+
+void RGBKernels::scale(std::span<uint8_t> bytes, uint16_t fraction) noexcept {
+  kernelChoice().scale(bytes, fraction);
+}
+
+void RGBKernels::blend(std::span<uint8_t> dst, std::span<const uint8_t> src,
+                       uint16_t alpha) noexcept {
+  kernelChoice().blend(dst, src, alpha);
+}
+
+void RGBKernels::gamma(std::span<uint8_t> bytes) noexcept { kernelChoice().gamma(bytes); }
+
+// ===== FRAME =====
+
+// Packed: 1 word per pixel. Planar: 3 bytes per pixel, rounded up to words.
+static size_t wordsFor(size_t pixels, RGBFrame::Format format) noexcept {
+  return format == RGBFrame::Format::Packed ? pixels : (3 * pixels + 3) / 4;
+}
+
+RGBFrame::RGBFrame(size_t width, size_t height, Format format)
+    : frame_width(width), frame_height(height), frame_format(format),
+      words(wordsFor(width * height, format), 0) {}
+
+std::span<uint8_t> RGBFrame::plane(Channel channel) noexcept {
+  return channelBytes().subspan(channel * pixelCount(), pixelCount());
+}
+
+std::span<const uint8_t> RGBFrame::plane(Channel channel) const noexcept {
+  return channelBytes().subspan(channel * pixelCount(), pixelCount());
+}
+
+std::span<uint8_t> RGBFrame::channelBytes() noexcept {
+  const size_t per_pixel = frame_format == Format::Packed ? 4 : 3;
+  return {reinterpret_cast<uint8_t *>(words.data()), per_pixel * pixelCount()};
+}
+
+std::span<const uint8_t> RGBFrame::channelBytes() const noexcept {
+  const size_t per_pixel = frame_format == Format::Packed ? 4 : 3;
+  return {reinterpret_cast<const uint8_t *>(words.data()), per_pixel * pixelCount()};
+}
+
+uint32_t RGBFrame::pixel(size_t x, size_t y) const noexcept {
+  const size_t i = y * frame_width + x;
+  if (frame_format == Format::Packed) {
+    return words[i];
+  }
+  return (static_cast<uint32_t>(plane(RED)[i]) << 16) |
+         (static_cast<uint32_t>(plane(GREEN)[i]) << 8) | plane(BLUE)[i];
+}
+
+void RGBFrame::setPixel(size_t x, size_t y, uint32_t rgb) noexcept {
+  const size_t i = y * frame_width + x;
+  if (frame_format == Format::Packed) {
+    words[i] = rgb & 0xFFFFFF;
+    return;
+  }
+  plane(RED)[i] = static_cast<uint8_t>(rgb >> 16);
+  plane(GREEN)[i] = static_cast<uint8_t>(rgb >> 8);
+  plane(BLUE)[i] = static_cast<uint8_t>(rgb);
+}
+
+void RGBFrame::fill(uint32_t rgb) noexcept {
+  if (frame_format == Format::Packed) {
+    std::fill(words.begin(), words.end(), rgb & 0xFFFFFF);
+    return;
+  }
+  std::ranges::fill(plane(RED), static_cast<uint8_t>(rgb >> 16));
+  std::ranges::fill(plane(GREEN), static_cast<uint8_t>(rgb >> 8));
+  std::ranges::fill(plane(BLUE), static_cast<uint8_t>(rgb));
+}
+
+RGBFrame RGBFrame::toPlanar() const {
+  if (frame_format == Format::Planar) {
+    return *this;
+  }
+  RGBFrame out(frame_width, frame_height, Format::Planar);
+  out.thread_count = thread_count;
+  uint8_t *r = out.plane(RED).data();
+  uint8_t *g = out.plane(GREEN).data();
+  uint8_t *b = out.plane(BLUE).data();
+  for (size_t i = 0; i < pixelCount(); i++) {
+    const uint32_t p = words[i];
+    r[i] = static_cast<uint8_t>(p >> 16);
+    g[i] = static_cast<uint8_t>(p >> 8);
+    b[i] = static_cast<uint8_t>(p);
+  }
+  return out;
+}
+
+RGBFrame RGBFrame::toPacked() const {
+  if (frame_format == Format::Packed) {
+    return *this;
+  }
+  RGBFrame out(frame_width, frame_height, Format::Packed);
+  out.thread_count = thread_count;
+  const uint8_t *r = plane(RED).data();
+  const uint8_t *g = plane(GREEN).data();
+  const uint8_t *b = plane(BLUE).data();
+  for (size_t i = 0; i < pixelCount(); i++) {
+    out.words[i] = (static_cast<uint32_t>(r[i]) << 16) | (static_cast<uint32_t>(g[i]) << 8) | b[i];
+  }
+  return out;
+}
+
+void RGBFrame::setThreads(unsigned threads) noexcept {
+  thread_count = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <typename Fn>
+void RGBFrame::forSlices(size_t bytes, Fn fn) const noexcept {
+  const size_t max_slices = std::max<size_t>(1, bytes / (PARALLEL_MIN_BYTES / 2));
+  const size_t slices = std::min<size_t>(thread_count, max_slices);
+  if (slices <= 1 || bytes < PARALLEL_MIN_BYTES) {
+    fn(size_t{0}, bytes);
+    return;
+  }
+  // Slices start on 64-byte boundaries so no two threads share a cache line
+  const size_t slice = ((bytes / slices) + 63) & ~size_t{63};
+  std::vector<std::thread> workers;
+  workers.reserve(slices - 1);
+  size_t begin = slice; // slice 0 runs on this thread
+  for (; begin < bytes; begin += slice) {
+    const size_t end = std::min(begin + slice, bytes);
+    try {
+      workers.emplace_back(fn, begin, end);
+    } catch (...) {
+      fn(begin, end); // couldn't start a thread: do it here
+    }
+  }
+  fn(size_t{0}, std::min(slice, bytes));
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void RGBFrame::dim() noexcept {
+  std::span<uint8_t> bytes = channelBytes();
+  forSlices(bytes.size(),
+            [bytes](size_t begin, size_t end) { RGBKernels::dim(bytes.subspan(begin, end - begin)); });
+}
+
+void RGBFrame::brighten() noexcept {
+  std::span<uint8_t> bytes = channelBytes();
+  forSlices(bytes.size(), [bytes](size_t begin, size_t end) {
+    RGBKernels::brighten(bytes.subspan(begin, end - begin));
+  });
+}
+
+void RGBFrame::scale(uint16_t fraction) noexcept {
+  std::span<uint8_t> bytes = channelBytes();
+  forSlices(bytes.size(), [bytes, fraction](size_t begin, size_t end) {
+    RGBKernels::scale(bytes.subspan(begin, end - begin), fraction);
+  });
+}
+
+void RGBFrame::gamma() noexcept {
+  std::span<uint8_t> bytes = channelBytes();
+  forSlices(bytes.size(), [bytes](size_t begin, size_t end) {
+    RGBKernels::gamma(bytes.subspan(begin, end - begin));
+  });
+}
+
+void RGBFrame::blend(const RGBFrame &src, uint16_t alpha) noexcept {
+  const bool same_shape = src.frame_width == frame_width && src.frame_height == frame_height &&
+                          src.frame_format == frame_format;
+  assert(same_shape && "blend() needs a source of the same size and format");
+  if (!same_shape) {
+    return;
+  }
+  std::span<uint8_t> dst_bytes = channelBytes();
+  std::span<const uint8_t> src_bytes = src.channelBytes();
+  forSlices(dst_bytes.size(), [dst_bytes, src_bytes, alpha](size_t begin, size_t end) {
+    RGBKernels::blend(dst_bytes.subspan(begin, end - begin), src_bytes.subspan(begin, end - begin),
+                      alpha);
+  });
+}
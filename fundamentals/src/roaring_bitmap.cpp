@@ -0,0 +1,523 @@
+#include "roaring_bitmap.hpp"
+#include "bit_kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+using WordOp = BitKernels::WordOp;
+
+// ===== CONTAINERS =====
+
+struct RoaringContainerOps {
+  using Container = RoaringBitmap::Container;
+  static constexpr size_t WORDS = RoaringBitmap::CHUNK_WORDS;
+
+  static bool testBit(const Container &c, uint16_t low) noexcept {
+    return (c.words[low / 64] >> (low % 64)) & 1;
+  }
+
+  static uint32_t countWords(const Container &c) noexcept {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(c.words.data());
+    return static_cast<uint32_t>(BitKernels::countBits({bytes, WORDS * sizeof(uint64_t)}));
+  }
+
+  static void toBitmap(Container &c) {
+    c.words.assign(WORDS, 0);
+    for (uint16_t low : c.values) {
+      c.words[low / 64] |= uint64_t{1} << (low % 64);
+    }
+    c.values.clear();
+    c.values.shrink_to_fit();
+  }
+
+  static void toArray(Container &c) {
+    c.values.clear();
+    c.values.reserve(c.count);
+    for (size_t w = 0; w < WORDS; w++) {
+      for (uint64_t word = c.words[w]; word; word &= word - 1) {
+        c.values.push_back(static_cast<uint16_t>(w * 64 + std::countr_zero(word)));
+      }
+    }
+    c.words.clear();
+    c.words.shrink_to_fit();
+  }
+
+  // Back to the smaller form after the count changed
+  static void normalize(Container &c) {
+    if (c.isBitmap() && c.count <= RoaringBitmap::ARRAY_MAX) {
+      toArray(c);
+    } else if (!c.isBitmap() && c.count > RoaringBitmap::ARRAY_MAX) {
+      toBitmap(c);
+    }
+  }
+
+  // Keep the listed values that are (or, for ANDNOT, are not) in a bitmap.
+  // Always store, advance only on a keep: no branch on the bit itself.
+  static void filterArray(std::vector<uint16_t> &values, const Container &bitmap, bool keep_set) {
+    size_t kept = 0;
+    for (uint16_t low : values) {
+      values[kept] = low;
+      kept += testBit(bitmap, low) == keep_set;
+    }
+    values.resize(kept);
+  }
+
+  static void andInPlace(Container &a, const Container &b) {
+    if (a.isBitmap() && b.isBitmap()) {
+      BitKernels::applyWords(WordOp::And, a.words, b.words);
+      a.count = countWords(a);
+    } else if (b.isBitmap()) {
+      filterArray(a.values, b, true);
+      a.count = static_cast<uint32_t>(a.values.size());
+    } else if (a.isBitmap()) {
+      // The result is a subset of b's list
+      std::vector<uint16_t> values = b.values;
+      filterArray(values, a, true);
+      a.words.clear();
+      a.words.shrink_to_fit();
+      a.values = std::move(values);
+      a.count = static_cast<uint32_t>(a.values.size());
+    } else {
+      std::vector<uint16_t> values;
+      std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                            std::back_inserter(values));
+      a.values = std::move(values);
+      a.count = static_cast<uint32_t>(a.values.size());
+    }
+    normalize(a);
+  }
+
+  static void orInPlace(Container &a, const Container &b) {
+    if (!a.isBitmap() && !b.isBitmap()) {
+      std::vector<uint16_t> values;
+      values.reserve(a.values.size() + b.values.size());
+      std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                     std::back_inserter(values));
+      a.values = std::move(values);
+      a.count = static_cast<uint32_t>(a.values.size());
+      normalize(a);
+      return;
+    }
+    if (!a.isBitmap()) {
+      // b is a bitmap: start from its bits, add a's list
+      std::vector<uint16_t> values = std::move(a.values);
+      a.values = {};
+      a.words = b.words;
+      for (uint16_t low : values) {
+        a.words[low / 64] |= uint64_t{1} << (low % 64);
+      }
+    } else if (b.isBitmap()) {
+      BitKernels::applyWords(WordOp::Or, a.words, b.words);
+    } else {
+      for (uint16_t low : b.values) {
+        a.words[low / 64] |= uint64_t{1} << (low % 64);
+      }
+    }
+    a.count = countWords(a);
+  }
+
+  static void andNotInPlace(Container &a, const Container &b) {
+    if (a.isBitmap() && b.isBitmap()) {
+      BitKernels::applyWords(WordOp::AndNot, a.words, b.words);
+      a.count = countWords(a);
+    } else if (a.isBitmap()) {
+      for (uint16_t low : b.values) {
+        a.words[low / 64] &= ~(uint64_t{1} << (low % 64));
+      }
+      a.count = countWords(a);
+    } else if (b.isBitmap()) {
+      filterArray(a.values, b, false);
+      a.count = static_cast<uint32_t>(a.values.size());
+    } else {
+      std::vector<uint16_t> values;
+      std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                          std::back_inserter(values));
+      a.values = std::move(values);
+      a.count = static_cast<uint32_t>(a.values.size());
+    }
+    normalize(a);
+  }
+
+  // ===== COUNT-ONLY =====
+  // One chunk of a result that is only counted, never stored
+
+  using Words = std::array<uint64_t, WORDS>; // 8 KB, on the stack
+
+  // Container for chunk `key`, or nullptr
+  static const Container *chunk(const RoaringBitmap &b, uint16_t key) noexcept {
+    const size_t index = b.find(key);
+    return index == b.keys.size() ? nullptr : &b.containers[index];
+  }
+
+  static size_t countWords(const Words &w) noexcept {
+    return BitKernels::countBits({reinterpret_cast<const uint8_t *>(w.data()), sizeof(w)});
+  }
+
+  // Keep the first n listed values that are (or are not) in c; returns
+  // how many are left
+  static size_t filterValues(uint16_t *values, size_t n, const Container &c,
+                             bool keep_set) noexcept {
+    size_t kept = 0;
+    if (c.isBitmap()) {
+      for (size_t i = 0; i < n; i++) {
+        values[kept] = values[i];
+        kept += testBit(c, values[i]) == keep_set;
+      }
+      return kept;
+    }
+    size_t j = 0;
+    for (size_t i = 0; i < n; i++) {
+      while (j < c.values.size() && c.values[j] < values[i]) {
+        j++;
+      }
+      const bool listed = j < c.values.size() && c.values[j] == values[i];
+      values[kept] = values[i];
+      kept += listed == keep_set;
+    }
+    return kept;
+  }
+
+  static void andWords(Words &w, const Container &c) noexcept {
+    if (c.isBitmap()) {
+      BitKernels::applyWords(WordOp::And, w, c.words);
+      return;
+    }
+    size_t v = 0;
+    for (size_t i = 0; i < WORDS; i++) {
+      uint64_t keep = 0;
+      for (; v < c.values.size() && c.values[v] / 64 == i; v++) {
+        keep |= uint64_t{1} << (c.values[v] % 64);
+      }
+      w[i] &= keep;
+    }
+  }
+
+  static void orWords(Words &w, const Container &c) noexcept {
+    if (c.isBitmap()) {
+      BitKernels::applyWords(WordOp::Or, w, c.words);
+      return;
+    }
+    for (uint16_t low : c.values) {
+      w[low / 64] |= uint64_t{1} << (low % 64);
+    }
+  }
+
+  static void andNotWords(Words &w, const Container &c) noexcept {
+    if (c.isBitmap()) {
+      BitKernels::applyWords(WordOp::AndNot, w, c.words);
+      return;
+    }
+    for (uint16_t low : c.values) {
+      w[low / 64] &= ~(uint64_t{1} << (low % 64));
+    }
+  }
+};
+
+using Ops = RoaringContainerOps;
+
+// ===== SINGLE IDS =====
+
+size_t RoaringBitmap::find(uint16_t key) const noexcept {
+  // IDs usually arrive in order: try the last chunk first
+  if (!keys.empty() && keys.back() == key) {
+    return keys.size() - 1;
+  }
+  auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  return it != keys.end() && *it == key ? static_cast<size_t>(it - keys.begin()) : keys.size();
+}
+
+void RoaringBitmap::add(uint32_t id) {
+  const uint16_t key = static_cast<uint16_t>(id >> 16);
+  const uint16_t low = static_cast<uint16_t>(id);
+  size_t index = find(key);
+  if (index == keys.size()) {
+    index = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+    keys.insert(keys.begin() + index, key);
+    containers.insert(containers.begin() + index, Container{});
+  }
+  Container &c = containers[index];
+  if (c.isBitmap()) {
+    uint64_t &word = c.words[low / 64];
+    const uint64_t bit = uint64_t{1} << (low % 64);
+    c.count += (word & bit) == 0;
+    word |= bit;
+    return;
+  }
+  auto it = c.values.empty() || c.values.back() < low
+                ? c.values.end()
+                : std::lower_bound(c.values.begin(), c.values.end(), low);
+  if (it != c.values.end() && *it == low) {
+    return;
+  }
+  c.values.insert(it, low);
+  c.count++;
+  Ops::normalize(c);
+}
+
+void RoaringBitmap::remove(uint32_t id) {
+  const size_t index = find(static_cast<uint16_t>(id >> 16));
+  if (index == keys.size()) {
+    return;
+  }
+  const uint16_t low = static_cast<uint16_t>(id);
+  Container &c = containers[index];
+  if (c.isBitmap()) {
+    uint64_t &word = c.words[low / 64];
+    const uint64_t bit = uint64_t{1} << (low % 64);
+    c.count -= (word & bit) != 0;
+    word &= ~bit;
+  } else {
+    auto it = std::lower_bound(c.values.begin(), c.values.end(), low);
+    if (it == c.values.end() || *it != low) {
+      return;
+    }
+    c.values.erase(it);
+    c.count--;
+  }
+  if (c.count == 0) {
+    keys.erase(keys.begin() + index);
+    containers.erase(containers.begin() + index);
+    return;
+  }
+  Ops::normalize(c);
+}
+
+bool RoaringBitmap::contains(uint32_t id) const noexcept {
+  const size_t index = find(static_cast<uint16_t>(id >> 16));
+  if (index == keys.size()) {
+    return false;
+  }
+  const uint16_t low = static_cast<uint16_t>(id);
+  const Container &c = containers[index];
+  return c.isBitmap() ? Ops::testBit(c, low)
+                      : std::binary_search(c.values.begin(), c.values.end(), low);
+}
+
+// ===== WHOLE SET =====
+
+size_t RoaringBitmap::cardinality() const noexcept {
+  size_t total = 0;
+  for (const Container &c : containers) {
+    total += c.count;
+  }
+  return total;
+}
+
+void RoaringBitmap::clear() noexcept {
+  keys.clear();
+  containers.clear();
+}
+
+// Chunks in both sets only; the result keeps the non-empty ones
+RoaringBitmap &RoaringBitmap::operator&=(const RoaringBitmap &other) {
+  size_t out = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    while (j < other.keys.size() && other.keys[j] < keys[i]) {
+      j++;
+    }
+    if (j == other.keys.size() || other.keys[j] != keys[i]) {
+      continue;
+    }
+    Ops::andInPlace(containers[i], other.containers[j]);
+    if (containers[i].count) {
+      if (out != i) {
+        keys[out] = keys[i];
+        containers[out] = std::move(containers[i]);
+      }
+      out++;
+    }
+  }
+  keys.resize(out);
+  containers.resize(out);
+  return *this;
+}
+
+// Merge of the two key lists; chunks only in `other` are copied
+RoaringBitmap &RoaringBitmap::operator|=(const RoaringBitmap &other) {
+  std::vector<uint16_t> merged_keys;
+  std::vector<Container> merged;
+  merged_keys.reserve(keys.size() + other.keys.size());
+  merged.reserve(keys.size() + other.keys.size());
+  size_t i = 0;
+  size_t j = 0;
+  while (i < keys.size() || j < other.keys.size()) {
+    if (j == other.keys.size() || (i < keys.size() && keys[i] < other.keys[j])) {
+      merged_keys.push_back(keys[i]);
+      merged.push_back(std::move(containers[i++]));
+    } else if (i == keys.size() || other.keys[j] < keys[i]) {
+      merged_keys.push_back(other.keys[j]);
+      merged.push_back(other.containers[j++]);
+    } else {
+      Ops::orInPlace(containers[i], other.containers[j++]);
+      merged_keys.push_back(keys[i]);
+      merged.push_back(std::move(containers[i++]));
+    }
+  }
+  keys = std::move(merged_keys);
+  containers = std::move(merged);
+  return *this;
+}
+
+RoaringBitmap &RoaringBitmap::operator-=(const RoaringBitmap &other) {
+  size_t out = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    while (j < other.keys.size() && other.keys[j] < keys[i]) {
+      j++;
+    }
+    if (j < other.keys.size() && other.keys[j] == keys[i]) {
+      Ops::andNotInPlace(containers[i], other.containers[j]);
+    }
+    if (containers[i].count) {
+      if (out != i) {
+        keys[out] = keys[i];
+        containers[out] = std::move(containers[i]);
+      }
+      out++;
+    }
+  }
+  keys.resize(out);
+  containers.resize(out);
+  return *this;
+}
+
+// ===== COUNT-ONLY =====
+
+// An array chunk of all[0] is filtered as a list of values (the result is
+// a subset of it), a bitmap chunk as words
+size_t RoaringBitmap::countAll(std::span<const RoaringBitmap *const> all,
+                               std::span<const RoaringBitmap *const> none) noexcept {
+  if (all.empty()) {
+    return 0;
+  }
+  std::array<uint16_t, ARRAY_MAX> values;
+  Ops::Words words;
+  const RoaringBitmap &base = *all[0];
+  size_t total = 0;
+  for (size_t c = 0; c < base.keys.size(); c++) {
+    const uint16_t key = base.keys[c];
+    const Container &first = base.containers[c];
+    if (!first.isBitmap()) {
+      std::copy(first.values.begin(), first.values.end(), values.begin());
+      size_t n = first.values.size();
+      for (size_t i = 1; i < all.size() && n; i++) {
+        const Container *other = Ops::chunk(*all[i], key);
+        n = other ? Ops::filterValues(values.data(), n, *other, true) : 0;
+      }
+      for (size_t i = 0; i < none.size() && n; i++) {
+        if (const Container *other = Ops::chunk(*none[i], key)) {
+          n = Ops::filterValues(values.data(), n, *other, false);
+        }
+      }
+      total += n;
+      continue;
+    }
+    bool missing = false;
+    for (size_t i = 1; i < all.size() && !missing; i++) {
+      missing = Ops::chunk(*all[i], key) == nullptr;
+    }
+    if (missing) {
+      continue;
+    }
+    std::copy(first.words.begin(), first.words.end(), words.begin());
+    for (size_t i = 1; i < all.size(); i++) {
+      Ops::andWords(words, *Ops::chunk(*all[i], key));
+    }
+    for (const RoaringBitmap *other : none) {
+      if (const Container *excluded = Ops::chunk(*other, key)) {
+        Ops::andNotWords(words, *excluded);
+      }
+    }
+    total += Ops::countWords(words);
+  }
+  return total;
+}
+
+// Chunk keys in ascending order across every set in `any`
+size_t RoaringBitmap::countAny(std::span<const RoaringBitmap *const> any,
+                               std::span<const RoaringBitmap *const> none) noexcept {
+  Ops::Words words;
+  size_t total = 0;
+  for (uint32_t next = 0;;) {
+    uint32_t key = 65536;
+    for (const RoaringBitmap *b : any) {
+      auto it = std::lower_bound(b->keys.begin(), b->keys.end(), next);
+      if (it != b->keys.end()) {
+        key = std::min<uint32_t>(key, *it);
+      }
+    }
+    if (key == 65536) {
+      return total;
+    }
+    next = key + 1;
+    words.fill(0);
+    for (const RoaringBitmap *b : any) {
+      if (const Container *c = Ops::chunk(*b, static_cast<uint16_t>(key))) {
+        Ops::orWords(words, *c);
+      }
+    }
+    for (const RoaringBitmap *b : none) {
+      if (const Container *c = Ops::chunk(*b, static_cast<uint16_t>(key))) {
+        Ops::andNotWords(words, *c);
+      }
+    }
+    total += Ops::countWords(words);
+  }
+}
+
+// ===== ITERATION =====
+
+RoaringBitmap::const_iterator::const_iterator(const RoaringBitmap *bitmap, size_t index) noexcept
+    : owner(bitmap) {
+  enter(index);
+  next();
+}
+
+void RoaringBitmap::const_iterator::enter(size_t index) noexcept {
+  container = index;
+  position = 0;
+  word = 0;
+  if (container < owner->containers.size() && owner->containers[container].isBitmap()) {
+    word = owner->containers[container].words[0];
+  }
+}
+
+void RoaringBitmap::const_iterator::next() noexcept {
+  while (container < owner->containers.size()) {
+    const Container &c = owner->containers[container];
+    const uint32_t high = uint32_t{owner->keys[container]} << 16;
+    if (!c.isBitmap()) {
+      if (position < c.values.size()) {
+        current = high | c.values[position++];
+        return;
+      }
+    } else {
+      while (word == 0 && ++position < CHUNK_WORDS) {
+        word = c.words[position];
+      }
+      if (word) {
+        current = high | static_cast<uint32_t>(position * 64 + std::countr_zero(word));
+        word &= word - 1;
+        return;
+      }
+    }
+    enter(container + 1);
+  }
+  current = 0; // == end()
+}
+
+// ===== MEMORY =====
+
+size_t RoaringBitmap::bitmapContainerCount() const noexcept {
+  return static_cast<size_t>(
+      std::count_if(containers.begin(), containers.end(), [](const Container &c) { return c.isBitmap(); }));
+}
+
+size_t RoaringBitmap::bytes() const noexcept {
+  size_t total = sizeof(*this) + keys.size() * sizeof(uint16_t) + containers.size() * sizeof(Container);
+  for (const Container &c : containers) {
+    total += c.values.size() * sizeof(uint16_t) + c.words.size() * sizeof(uint64_t);
+  }
+  return total;
+}
@@ -0,0 +1,396 @@
+#include "sensor_stream.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+// The writer needs open/write/ftruncate; elsewhere SensorLogWriter fails
+// with ENOSYS (and SensorLogReader too, through MappedFile)
+#if __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#define SENSOR_STREAM_POSIX 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using Layout = SensorCodec::Layout;
+
+// ===== PORTABLE CODEC =====
+
+void SensorCodec::decodeScalar(std::span<const uint16_t> packets,
+                               const Layout::Columns &columns) noexcept {
+  Layout::unpackAll(packets, columns);
+}
+
+void SensorCodec::encodeScalar(const Layout::ConstColumns &columns,
+                               std::span<uint16_t> packets) noexcept {
+  Layout::packAll(columns, packets);
+}
+
+// ===== x86 CODEC =====
+
+#ifdef CPU_X86
+
+// Field bits moved down to bit 0 (0x1F, 0x1F, 0x3F)
+template <size_t I>
+static constexpr uint16_t LOW_MASK = Layout::mask<I>() >> Layout::shift<I>();
+
+// 2 x 16 words → 32 bytes in order. packus works per 128-bit lane, so the
+// two middle quarters come out swapped and are put back with a permute.
+// Every value is already <= 0x3F, so the unsigned saturation never clips.
+[[gnu::target("avx2")]] static inline __m256i narrow16to8(__m256i a, __m256i b) noexcept {
+  return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+}
+
+// 32 packets per iteration: two 16-word loads, then per field a shift, a
+// mask and one 32-byte store
+[[gnu::target("avx2")]] void SensorCodec::decodeAvx2(std::span<const uint16_t> packets,
+                                                     const Layout::Columns &columns) noexcept {
+  constexpr size_t T = SensorPacket::TEMPERATURE;
+  constexpr size_t H = SensorPacket::HUMIDITY;
+  constexpr size_t L = SensorPacket::LIGHT;
+  const __m256i mask_t = _mm256_set1_epi16(LOW_MASK<T>);
+  const __m256i mask_h = _mm256_set1_epi16(LOW_MASK<H>);
+  const __m256i mask_l = _mm256_set1_epi16(LOW_MASK<L>);
+  const uint16_t *in = packets.data();
+  uint8_t *temps = columns[T].data();
+  uint8_t *humids = columns[H].data();
+  uint8_t *lights = columns[L].data();
+  const size_t count = packets.size();
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 16));
+    const __m256i t = narrow16to8(
+        _mm256_and_si256(_mm256_srli_epi16(a, Layout::shift<T>()), mask_t),
+        _mm256_and_si256(_mm256_srli_epi16(b, Layout::shift<T>()), mask_t));
+    const __m256i h = narrow16to8(
+        _mm256_and_si256(_mm256_srli_epi16(a, Layout::shift<H>()), mask_h),
+        _mm256_and_si256(_mm256_srli_epi16(b, Layout::shift<H>()), mask_h));
+    const __m256i l = narrow16to8(
+        _mm256_and_si256(_mm256_srli_epi16(a, Layout::shift<L>()), mask_l),
+        _mm256_and_si256(_mm256_srli_epi16(b, Layout::shift<L>()), mask_l));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(temps + i), t);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(humids + i), h);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lights + i), l);
+  }
+  decodeScalar(packets.subspan(i),
+               {columns[T].subspan(i), columns[H].subspan(i), columns[L].subspan(i)});
+}
+
+// 16 packets per iteration: widen 16 bytes of each field to 16-bit lanes,
+// mask, shift into place and OR together
+[[gnu::target("avx2")]] void SensorCodec::encodeAvx2(const Layout::ConstColumns &columns,
+                                                     std::span<uint16_t> packets) noexcept {
+  constexpr size_t T = SensorPacket::TEMPERATURE;
+  constexpr size_t H = SensorPacket::HUMIDITY;
+  constexpr size_t L = SensorPacket::LIGHT;
+  const __m256i mask_t = _mm256_set1_epi16(LOW_MASK<T>);
+  const __m256i mask_h = _mm256_set1_epi16(LOW_MASK<H>);
+  const __m256i mask_l = _mm256_set1_epi16(LOW_MASK<L>);
+  const uint8_t *temps = columns[T].data();
+  const uint8_t *humids = columns[H].data();
+  const uint8_t *lights = columns[L].data();
+  uint16_t *out = packets.data();
+  const size_t count = packets.size();
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i t = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(temps + i)));
+    const __m256i h = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(humids + i)));
+    const __m256i l = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(lights + i)));
+    const __m256i word = _mm256_or_si256(
+        _mm256_slli_epi16(_mm256_and_si256(t, mask_t), Layout::shift<T>()),
+        _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(h, mask_h), Layout::shift<H>()),
+                        _mm256_slli_epi16(_mm256_and_si256(l, mask_l), Layout::shift<L>())));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), word);
+  }
+  encodeScalar({columns[T].subspan(i), columns[H].subspan(i), columns[L].subspan(i)},
+               packets.subspan(i));
+}
+
+#else
+
+void SensorCodec::decodeAvx2(std::span<const uint16_t> packets,
+                             const Layout::Columns &columns) noexcept {
+  decodeScalar(packets, columns);
+}
+
+void SensorCodec::encodeAvx2(const Layout::ConstColumns &columns,
+                             std::span<uint16_t> packets) noexcept {
+  encodeScalar(columns, packets);
+}
+
+#endif // CPU_X86
+
+// ===== DISPATCH =====
+
+struct SensorCodecChoice {
+  void (*decode)(std::span<const uint16_t>, const Layout::Columns &) noexcept;
+  void (*encode)(const Layout::ConstColumns &, std::span<uint16_t>) noexcept;
+  const char *name;
+};
+
+static const SensorCodecChoice &codecChoice() noexcept {
+  static const SensorCodecChoice choice = pickKernels<SensorCodecChoice>(
+      {SensorCodec::decodeAvx2, SensorCodec::encodeAvx2, "AVX2"},
+      {SensorCodec::decodeScalar, SensorCodec::encodeScalar, "BitLayout (compiler-vectorized)"});
+  return choice;
+}
+
+const char *SensorCodec::kernelName() noexcept { return codecChoice().name; }
+
+void SensorCodec::decode(std::span<const uint16_t> packets,
+                         const Layout::Columns &columns) noexcept {
+  codecChoice().decode(packets, columns);
+}
+
+void SensorCodec::encode(const Layout::ConstColumns &columns,
+                         std::span<uint16_t> packets) noexcept {
+  codecChoice().encode(columns, packets);
+}
+
+// ===== FILE FORMAT =====
+
+static constexpr char LOG_MAGIC[8] = "SPKTLOG";
+
+SensorLogHeader SensorLog::makeHeader() noexcept {
+  SensorLogHeader header = {};
+  std::memcpy(header.magic, LOG_MAGIC, sizeof(header.magic));
+  header.version = VERSION;
+  header.header_bytes = sizeof(SensorLogHeader);
+  header.block_bytes = BLOCK_BYTES;
+  header.packets_per_block = PACKETS_PER_BLOCK;
+  header.field_widths[0] = Layout::width<SensorPacket::TEMPERATURE>();
+  header.field_widths[1] = Layout::width<SensorPacket::HUMIDITY>();
+  header.field_widths[2] = Layout::width<SensorPacket::LIGHT>();
+  return header;
+}
+
+bool SensorLog::headerValid(const SensorLogHeader &header) noexcept {
+  const SensorLogHeader expected = makeHeader();
+  return std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+         header.version == expected.version && header.header_bytes == expected.header_bytes &&
+         header.block_bytes == expected.block_bytes &&
+         header.packets_per_block == expected.packets_per_block &&
+         std::memcmp(header.field_widths, expected.field_widths, sizeof(header.field_widths)) ==
+             0;
+}
+
+#if defined(SENSOR_STREAM_POSIX)
+
+// write() may write less than asked (signals, full pipes); loop until done
+static bool writeAll(int fd, const void *data, size_t size) noexcept {
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  while (size > 0) {
+    ssize_t written = ::write(fd, p, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    p += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+// ===== WRITER =====
+
+SensorLogWriter::~SensorLogWriter() { close(); }
+
+SensorLogBlockHeader &SensorLogWriter::blockHeader() noexcept {
+  return *reinterpret_cast<SensorLogBlockHeader *>(block.data());
+}
+
+uint16_t *SensorLogWriter::blockPackets() noexcept {
+  return reinterpret_cast<uint16_t *>(block.data() + sizeof(SensorLogBlockHeader));
+}
+
+bool SensorLogWriter::open(const char *path) {
+  close();
+  fd = ::open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    fd = -1;
+    return false;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  if (size == 0) {
+    const SensorLogHeader header = SensorLog::makeHeader();
+    if (!writeAll(fd, &header, sizeof(header))) {
+      ::close(fd);
+      fd = -1;
+      return false;
+    }
+    next_sequence = 0;
+  } else {
+    SensorLogHeader header;
+    if (size < sizeof(header) || ::pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+        !SensorLog::headerValid(header)) {
+      ::close(fd);
+      fd = -1;
+      errno = EINVAL;
+      return false;
+    }
+    // Drop a half-written block from a crash; appends continue after the last whole one
+    const size_t whole_blocks = (size - sizeof(header)) / SensorLog::BLOCK_BYTES;
+    const size_t whole_bytes = sizeof(header) + whole_blocks * SensorLog::BLOCK_BYTES;
+    if (whole_bytes != size && ::ftruncate(fd, static_cast<off_t>(whole_bytes)) != 0) {
+      ::close(fd);
+      fd = -1;
+      return false;
+    }
+    next_sequence = static_cast<uint32_t>(whole_blocks);
+  }
+  block.assign(SensorLog::BLOCK_BYTES, 0);
+  failed = false;
+  return true;
+}
+
+bool SensorLogWriter::append(uint16_t packet, uint64_t now_ms) {
+  return append(std::span<const uint16_t>(&packet, 1), now_ms);
+}
+
+bool SensorLogWriter::append(std::span<const uint16_t> packets, uint64_t now_ms) {
+  if (fd < 0) {
+    errno = EBADF;
+    return false;
+  }
+  if (failed) {
+    errno = EIO;
+    return false;
+  }
+  while (!packets.empty()) {
+    SensorLogBlockHeader &header = blockHeader();
+    if (header.count == 0) {
+      header.sequence = next_sequence;
+      header.first_ms = now_ms;
+    }
+    const size_t take =
+        std::min<size_t>(packets.size(), SensorLog::PACKETS_PER_BLOCK - header.count);
+    std::memcpy(blockPackets() + header.count, packets.data(), take * sizeof(uint16_t));
+    header.count += static_cast<uint32_t>(take);
+    packets = packets.subspan(take);
+    if (header.count == SensorLog::PACKETS_PER_BLOCK && !flush()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SensorLogWriter::flush() {
+  if (fd < 0 || blockHeader().count == 0) {
+    return true;
+  }
+  if (failed) {
+    errno = EIO;
+    return false;
+  }
+  if (!writeAll(fd, block.data(), block.size())) {
+    // Cut the torn bytes off so the block can be retried where it belongs.
+    // If that fails too, any later block would land misaligned: stop here.
+    const int error = errno;
+    const size_t whole_bytes =
+        sizeof(SensorLogHeader) + size_t{next_sequence} * SensorLog::BLOCK_BYTES;
+    failed = ::ftruncate(fd, static_cast<off_t>(whole_bytes)) != 0;
+    errno = error;
+    return false;
+  }
+  next_sequence++;
+  std::fill(block.begin(), block.end(), 0);
+  return true;
+}
+
+bool SensorLogWriter::close() {
+  if (fd < 0) {
+    return true;
+  }
+  const bool flushed = flush();
+  const bool closed = ::close(fd) == 0;
+  fd = -1;
+  return flushed && closed;
+}
+
+#else // !SENSOR_STREAM_POSIX
+
+// ===== NO FILE SUPPORT =====
+
+SensorLogWriter::~SensorLogWriter() = default;
+
+bool SensorLogWriter::open(const char *) {
+  errno = ENOSYS;
+  return false;
+}
+
+bool SensorLogWriter::append(uint16_t, uint64_t) {
+  errno = EBADF;
+  return false;
+}
+
+bool SensorLogWriter::append(std::span<const uint16_t>, uint64_t) {
+  errno = EBADF;
+  return false;
+}
+
+bool SensorLogWriter::flush() { return true; }
+
+bool SensorLogWriter::close() { return true; }
+
+#endif // SENSOR_STREAM_POSIX
+
+// ===== READER =====
+
+bool SensorLogReader::open(const char *path) {
+  close();
+  if (!file.open(path, sizeof(SensorLogHeader))) {
+    return false;
+  }
+  if (!SensorLog::headerValid(*reinterpret_cast<const SensorLogHeader *>(file.data()))) {
+    close();
+    errno = EINVAL;
+    return false;
+  }
+
+  // Whole blocks only; then back off over any tail block that was never
+  // completely written (zeros from a crash, wrong sequence number)
+  blocks = (file.size() - sizeof(SensorLogHeader)) / SensorLog::BLOCK_BYTES;
+  while (blocks > 0) {
+    const auto *header = reinterpret_cast<const SensorLogBlockHeader *>(
+        file.data() + sizeof(SensorLogHeader) + (blocks - 1) * SensorLog::BLOCK_BYTES);
+    if (header->sequence == blocks - 1 && header->count > 0 &&
+        header->count <= SensorLog::PACKETS_PER_BLOCK) {
+      break;
+    }
+    blocks--;
+  }
+  return true;
+}
+
+void SensorLogReader::close() noexcept {
+  file.close();
+  blocks = 0;
+}
+
+SensorLogReader::Block SensorLogReader::block(size_t index) const noexcept {
+  const uint8_t *start = file.data() + sizeof(SensorLogHeader) + index * SensorLog::BLOCK_BYTES;
+  const auto *header = reinterpret_cast<const SensorLogBlockHeader *>(start);
+  const auto *packets =
+      reinterpret_cast<const uint16_t *>(start + sizeof(SensorLogBlockHeader));
+  // Clamp so a corrupted count can't point past the block
+  const size_t count = std::min(header->count, SensorLog::PACKETS_PER_BLOCK);
+  return {header->sequence, header->first_ms, {packets, count}};
+}
+
+uint64_t SensorLogReader::packetCount() const noexcept {
+  uint64_t count = 0;
+  forEachBlock([&](const Block &b) { count += b.packets.size(); });
+  return count;
+}
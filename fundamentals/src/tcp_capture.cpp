@@ -0,0 +1,304 @@
+#include "tcp_capture.hpp"
+#include "cpu_features.hpp"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+
+// ===== FILE FORMAT =====
+
+PcapFileHeader Pcap::makeHeader(uint32_t link_type, uint32_t snaplen, bool nanoseconds) noexcept {
+  return {nanoseconds ? MAGIC_NANO : MAGIC_MICRO, 2, 4, 0, 0, snaplen, link_type};
+}
+
+// ===== READER =====
+
+bool PcapReader::open(const char *path) {
+  close();
+  if (!file.open(path, sizeof(PcapFileHeader))) {
+    return false;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  switch (header.magic) {
+  case Pcap::MAGIC_MICRO:
+  case Pcap::MAGIC_NANO:
+    swapped = false;
+    break;
+  case Pcap::byteSwap32(Pcap::MAGIC_MICRO):
+  case Pcap::byteSwap32(Pcap::MAGIC_NANO):
+    swapped = true;
+    break;
+  default: // pcapng, or not a capture at all
+    close();
+    errno = EINVAL;
+    return false;
+  }
+  if (swapped) {
+    header.magic = Pcap::byteSwap32(header.magic);
+    header.version_major = Pcap::byteSwap16(header.version_major);
+    header.version_minor = Pcap::byteSwap16(header.version_minor);
+    header.snaplen = Pcap::byteSwap32(header.snaplen);
+    header.link_type = Pcap::byteSwap32(header.link_type);
+  }
+  nanoseconds = header.magic == Pcap::MAGIC_NANO;
+  return true;
+}
+
+void PcapReader::close() noexcept {
+  file.close();
+  header = {};
+  swapped = false;
+  nanoseconds = false;
+  truncated_tail = false;
+}
+
+// ===== HEADER WALK =====
+
+static constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+static constexpr uint16_t ETHERTYPE_IPV6 = 0x86DD;
+static constexpr uint16_t ETHERTYPE_VLAN = 0x8100;
+static constexpr uint16_t ETHERTYPE_QINQ = 0x88A8;
+static constexpr uint8_t IP_PROTO_TCP = 6;
+
+static uint16_t readBE16(const uint8_t *p) noexcept {
+  return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+// Offset of the TCP header in an IP packet, or -1
+static long tcpOffsetIPv4(std::span<const uint8_t> ip) noexcept {
+  if (ip.size() < 20) {
+    return -1;
+  }
+  const size_t header_len = (ip[0] & 0x0F) * size_t{4};
+  const bool later_fragment = ((ip[6] & 0x1F) | ip[7]) != 0; // no TCP header in it
+  if (header_len < 20 || ip[9] != IP_PROTO_TCP || later_fragment) {
+    return -1;
+  }
+  return static_cast<long>(header_len);
+}
+
+static long tcpOffsetIPv6(std::span<const uint8_t> ip) noexcept {
+  if (ip.size() < 40) {
+    return -1;
+  }
+  uint8_t next = ip[6];
+  size_t offset = 40;
+  // Skip the extension headers that can come before TCP
+  for (int hops = 0; hops < 8; hops++) {
+    switch (next) {
+    case IP_PROTO_TCP:
+      return static_cast<long>(offset);
+    case 0:  // hop-by-hop options
+    case 43: // routing
+    case 60: // destination options
+      if (ip.size() < offset + 2) {
+        return -1;
+      }
+      next = ip[offset];
+      offset += (ip[offset + 1] + size_t{1}) * 8;
+      break;
+    case 44: // fragment: only the first fragment has the TCP header
+      if (ip.size() < offset + 8 || (readBE16(&ip[offset + 2]) & 0xFFF8) != 0) {
+        return -1;
+      }
+      next = ip[offset];
+      offset += 8;
+      break;
+    default:
+      return -1;
+    }
+  }
+  return -1;
+}
+
+int TCPFlagKernels::tcpFlags(std::span<const uint8_t> frame, uint32_t link_type) noexcept {
+  size_t ip = 0;
+  uint16_t ethertype = 0;
+  switch (link_type) {
+  case Pcap::LINK_ETHERNET:
+    if (frame.size() < 14) {
+      return -1;
+    }
+    ethertype = readBE16(&frame[12]);
+    ip = 14;
+    for (int tags = 0; tags < 2 && (ethertype == ETHERTYPE_VLAN || ethertype == ETHERTYPE_QINQ);
+         tags++) {
+      if (frame.size() < ip + 4) {
+        return -1;
+      }
+      ethertype = readBE16(&frame[ip + 2]);
+      ip += 4;
+    }
+    break;
+  case Pcap::LINK_LINUX_SLL:
+    if (frame.size() < 16) {
+      return -1;
+    }
+    ethertype = readBE16(&frame[14]);
+    ip = 16;
+    break;
+  case Pcap::LINK_RAW:
+    if (frame.empty()) {
+      return -1;
+    }
+    ethertype = (frame[0] >> 4) == 6 ? ETHERTYPE_IPV6 : ETHERTYPE_IPV4;
+    break;
+  case Pcap::LINK_IPV4:
+    ethertype = ETHERTYPE_IPV4;
+    break;
+  case Pcap::LINK_IPV6:
+    ethertype = ETHERTYPE_IPV6;
+    break;
+  default:
+    return -1;
+  }
+
+  const std::span<const uint8_t> packet = frame.subspan(ip);
+  long tcp = -1;
+  if (ethertype == ETHERTYPE_IPV4 && !packet.empty() && (packet[0] >> 4) == 4) {
+    tcp = tcpOffsetIPv4(packet);
+  } else if (ethertype == ETHERTYPE_IPV6 && !packet.empty() && (packet[0] >> 4) == 6) {
+    tcp = tcpOffsetIPv6(packet);
+  }
+  // Flags are byte 13 of the TCP header
+  if (tcp < 0 || packet.size() < static_cast<size_t>(tcp) + 14) {
+    return -1;
+  }
+  return packet[static_cast<size_t>(tcp) + 13];
+}
+
+// ===== COLUMN KERNELS =====
+
+void TCPFlagKernels::histogram(std::span<const uint8_t> flags,
+                               std::array<uint64_t, 256> &bins) noexcept {
+  // Real traffic is mostly ACK and PSH-ACK: with one bin set, every
+  // increment would wait for the previous one to the same counter
+  uint32_t sets[4][256] = {};
+  const size_t size = flags.size();
+  size_t i = 0;
+  auto flush = [&] {
+    for (int b = 0; b < 256; b++) {
+      bins[b] += uint64_t{sets[0][b]} + sets[1][b] + sets[2][b] + sets[3][b];
+      sets[0][b] = sets[1][b] = sets[2][b] = sets[3][b] = 0;
+    }
+  };
+  while (i + 4 <= size) {
+    // uint32_t counters: flush before any of them could overflow
+    const size_t stop = i + std::min<size_t>((size - i) & ~size_t{3}, size_t{1} << 30);
+    for (; i < stop; i += 4) {
+      sets[0][flags[i]]++;
+      sets[1][flags[i + 1]]++;
+      sets[2][flags[i + 2]]++;
+      sets[3][flags[i + 3]]++;
+    }
+    flush();
+  }
+  for (; i < size; i++) {
+    bins[flags[i]]++;
+  }
+}
+
+size_t TCPFlagKernels::matchScalar(std::span<const uint8_t> flags, const TCPFlagPattern &pattern,
+                                   std::span<uint64_t> bits) noexcept {
+  size_t count = 0;
+  for (size_t w = 0; w * 64 < flags.size(); w++) {
+    const size_t end = std::min(flags.size(), w * 64 + 64);
+    uint64_t word = 0;
+    for (size_t i = w * 64; i < end; i++) {
+      word |= uint64_t{pattern.matches(flags[i])} << (i % 64);
+    }
+    bits[w] = word;
+    count += static_cast<size_t>(std::popcount(word));
+  }
+  return count;
+}
+
+#ifdef CPU_X86
+
+// 64 flags → one word: two 32-byte (flags & mask) == value compares, each
+// movemask gives 32 bits
+[[gnu::target("avx2,popcnt")]] size_t TCPFlagKernels::matchAvx2(std::span<const uint8_t> flags,
+                                                              const TCPFlagPattern &pattern,
+                                                              std::span<uint64_t> bits) noexcept {
+  const __m256i mask = _mm256_set1_epi8(static_cast<char>(pattern.mask));
+  const __m256i value = _mm256_set1_epi8(static_cast<char>(pattern.value));
+  const uint8_t *p = flags.data();
+  const size_t whole = flags.size() / 64;
+  size_t count = 0;
+  for (size_t w = 0; w < whole; w++, p += 64) {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+    const uint32_t lo_bits = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, mask), value)));
+    const uint32_t hi_bits = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(hi, mask), value)));
+    const uint64_t word = (uint64_t{hi_bits} << 32) | lo_bits;
+    bits[w] = word;
+    count += static_cast<size_t>(_mm_popcnt_u64(word));
+  }
+  return count + matchScalar(flags.subspan(whole * 64), pattern, bits.subspan(whole));
+}
+
+#else
+
+size_t TCPFlagKernels::matchAvx2(std::span<const uint8_t> flags, const TCPFlagPattern &pattern,
+                                 std::span<uint64_t> bits) noexcept {
+  return matchScalar(flags, pattern, bits);
+}
+
+#endif // CPU_X86
+
+// ===== DISPATCH =====
+
+struct TCPMatchChoice {
+  size_t (*match)(std::span<const uint8_t>, const TCPFlagPattern &, std::span<uint64_t>) noexcept;
+  const char *name;
+};
+
+// The AVX2 kernel counts matches with POPCNT
+static const TCPMatchChoice &matchChoice() noexcept {
+  static const TCPMatchChoice choice = pickKernels<TCPMatchChoice>(
+      {TCPFlagKernels::matchAvx2, "AVX2"}, {TCPFlagKernels::matchScalar, "scalar"},
+      /*needs_popcnt=*/true);
+  return choice;
+}
+
+const char *TCPFlagKernels::kernelName() noexcept { return matchChoice().name; }
+
+size_t TCPFlagKernels::match(std::span<const uint8_t> flags, const TCPFlagPattern &pattern,
+                             std::span<uint64_t> bits) noexcept {
+  return matchChoice().match(flags, pattern, bits);
+}
+
+// ===== CLASSIFIER =====
+
+TCPFlagClassifier::TCPFlagClassifier() : match_bits((CHUNK + 63) / 64) {
+  column.reserve(CHUNK);
+}
+
+void TCPFlagClassifier::addFlags(std::span<const uint8_t> flags) {
+  for (size_t begin = 0; begin < flags.size(); begin += CHUNK) {
+    const std::span<const uint8_t> chunk = flags.subspan(begin, std::min(CHUNK, flags.size() - begin));
+    TCPFlagKernels::histogram(chunk, totals.histogram);
+    for (size_t p = 0; p < TCP_FLAG_PATTERNS.size(); p++) {
+      totals.patterns[p] += TCPFlagKernels::match(chunk, TCP_FLAG_PATTERNS[p], match_bits);
+    }
+    totals.tcp_segments += chunk.size();
+  }
+}
+
+void TCPFlagClassifier::addCapture(const PcapReader &reader) {
+  const uint32_t link_type = reader.linkType();
+  column.clear();
+  totals.records += reader.forEachRecord([&](const PcapReader::Record &record) {
+    const int flags = TCPFlagKernels::tcpFlags(record.data, link_type);
+    if (flags >= 0) {
+      column.push_back(static_cast<uint8_t>(flags));
+      if (column.size() == CHUNK) {
+        addFlags(column);
+        column.clear();
+      }
+    }
+  });
+  addFlags(column);
+  column.clear();
+}
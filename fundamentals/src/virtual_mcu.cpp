@@ -0,0 +1,136 @@
+#include "virtual_mcu.hpp"
+
+// ===== TRANSACTIONS =====
+
+AVRTransaction &AVRTransaction::digitalWrite(uint8_t pin, bool value) {
+  const AVRPin p = VirtualAVR::arduinoPin(pin);
+  if (!p.valid()) {
+    return *this;
+  }
+  return value ? setHigh(p.port, p.mask) : setLow(p.port, p.mask);
+}
+
+AVRTransaction &AVRTransaction::pinMode(uint8_t pin, PinMode mode) {
+  const AVRPin p = VirtualAVR::arduinoPin(pin);
+  if (!p.valid()) {
+    return *this;
+  }
+  switch (mode) {
+  case PinMode::OUTPUT:
+    return setOutputs(p.port, p.mask);
+  case PinMode::INPUT_PULLUP:
+    return setInputs(p.port, p.mask).setHigh(p.port, p.mask);
+  case PinMode::INPUT:
+  default:
+    return setInputs(p.port, p.mask).setLow(p.port, p.mask);
+  }
+}
+
+// ===== ARDUINO CALLS =====
+
+bool VirtualAVR::pinMode(uint8_t pin, PinMode mode) {
+  charge(costs.pin_mode);
+  const AVRPin p = arduinoPin(pin);
+  if (!p.valid()) {
+    return false;
+  }
+  const size_t ddr = avrRegisterIndex(p.port, AVRRegister::DDR);
+  const size_t port = avrRegisterIndex(p.port, AVRRegister::PORT);
+  // Same order as the core: direction first, then the pull-up
+  if (mode == PinMode::OUTPUT) {
+    store(ddr, regs[ddr] | p.mask);
+  } else {
+    store(ddr, regs[ddr] & ~p.mask);
+    store(port, mode == PinMode::INPUT_PULLUP ? regs[port] | p.mask : regs[port] & ~p.mask);
+  }
+  return true;
+}
+
+bool VirtualAVR::digitalWrite(uint8_t pin, bool value) {
+  charge(costs.digital_write);
+  const AVRPin p = arduinoPin(pin);
+  if (!p.valid()) {
+    return false;
+  }
+  const size_t port = avrRegisterIndex(p.port, AVRRegister::PORT);
+  store(port, value ? regs[port] | p.mask : regs[port] & ~p.mask);
+  return true;
+}
+
+bool VirtualAVR::digitalRead(uint8_t pin) {
+  charge(costs.digital_read);
+  const AVRPin p = arduinoPin(pin);
+  return p.valid() && (pinRegister(p.port) & p.mask) != 0;
+}
+
+// ===== BATCHED =====
+
+// Fold every op into one value per register, work out what the compiled
+// sequence costs, then store everything at the final cycle
+void VirtualAVR::apply(const AVRTransaction &transaction) {
+  if (transaction.empty()) {
+    return;
+  }
+  using Kind = AVRTransaction::Kind;
+  std::array<uint8_t, REGISTERS> value = regs;
+  std::array<uint32_t, REGISTERS> alu_ops{};
+  unsigned touched = 0;
+  unsigned overwritten = 0; // written whole: no IN, earlier changes are dead
+  for (const AVRTransaction::Op &op : transaction.ops) {
+    const unsigned bit = 1u << op.reg;
+    touched |= bit;
+    switch (op.kind) {
+    case Kind::Write:
+      value[op.reg] = op.mask;
+      break;
+    case Kind::Set:
+      value[op.reg] |= op.mask;
+      break;
+    case Kind::Clear:
+      value[op.reg] &= ~op.mask;
+      break;
+    case Kind::Toggle:
+      value[op.reg] ^= op.mask;
+      break;
+    }
+    if (op.kind == Kind::Write) {
+      overwritten |= bit;
+      alu_ops[op.reg] = 0;
+    } else if (!(overwritten & bit)) {
+      alu_ops[op.reg]++; // after a whole write the constant folds instead
+    }
+  }
+
+  uint64_t cost = costs.atomic;
+  for (size_t r = 0; r < REGISTERS; r++) {
+    if (touched & (1u << r)) {
+      cost += costs.out;
+      if (!(overwritten & (1u << r))) {
+        cost += costs.in + costs.alu * alu_ops[r];
+      }
+    }
+  }
+  cycle_count += cost;
+  operation_count += transaction.size();
+  for (size_t r = 0; r < REGISTERS; r++) {
+    if (touched & (1u << r)) {
+      store(r, value[r]);
+    }
+  }
+}
+
+// ===== TRACE =====
+
+void VirtualAVR::record(size_t r, uint8_t value) {
+  entries.push_back({cycle_count, static_cast<AVRPort>(r / 2), static_cast<AVRRegister>(r % 2),
+                     regs[r], value});
+}
+
+void VirtualAVR::reset() noexcept {
+  regs = {};
+  driven = {};
+  levels_in = {};
+  cycle_count = 0;
+  operation_count = 0;
+  entries.clear();
+}
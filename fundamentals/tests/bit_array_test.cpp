@@ -0,0 +1,146 @@
+#include "bit_array.hpp"
+#include "tests.hpp"
+#include <vector>
+
+#if !defined(NDEBUG) && __has_include(<sys/wait.h>) && __has_include(<unistd.h>)
+#include <csignal>
+#include <cstdio>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BIT_ARRAY_TEST_FORK 1
+#endif
+
+static bool sameBits(const BitArray &bits, const std::vector<bool> &expected) {
+  if (bits.size() != expected.size()) {
+    return false;
+  }
+  size_t count = 0;
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (bits.test(i) != expected[i]) {
+      return false;
+    }
+    count += expected[i];
+  }
+  return bits.count() == count;
+}
+
+// Bit i set when (i * step) % 7 < 3: a pattern that differs per step and
+// crosses every word boundary
+static void fill(BitArray &bits, std::vector<bool> &expected, size_t step) {
+  for (size_t i = 0; i < bits.size(); i++) {
+    const bool value = (i * step) % 7 < 3;
+    bits.assign(i, value);
+    expected[i] = value;
+  }
+}
+
+// ===== SINGLE BITS =====
+
+static void singleBits() {
+  for (size_t size : {size_t{1}, size_t{63}, size_t{64}, size_t{65}, size_t{1000}}) {
+    BitArray bits(size);
+    std::vector<bool> expected(size);
+    fill(bits, expected, 3);
+    bits.toggle(0);
+    expected[0] = !expected[0];
+    bits.clear(size - 1);
+    expected[size - 1] = false;
+    CHECK(sameBits(bits, expected));
+
+    size_t found = 0;
+    bool agree = true;
+    for (size_t i = bits.findFirstSet(); i != BitArray::npos; i = bits.findFirstSet(i + 1)) {
+      agree = agree && expected[i];
+      found++;
+    }
+    CHECK(agree && found == bits.count());
+    CHECK(bits.findFirstSet(size) == BitArray::npos);
+  }
+  CHECK(BitArray().findFirstSet() == BitArray::npos && BitArray().count() == 0);
+  CHECK(BitArray(130, true).count() == 130);
+}
+
+// ===== WHOLE ARRAY =====
+
+// Several sizes so the AVX2 kernels' scalar tails and the partial last
+// word are covered
+static void operators() {
+  for (size_t size : {size_t{64}, size_t{100}, size_t{1000}, size_t{4097}}) {
+    BitArray a(size), b(size);
+    std::vector<bool> va(size), vb(size);
+    fill(a, va, 3);
+    fill(b, vb, 5);
+    std::vector<bool> v_and(size), v_or(size), v_xor(size);
+    for (size_t i = 0; i < size; i++) {
+      v_and[i] = va[i] && vb[i];
+      v_or[i] = va[i] || vb[i];
+      v_xor[i] = va[i] != vb[i];
+    }
+    CHECK(sameBits(a & b, v_and));
+    CHECK(sameBits(a | b, v_or));
+    CHECK(sameBits(a ^ b, v_xor));
+    CHECK(sameBits(a, va)); // the binary operators leave their operands alone
+
+    BitArray c = a;
+    c ^= a;
+    CHECK(c.count() == 0 && c == BitArray(size));
+  }
+}
+
+// Bits past size() stay 0 through every resize, so growing never brings
+// back dropped bits
+static void resize() {
+  BitArray bits(150, true);
+  bits.resize(300);
+  CHECK(bits.size() == 300 && bits.count() == 150 && bits.findFirstSet(150) == BitArray::npos);
+  bits.resize(70);
+  CHECK(bits.count() == 70);
+  bits.resize(200);
+  CHECK(bits.count() == 70 && bits.findFirstSet(70) == BitArray::npos);
+  bits.setAll();
+  CHECK(bits.count() == 200);
+  bits.resize(0);
+  CHECK(bits.empty() && bits.count() == 0);
+  bits.resize(65);
+  CHECK(bits.count() == 0);
+}
+
+// Different sizes assert in debug builds. Without asserts only the words
+// both arrays have are combined: bits `other` lacks count as 0, its bits
+// past this array's size are dropped, nothing is read past its end.
+static void sizeMismatch() {
+#ifdef NDEBUG
+  BitArray a(200, true);
+  a &= BitArray(70, true);
+  CHECK(a.size() == 200 && a.count() == 70);
+  BitArray b(200, true);
+  b |= BitArray(70, true);
+  CHECK(b.count() == 200);
+  BitArray c(70, true);
+  c ^= BitArray(200, true);
+  CHECK(c.size() == 70 && c.count() == 0);
+  BitArray d(70);
+  d |= BitArray(200, true);
+  CHECK(d.count() == 70); // tail bits past 70 stay 0
+#elif defined(BIT_ARRAY_TEST_FORK)
+  std::fflush(nullptr);
+  const pid_t child = fork();
+  if (child == 0) {
+    std::freopen("/dev/null", "w", stderr); // the expected assertion message
+    BitArray a(200, true);
+    a &= BitArray(70, true);
+    _exit(0);
+  }
+  int status = 0;
+  CHECK(child > 0 && waitpid(child, &status, 0) == child);
+  CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+#endif
+}
+
+void bit_array_tests() {
+  std::printf("bit_array\n");
+  singleBits();
+  operators();
+  resize();
+  sizeMismatch();
+}
@@ -0,0 +1,196 @@
+/*
+pcap Fixtures
+Writes classic pcap files of synthetic TCP conversations (handshakes,
+data, teardowns, resets) mixed with traffic the classifier must skip
+(UDP, ARP, later IP fragments, packets cut short by the snaplen), and
+keeps the TCPFlagReport the classifier should produce for them.
+Shared by tests/tcp_capture_test.cpp and bench/tcp_capture_bench.cpp.
+*/
+
+#pragma once
+
+#include "tcp_capture.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace pcap_fixtures {
+
+enum class Kind { IPv4, IPv4Vlan, IPv6, IPv6HopByHop, Udp, Arp, LaterFragment, Snapped };
+
+// splitmix64: same sequence on every platform for a given seed
+struct Rng {
+  uint64_t state;
+
+  explicit Rng(uint64_t seed) : state(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+};
+
+struct FixtureWriter {
+  FILE *file = nullptr;
+  uint32_t link_type;
+  bool swap;
+  TCPFlagReport expected;
+  uint64_t ts_us = 1'700'000'000'000'000;
+
+  FixtureWriter(const std::string &path, uint32_t link, bool opposite_order, bool nanoseconds)
+      : link_type(link), swap(opposite_order) {
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+      return;
+    }
+    PcapFileHeader header = Pcap::makeHeader(link, 65535, nanoseconds);
+    if (swap) {
+      header.magic = Pcap::byteSwap32(header.magic);
+      header.version_major = Pcap::byteSwap16(header.version_major);
+      header.version_minor = Pcap::byteSwap16(header.version_minor);
+      header.snaplen = Pcap::byteSwap32(header.snaplen);
+      header.link_type = Pcap::byteSwap32(header.link_type);
+    }
+    std::fwrite(&header, sizeof(header), 1, file);
+  }
+
+  uint32_t order(uint32_t v) const { return swap ? Pcap::byteSwap32(v) : v; }
+
+  // One record; `captured` < frame size simulates the snaplen cutting it
+  void record(const uint8_t *frame, size_t size, size_t captured, int tcp_flags) {
+    ts_us += 37;
+    const PcapRecordHeader header = {order(static_cast<uint32_t>(ts_us / 1'000'000)),
+                                     order(static_cast<uint32_t>(ts_us % 1'000'000)),
+                                     order(static_cast<uint32_t>(captured)),
+                                     order(static_cast<uint32_t>(size))};
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fwrite(frame, 1, captured, file);
+    expected.records++;
+    if (tcp_flags >= 0) {
+      expected.tcp_segments++;
+      expected.histogram[tcp_flags]++;
+      for (size_t p = 0; p < TCP_FLAG_PATTERNS.size(); p++) {
+        expected.patterns[p] += TCP_FLAG_PATTERNS[p].matches(static_cast<uint8_t>(tcp_flags));
+      }
+    }
+  }
+
+  bool close() {
+    bool ok = file && std::fclose(file) == 0;
+    file = nullptr;
+    return ok;
+  }
+};
+
+inline void put16(uint8_t *p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v >> 8);
+  p[1] = static_cast<uint8_t>(v);
+}
+
+// Builds one frame for `link_type`; returns its size. Fields nothing
+// reads (addresses, ports, sequence numbers) are left random.
+inline size_t buildFrame(uint8_t *out, uint32_t link_type, Kind kind, uint8_t flags,
+                         size_t payload, Rng &rng) {
+  for (size_t i = 0; i < 128 + payload; i += 8) {
+    const uint64_t r = rng.next();
+    std::memcpy(out + i, &r, 8);
+  }
+  const bool v6 = kind == Kind::IPv6 || kind == Kind::IPv6HopByHop;
+  size_t ip = 0;
+  if (link_type == Pcap::LINK_ETHERNET) {
+    ip = 14;
+    uint16_t ethertype = kind == Kind::Arp ? 0x0806 : v6 ? 0x86DD : 0x0800;
+    if (kind == Kind::IPv4Vlan) {
+      put16(out + 12, 0x8100);
+      put16(out + 16, ethertype);
+      ip = 18;
+    } else {
+      put16(out + 12, ethertype);
+    }
+  } else if (link_type == Pcap::LINK_LINUX_SLL) {
+    put16(out + 14, kind == Kind::Arp ? 0x0806 : v6 ? 0x86DD : 0x0800);
+    ip = 16;
+  } else if (kind == Kind::Arp) {
+    out[0] = 0x00; // raw IP has no ARP: a version nibble that is neither 4 nor 6
+  }
+  if (kind == Kind::Arp) {
+    return ip + 28;
+  }
+
+  uint8_t *p = out + ip;
+  size_t tcp;
+  if (v6) {
+    p[0] = 0x60;
+    p[6] = kind == Kind::IPv6HopByHop ? 0 : 6;
+    tcp = 40;
+    if (kind == Kind::IPv6HopByHop) {
+      p[40] = 6; // next header: TCP
+      p[41] = 0; // 8 bytes of options
+      tcp = 48;
+    }
+  } else {
+    const size_t options = (rng.next() % 4 == 0) ? 12 : 0;
+    p[0] = static_cast<uint8_t>(0x40 | ((20 + options) / 4));
+    p[6] = kind == Kind::LaterFragment ? 0x00 : 0x40; // DF, or fragment offset below
+    p[7] = kind == Kind::LaterFragment ? 0xB9 : 0x00;
+    p[9] = kind == Kind::Udp ? 17 : 6;
+    tcp = 20 + options;
+  }
+  p[tcp + 12] = 0x50; // data offset: 5 words
+  p[tcp + 13] = flags;
+  return ip + tcp + 20 + payload;
+}
+
+// `packets` records of conversations and noise, in the order real traffic
+// would show them
+inline void writeTraffic(FixtureWriter &w, size_t packets, uint64_t seed) {
+  Rng rng(seed);
+  uint8_t frame[512];
+  size_t written = 0;
+  auto emit = [&](Kind kind, uint8_t flags, size_t payload) {
+    if (written++ >= packets) {
+      return;
+    }
+    const size_t size = buildFrame(frame, w.link_type, kind, flags, payload, rng);
+    const bool tcp = kind != Kind::Udp && kind != Kind::Arp && kind != Kind::LaterFragment;
+    const size_t captured = kind == Kind::Snapped ? size - 20 - payload + 6 : size;
+    w.record(frame, size, captured, tcp && kind != Kind::Snapped ? flags : -1);
+  };
+  constexpr uint8_t FIN = TCPFlags::FIN, SYN = TCPFlags::SYN, RST = TCPFlags::RST,
+                    PSH = TCPFlags::PSH, ACK = TCPFlags::ACK;
+  while (written < packets) {
+    const uint64_t r = rng.next();
+    const Kind kinds[] = {Kind::IPv4, Kind::IPv4, Kind::IPv4Vlan, Kind::IPv6, Kind::IPv6HopByHop};
+    const Kind kind = kinds[r % 5];
+    // Noise between conversations
+    if ((r >> 8) % 8 == 0) {
+      const Kind noise[] = {Kind::Udp, Kind::Arp, Kind::LaterFragment, Kind::Snapped};
+      emit(noise[(r >> 12) % 4], PSH | ACK, (r >> 16) % 64);
+      continue;
+    }
+    if ((r >> 8) % 97 == 1) {
+      emit(kind, FIN, 0); // FIN scan probe
+      continue;
+    }
+    // Handshake, data, then a teardown or a reset
+    emit(kind, SYN, 0);
+    emit(kind, SYN | ACK, 0);
+    emit(kind, ACK, 0);
+    const size_t segments = (r >> 20) % 16;
+    for (size_t s = 0; s < segments; s++) {
+      emit(kind, (r >> (24 + s)) & 1 ? (PSH | ACK) : ACK, (r >> (32 + s)) % 96);
+    }
+    if ((r >> 40) % 20 == 0) {
+      emit(kind, RST | ACK, 0);
+    } else {
+      emit(kind, FIN | ACK, 0);
+      emit(kind, ACK, 0);
+      emit(kind, FIN | ACK, 0);
+      emit(kind, ACK, 0);
+    }
+  }
+}
+
+} // namespace pcap_fixtures
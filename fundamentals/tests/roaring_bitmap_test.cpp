@@ -0,0 +1,188 @@
+#include "permission_store.hpp"
+#include "roaring_bitmap.hpp"
+#include "tests.hpp"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+using Ids = std::vector<uint32_t>; // sorted, unique - the reference model
+
+static RoaringBitmap fromIds(const Ids &ids) {
+  RoaringBitmap bitmap;
+  for (uint32_t id : ids) {
+    bitmap.add(id);
+  }
+  return bitmap;
+}
+
+static Ids toIds(const RoaringBitmap &bitmap) {
+  return Ids(bitmap.begin(), bitmap.end());
+}
+
+// Chunks of a sorted ID list that hold more than ARRAY_MAX IDs - the ones
+// a canonical RoaringBitmap keeps as bitmaps
+static size_t denseChunks(const Ids &ids) {
+  size_t dense = 0;
+  for (size_t i = 0; i < ids.size();) {
+    const uint32_t key = ids[i] >> 16;
+    size_t j = i;
+    while (j < ids.size() && ids[j] >> 16 == key) {
+      j++;
+    }
+    dense += j - i > RoaringBitmap::ARRAY_MAX;
+    i = j;
+  }
+  return dense;
+}
+
+// Same IDs, canonical containers, and forEach agrees with the iterator
+static bool matches(const RoaringBitmap &bitmap, const Ids &ids) {
+  Ids visited;
+  bitmap.forEach([&](uint32_t id) { visited.push_back(id); });
+  return toIds(bitmap) == ids && visited == ids && bitmap.cardinality() == ids.size() &&
+         bitmap.bitmapContainerCount() == denseChunks(ids);
+}
+
+// Every `step`-th ID of chunk `key`, from `first`
+static void addRange(Ids &ids, uint32_t key, uint32_t first, uint32_t step, uint32_t count) {
+  for (uint32_t i = 0; i < count && first + i * step < 65536; i++) {
+    ids.push_back((key << 16) | (first + i * step));
+  }
+}
+
+static Ids sorted(Ids ids) {
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+// ===== CONTAINER FORMS =====
+
+// One chunk crossing ARRAY_MAX both ways, one add or remove at a time
+static void transitions() {
+  RoaringBitmap bitmap;
+  Ids ids;
+  addRange(ids, 7, 0, 3, RoaringBitmap::ARRAY_MAX);
+  for (uint32_t id : ids) {
+    bitmap.add(id);
+  }
+  CHECK(bitmap.bitmapContainerCount() == 0 && matches(bitmap, ids));
+
+  bitmap.add((7u << 16) | 1);
+  ids.insert(ids.begin() + 1, (7u << 16) | 1);
+  CHECK(bitmap.bitmapContainerCount() == 1 && matches(bitmap, ids));
+  bitmap.add((7u << 16) | 1); // already there: no change
+  CHECK(bitmap.cardinality() == ids.size());
+
+  bitmap.remove(ids.back());
+  ids.pop_back();
+  CHECK(bitmap.bitmapContainerCount() == 0 && matches(bitmap, ids));
+
+  // Built in a different order, the same set is the same containers
+  RoaringBitmap reversed;
+  for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+    reversed.add(*it);
+  }
+  CHECK(reversed == bitmap);
+
+  // Emptying a chunk drops its container
+  RoaringBitmap single;
+  single.add(0x12345678);
+  single.remove(0x12345678);
+  single.remove(0x12345678);
+  CHECK(single.empty() && single.containerCount() == 0 && single == RoaringBitmap());
+}
+
+// ===== SET OPERATIONS =====
+
+// Every pairing of container kinds, and results that change kind:
+//   chunk 0  bitmap & array      chunk 1  array & bitmap
+//   chunk 2  bitmap & bitmap whose AND is small enough for an array
+//   chunk 3  array & array       chunk 4 / 5  only in a / only in b
+static void operations() {
+  Ids a, b;
+  addRange(a, 0, 0, 1, 20000);
+  addRange(b, 0, 5, 7, 3000);
+  addRange(a, 1, 1, 11, 2000);
+  addRange(b, 1, 0, 2, 30000);
+  addRange(a, 2, 0, 2, 30000);
+  addRange(b, 2, 1, 2, 30000);
+  addRange(b, 2, 0, 60, 500);
+  addRange(a, 3, 0, 5, 1000);
+  addRange(b, 3, 0, 3, 1000);
+  addRange(a, 4, 0, 1, 10000);
+  addRange(b, 5, 9, 1, 100);
+  a = sorted(a);
+  b = sorted(b);
+  const RoaringBitmap ra = fromIds(a);
+  const RoaringBitmap rb = fromIds(b);
+  CHECK(matches(ra, a) && matches(rb, b));
+
+  Ids expected;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  CHECK(matches(ra & rb, expected));
+  CHECK(matches(rb & ra, expected));
+  CHECK(RoaringBitmap::countAll(std::vector{&ra, &rb}) == expected.size());
+  CHECK(RoaringBitmap::countAll(std::vector{&rb, &ra}) == expected.size());
+
+  expected.clear();
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  CHECK(matches(ra | rb, expected));
+  CHECK(RoaringBitmap::countAny(std::vector{&ra, &rb}) == expected.size());
+
+  expected.clear();
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+  CHECK(matches(ra - rb, expected));
+  CHECK(RoaringBitmap::countAll(std::vector{&ra}, std::vector{&rb}) == expected.size());
+  CHECK(RoaringBitmap::countAny(std::vector{&ra}, std::vector{&rb}) == expected.size());
+
+  expected.clear();
+  std::set_difference(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(expected));
+  CHECK(matches(rb - ra, expected));
+
+  CHECK((ra - ra).empty() && (ra & RoaringBitmap()).empty() && (ra | RoaringBitmap()) == ra);
+  CHECK(RoaringBitmap::countAll({}) == 0 && RoaringBitmap::countAny({}) == 0);
+}
+
+// ===== PERMISSION STORE =====
+
+// count() and countAny() must match the size of the bitmap query() and
+// queryAny() build, for every required set and a spread of excluded ones
+static void permissionCounts() {
+  PermissionStore store;
+  std::vector<uint8_t> flags(300000);
+  for (size_t id = 0; id < flags.size(); id++) {
+    // Dense and sparse columns, so both container kinds show up
+    const uint32_t h = static_cast<uint32_t>(id * 2654435761u) >> 8;
+    flags[id] = static_cast<uint8_t>((h % 4 != 0) | ((h % 3 == 0) << 1) | ((h % 97 == 0) << 2) |
+                                     ((h % 5 < 2) << 3) | ((id % 4096 < 9) << 4));
+    store.set(static_cast<uint32_t>(id * 3), flags[id]);
+  }
+  store.remove(3);
+  flags[1] = 0;
+
+  size_t wrong = 0;
+  for (unsigned all = 0; all < 32; all++) {
+    for (unsigned none : {0u, 1u, 4u, 10u, 16u, 31u}) {
+      const uint8_t a = static_cast<uint8_t>(all), n = static_cast<uint8_t>(none);
+      wrong += store.count(a, n) != store.query(a, n).cardinality();
+      wrong += store.countAny(a, n) != store.queryAny(a, n).cardinality();
+    }
+  }
+  CHECK(wrong == 0);
+
+  size_t write_not_admin = 0;
+  for (size_t id = 0; id < flags.size(); id++) {
+    write_not_admin += id != 1 && (flags[id] & 0x2) && !(flags[id] & 0x10);
+  }
+  CHECK(store.count(0x2, 0x10) == write_not_admin);
+  CHECK(store.count(0) == flags.size() - 1);
+  CHECK(store.count(0x3, 0x1) == 0);
+}
+
+void roaring_bitmap_tests() {
+  std::printf("roaring_bitmap\n");
+  transitions();
+  operations();
+  permissionCounts();
+}
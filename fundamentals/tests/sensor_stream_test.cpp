@@ -0,0 +1,170 @@
+#include "sensor_stream.hpp"
+#include "tests.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#if __has_include(<sys/resource.h>) && __has_include(<signal.h>)
+#include <signal.h>
+#include <sys/resource.h>
+#define SENSOR_STREAM_TEST_RLIMIT 1
+#endif
+
+using Layout = SensorCodec::Layout;
+
+static std::string tempPath(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Every 16-bit word is a valid packet (5 + 5 + 6 bits), so any sequence
+// round-trips; the multiplier spreads consecutive values over all fields
+static std::vector<uint16_t> packetSequence(size_t count) {
+  std::vector<uint16_t> packets(count);
+  for (size_t i = 0; i < count; i++) {
+    packets[i] = static_cast<uint16_t>(i * 40503u + 7);
+  }
+  return packets;
+}
+
+// ===== CODEC =====
+
+// Not a multiple of 32, so the kernels' scalar tails run too
+static void codec() {
+  const std::vector<uint16_t> packets = packetSequence(1000);
+  std::vector<uint8_t> temps(packets.size()), humids(packets.size()), lights(packets.size());
+  SensorCodec::decode(packets, {temps, humids, lights});
+  size_t wrong = 0;
+  for (size_t i = 0; i < packets.size(); i++) {
+    const SensorPacket packet = SensorPacket::fromRaw(packets[i]);
+    wrong += temps[i] != packet.getTemperature() || humids[i] != packet.getHumidity() ||
+             lights[i] != packet.getLight();
+  }
+  CHECK(wrong == 0);
+
+  std::vector<uint8_t> t2(packets.size()), h2(packets.size()), l2(packets.size());
+  SensorCodec::decodeScalar(packets, {t2, h2, l2});
+  CHECK(t2 == temps && h2 == humids && l2 == lights);
+
+  std::vector<uint16_t> encoded(packets.size());
+  SensorCodec::encode(Layout::ConstColumns{temps, humids, lights}, encoded);
+  CHECK(encoded == packets);
+  std::fill(encoded.begin(), encoded.end(), 0);
+  SensorCodec::encodeScalar(Layout::ConstColumns{temps, humids, lights}, encoded);
+  CHECK(encoded == packets);
+}
+
+// ===== LOG FILE =====
+
+// Reopen-and-append, then half a block of garbage from a crash
+static void recovery() {
+  const std::string path = tempPath("sensor_stream_recovery.spk");
+  std::remove(path.c_str());
+  const std::vector<uint16_t> packets = packetSequence(10000);
+  SensorLogWriter writer;
+  CHECK(writer.open(path.c_str()) && writer.append(packets, 100) && writer.close());
+
+  // Reopen: continue with a new block after the partial one flush() wrote
+  CHECK(writer.open(path.c_str()) && writer.blocksWritten() == 3);
+  CHECK(writer.append(packets[0], 200) && writer.close());
+
+  FILE *file = std::fopen(path.c_str(), "ab");
+  const std::vector<uint8_t> junk(SensorLog::BLOCK_BYTES / 2, 0xAB);
+  CHECK(file && std::fwrite(junk.data(), 1, junk.size(), file) == junk.size());
+  if (file) {
+    std::fclose(file);
+  }
+
+  SensorLogReader reader;
+  if (CHECK(reader.open(path.c_str()))) {
+    CHECK(reader.blockCount() == 4);
+    CHECK(reader.packetCount() == packets.size() + 1);
+    CHECK(reader.block(0).first_ms == 100);
+    CHECK(std::ranges::equal(reader.block(0).packets,
+                             std::span(packets).first(SensorLog::PACKETS_PER_BLOCK)));
+    CHECK(reader.block(3).sequence == 3 && reader.block(3).first_ms == 200);
+    reader.close();
+  }
+
+  // The next writer cuts the torn half block off and keeps appending
+  CHECK(writer.open(path.c_str()) && writer.blocksWritten() == 4);
+  CHECK(std::filesystem::file_size(path) == sizeof(SensorLogHeader) + 4 * SensorLog::BLOCK_BYTES);
+  CHECK(writer.append(packets[1], 300) && writer.close());
+  if (CHECK(reader.open(path.c_str()))) {
+    CHECK(reader.blockCount() == 5);
+    CHECK(reader.block(4).packets.size() == 1 && reader.block(4).packets[0] == packets[1]);
+    reader.close();
+  }
+  std::remove(path.c_str());
+
+  // Not a log file at all
+  file = std::fopen(path.c_str(), "wb");
+  const std::vector<char> text(200, 'x');
+  CHECK(file && std::fwrite(text.data(), 1, text.size(), file) == text.size());
+  if (file) {
+    std::fclose(file);
+  }
+  CHECK(!writer.open(path.c_str()) && errno == EINVAL);
+  CHECK(!reader.open(path.c_str()));
+  std::remove(path.c_str());
+}
+
+// A write that fails halfway (the file size limit, standing in for a full
+// disk) is cut back off the file; once there is room, flush() retries the
+// same block in place and every later block stays aligned
+static void flushFailure() {
+#ifdef SENSOR_STREAM_TEST_RLIMIT
+  const std::string path = tempPath("sensor_stream_flush.spk");
+  std::remove(path.c_str());
+  const std::vector<uint16_t> packets = packetSequence(2 * SensorLog::PACKETS_PER_BLOCK + 500);
+  const size_t two_blocks = sizeof(SensorLogHeader) + 2 * SensorLog::BLOCK_BYTES;
+  SensorLogWriter writer;
+  if (!CHECK(writer.open(path.c_str()))) {
+    return;
+  }
+  CHECK(writer.append(packets, 1) && writer.blocksWritten() == 2);
+
+  rlimit saved;
+  getrlimit(RLIMIT_FSIZE, &saved);
+  rlimit limited = saved;
+  limited.rlim_cur = two_blocks + 100; // room for 100 bytes of the third block
+  void (*saved_handler)(int) = signal(SIGXFSZ, SIG_IGN);
+  setrlimit(RLIMIT_FSIZE, &limited);
+  const bool flushed = writer.flush();
+  const int error = errno;
+  setrlimit(RLIMIT_FSIZE, &saved);
+  signal(SIGXFSZ, saved_handler);
+
+  CHECK(!flushed && error == EFBIG);
+  CHECK(!writer.hasFailed());
+  CHECK(std::filesystem::file_size(path) == two_blocks);
+  CHECK(writer.flush() && writer.blocksWritten() == 3);
+  CHECK(writer.append(packets[0], 2) && writer.close());
+
+  SensorLogReader reader;
+  if (CHECK(reader.open(path.c_str()))) {
+    CHECK(reader.blockCount() == 4);
+    CHECK(reader.packetCount() == packets.size() + 1);
+    CHECK(reader.block(2).sequence == 2 && reader.block(2).packets.size() == 500);
+    CHECK(reader.block(3).sequence == 3 && reader.block(3).first_ms == 2);
+    reader.close();
+  }
+  std::remove(path.c_str());
+#else
+  std::printf("  no RLIMIT_FSIZE on this platform: flush failure test skipped\n");
+#endif
+}
+
+void sensor_stream_tests() {
+  std::printf("sensor_stream (codec kernel: %s)\n", SensorCodec::kernelName());
+  codec();
+  SensorLogReader probe;
+  if (!probe.open(tempPath("sensor_stream_missing.spk").c_str()) && errno == ENOSYS) {
+    std::printf("  no mmap on this platform: log file tests skipped\n");
+    return;
+  }
+  recovery();
+  flushFailure();
+}
@@ -0,0 +1,193 @@
+#include "pcap_fixtures.hpp"
+#include "tests.hpp"
+#include <cerrno>
+#include <filesystem>
+#include <vector>
+
+using namespace pcap_fixtures;
+
+static std::string tempPath(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// ===== FILE FORMATS =====
+// Every link type and byte order the reader supports, then the same file
+// cut off in the middle of its last record
+
+static void formats() {
+  struct Format {
+    const char *name;
+    uint32_t link_type;
+    bool swap;
+    bool nanoseconds;
+  };
+  const Format formats[] = {
+      {"ethernet, native, us", Pcap::LINK_ETHERNET, false, false},
+      {"raw IP, swapped, ns", Pcap::LINK_RAW, true, true},
+      {"linux any, swapped, us", Pcap::LINK_LINUX_SLL, true, false},
+  };
+  const std::string path = tempPath("tcp_capture_fixture.pcap");
+  for (const Format &f : formats) {
+    std::printf("  %s\n", f.name);
+    FixtureWriter writer(path, f.link_type, f.swap, f.nanoseconds);
+    writeTraffic(writer, 20000, f.link_type);
+    CHECK(writer.close());
+
+    PcapReader reader;
+    TCPFlagClassifier classifier;
+    if (!CHECK(reader.open(path.c_str()))) {
+      continue;
+    }
+    CHECK(reader.byteSwapped() == f.swap);
+    CHECK(reader.nanosecondTimestamps() == f.nanoseconds);
+    CHECK(reader.linkType() == f.link_type);
+    classifier.addCapture(reader);
+    CHECK(classifier.report() == writer.expected);
+    CHECK(!reader.truncated());
+    reader.close();
+
+    // The torn record is dropped, everything before it still counts
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    classifier.reset();
+    if (!CHECK(reader.open(path.c_str()))) {
+      continue;
+    }
+    classifier.addCapture(reader);
+    CHECK(reader.truncated());
+    CHECK(classifier.report().records == writer.expected.records - 1);
+    reader.close();
+  }
+  std::remove(path.c_str());
+}
+
+static void rejectsOtherFiles() {
+  const std::string path = tempPath("tcp_capture_junk.pcap");
+  FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs("\x0a\x0d\x0d\x0a pcapng section header, not classic pcap", file);
+  std::fclose(file);
+  PcapReader reader;
+  CHECK(!reader.open(path.c_str()) && errno == EINVAL);
+  CHECK(!reader.isOpen());
+  std::remove(path.c_str());
+
+  CHECK(!reader.open(tempPath("tcp_capture_missing.pcap").c_str()));
+}
+
+// ===== CLASSIFIER =====
+
+// TCPFlags' own checks, one packet at a time, must agree with the report
+static void agreesWithTCPFlags() {
+  const std::string path = tempPath("tcp_capture_flags.pcap");
+  FixtureWriter writer(path, Pcap::LINK_ETHERNET, false, false);
+  writeTraffic(writer, 50000, 7);
+  CHECK(writer.close());
+  PcapReader reader;
+  if (!CHECK(reader.open(path.c_str()))) {
+    return;
+  }
+  TCPFlagReport per_packet;
+  per_packet.records = reader.forEachRecord([&](const PcapReader::Record &record) {
+    const int flags = TCPFlagKernels::tcpFlags(record.data, reader.linkType());
+    if (flags < 0) {
+      return;
+    }
+    TCPFlags tcp;
+    tcp.setFlag(static_cast<uint8_t>(flags));
+    per_packet.tcp_segments++;
+    per_packet.histogram[tcp.flags]++;
+    per_packet.patterns[0] += tcp.isSet(TCPFlags::SYN) && !tcp.isSet(TCPFlags::ACK);
+    per_packet.patterns[1] += tcp.isSYNACK();
+    per_packet.patterns[2] += tcp.isFINACK();
+    per_packet.patterns[3] += tcp.isSet(TCPFlags::FIN) && !tcp.isSet(TCPFlags::ACK);
+    per_packet.patterns[4] += tcp.isSet(TCPFlags::RST);
+  });
+  TCPFlagClassifier classifier;
+  classifier.addCapture(reader);
+  CHECK(per_packet == writer.expected);
+  CHECK(classifier.report() == writer.expected);
+  reader.close();
+  std::remove(path.c_str());
+}
+
+// Columns longer than one CHUNK, and not a multiple of 32 or 64
+static void columns() {
+  Rng rng(3);
+  std::vector<uint8_t> flags(2 * TCPFlagClassifier::CHUNK + 45);
+  for (uint8_t &f : flags) {
+    f = static_cast<uint8_t>(rng.next());
+  }
+  TCPFlagReport expected; // addFlags() sees no records, only flags
+  expected.tcp_segments = flags.size();
+  for (uint8_t f : flags) {
+    expected.histogram[f]++;
+    for (size_t p = 0; p < TCP_FLAG_PATTERNS.size(); p++) {
+      expected.patterns[p] += TCP_FLAG_PATTERNS[p].matches(f);
+    }
+  }
+  TCPFlagClassifier classifier;
+  classifier.addFlags(flags);
+  CHECK(classifier.report() == expected);
+
+  std::vector<uint64_t> bits((flags.size() + 63) / 64);
+  std::vector<uint64_t> bits_scalar(bits.size());
+  for (size_t p = 0; p < TCP_FLAG_PATTERNS.size(); p++) {
+    const TCPFlagPattern &pattern = TCP_FLAG_PATTERNS[p];
+    CHECK(TCPFlagKernels::matchScalar(flags, pattern, bits_scalar) == expected.patterns[p]);
+    CHECK(TCPFlagKernels::match(flags, pattern, bits) == expected.patterns[p]);
+    CHECK(bits == bits_scalar);
+    size_t set = 0;
+    for (size_t i = 0; i < flags.size(); i++) {
+      set += ((bits[i / 64] >> (i % 64)) & 1) == pattern.matches(flags[i]);
+    }
+    CHECK(set == flags.size());
+  }
+
+  // histogram() adds to the bins it is given
+  std::array<uint64_t, 256> bins{};
+  TCPFlagKernels::histogram(flags, bins);
+  TCPFlagKernels::histogram(flags, bins);
+  CHECK(bins[flags[0]] == 2 * expected.histogram[flags[0]]);
+}
+
+// ===== HEADER WALK =====
+
+static void frames() {
+  // Ethernet, 802.1ad outer tag + 802.1Q inner tag, IPv4, TCP SYN
+  uint8_t frame[80] = {};
+  put16(frame + 12, 0x88A8);
+  put16(frame + 16, 0x8100);
+  put16(frame + 20, 0x0800);
+  frame[22] = 0x45;
+  frame[31] = 6;
+  frame[22 + 20 + 13] = TCPFlags::SYN;
+  CHECK(TCPFlagKernels::tcpFlags(frame, Pcap::LINK_ETHERNET) == TCPFlags::SYN);
+
+  // Cut short anywhere before the flags byte: no answer, no overread
+  CHECK(TCPFlagKernels::tcpFlags({frame, 22 + 20 + 13}, Pcap::LINK_ETHERNET) == -1);
+  CHECK(TCPFlagKernels::tcpFlags({frame, 10}, Pcap::LINK_ETHERNET) == -1);
+  CHECK(TCPFlagKernels::tcpFlags({frame, 0}, Pcap::LINK_RAW) == -1);
+
+  // IPv6 with a fragment header for the first fragment: TCP follows it
+  uint8_t v6[80] = {};
+  v6[0] = 0x60;
+  v6[6] = 44;
+  v6[40] = 6;
+  v6[48 + 13] = TCPFlags::RST | TCPFlags::ACK;
+  CHECK(TCPFlagKernels::tcpFlags(v6, Pcap::LINK_IPV6) == (TCPFlags::RST | TCPFlags::ACK));
+  v6[43] = 0x08; // offset 1: a later fragment carries no TCP header
+  CHECK(TCPFlagKernels::tcpFlags(v6, Pcap::LINK_IPV6) == -1);
+}
+
+void tcp_capture_tests() {
+  std::printf("tcp_capture (match kernel: %s)\n", TCPFlagKernels::kernelName());
+  frames();
+  columns();
+  PcapReader probe;
+  if (!probe.open(tempPath("tcp_capture_missing.pcap").c_str()) && errno == ENOSYS) {
+    std::printf("  no mmap on this platform: pcap file tests skipped\n");
+    return;
+  }
+  formats();
+  rejectsOtherFiles();
+  agreesWithTCPFlags();
+}
@@ -1,13 +1,19 @@
 #include "../include/main.hpp"
-#include <cassert>
+#include "tests.hpp"
 #include <iostream>
 
 int main() {
-    std::cout << "Running tests..." << std::endl;
-    
-    // Add your tests here
-    // Example: assert(some_function() == expected_value);
-    
-    std::cout << "✅ All tests passed!" << std::endl;
-    return 0;
+  std::cout << "Running tests..." << std::endl;
+
+  bit_array_tests();
+  roaring_bitmap_tests();
+  sensor_stream_tests();
+  tcp_capture_tests();
+
+  if (tests::failures) {
+    std::cout << "❌ " << tests::failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "✅ All tests passed!" << std::endl;
+  return 0;
 }
@@ -0,0 +1,32 @@
+/*
+Tests
+Shared by every test file. CHECK() reports a failed condition with
+its file and line and lets the run continue; test_main exits non-zero if
+any check failed. Unlike assert() it stays on in Release builds.
+*/
+
+#pragma once
+
+#include <cstdio>
+
+namespace tests {
+
+inline int failures = 0;
+
+inline bool check(bool ok, const char *what, const char *file, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, what);
+    failures++;
+  }
+  return ok;
+}
+
+} // namespace tests
+
+#define CHECK(condition) tests::check((condition), #condition, __FILE__, __LINE__)
+
+// One function per <module>_test.cpp, called from test_main.cpp
+void bit_array_tests();
+void roaring_bitmap_tests();
+void sensor_stream_tests();
+void tcp_capture_tests();